@@ -104,6 +104,11 @@ void SelectColdJunctionInput(void);
  */
 void ResetSelectedInput(void);
 
+/**
+ * @brief Determines the ADC input channels for the specified internal input.
+ */
+bool GetInternalInputChannels(InternalAnalogInput_t input, ADS1256_AIN_t* pos, ADS1256_AIN_t* neg);
+
 /**
  * @brief Determines the external input for the specified input index.
  */
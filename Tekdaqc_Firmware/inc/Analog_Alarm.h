@@ -0,0 +1,122 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Alarm.h
+ * @brief Header file for the analog input range alarms.
+ *
+ * Contains public definitions and data types for checking every corrected sample of an analog input against the
+ * allowable range held in its Analog_Input_t. The status of the input is kept up to date, and an event is written to
+ * the data connection each time it changes. A digital output can be turned on while the input is out of range.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_ALARM_H_
+#define ANALOG_ALARM_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "Analog_Input.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_alarm Analog Alarm
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def ANALOG_ALARM_NO_OUTPUT
+ * @brief The output number used when an alarm does not drive a digital output.
+ */
+#define ANALOG_ALARM_NO_OUTPUT		0xFFU
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Alarm configuration of an input.
+ */
+typedef struct {
+	bool enabled; /**< If samples are checked against the range. */
+	int32_t min; /**< The low value of the allowable range, in ADC counts. */
+	int32_t max; /**< The high value of the allowable range, in ADC counts. */
+	int32_t hysteresis; /**< How far back inside the range a sample must be to return to IN_RANGE, in ADC counts. */
+	uint8_t output; /**< The digital output turned on while out of range, or ANALOG_ALARM_NO_OUTPUT. */
+} AnalogAlarm_Config_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Turns off the alarms of every input.
+ */
+void AnalogAlarm_Init(void);
+
+/**
+ * @brief Sets the alarm configuration of an input.
+ */
+bool AnalogAlarm_Configure(Analog_Input_t* input, const AnalogAlarm_Config_t* config);
+
+/**
+ * @brief Retrieves the alarm configuration of an input.
+ */
+void AnalogAlarm_GetConfig(uint8_t channel, AnalogAlarm_Config_t* config);
+
+/**
+ * @brief Turns off the alarm of an input.
+ */
+void AnalogAlarm_Disable(uint8_t channel);
+
+/**
+ * @brief Checks a block of corrected samples of one input against its range.
+ */
+void AnalogAlarm_Check(Analog_Input_t* input, const Analog_Samples_t* samples, const int32_t* values, uint32_t count);
+
+/**
+ * @brief Converts an input range status into a human readable string.
+ */
+const char* AnalogAlarm_StatusToString(AnalogInputStatus_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_ALARM_H_ */
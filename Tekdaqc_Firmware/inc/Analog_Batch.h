@@ -0,0 +1,142 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Batch.h
+ * @brief Header file for the analog sample batching stage.
+ *
+ * Contains public definitions for grouping consecutive binary analog samples of a channel into block frames before
+ * they are written to the data connection.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_BATCH_H_
+#define ANALOG_BATCH_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "Tekdaqc_DataFrame.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_batch Analog Batch
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def ANALOG_BATCH_SLOTS
+ * @brief The number of channels which can have a block pending at once. When a further channel needs a block, the
+ * oldest pending block is written out early.
+ */
+#define ANALOG_BATCH_SLOTS				8U
+
+/**
+ * @def ANALOG_BATCH_DEFAULT_SIZE
+ * @brief The default number of samples per block.
+ */
+#define ANALOG_BATCH_DEFAULT_SIZE		16U
+
+/**
+ * @def ANALOG_BATCH_DEFAULT_LATENCY
+ * @brief The default longest time a sample may wait in a block before it is written, in milliseconds.
+ */
+#define ANALOG_BATCH_DEFAULT_LATENCY	50U
+
+/**
+ * @def ANALOG_BATCH_MAX_LATENCY
+ * @brief The largest latency bound which may be configured, in milliseconds.
+ */
+#define ANALOG_BATCH_MAX_LATENCY		10000U
+
+/**
+ * @def IS_ANALOG_BATCH_SIZE(SIZE)
+ * @brief Checks that the specified batch size is valid. A size of 1 disables batching.
+ */
+#define IS_ANALOG_BATCH_SIZE(SIZE)		(((SIZE) >= 1U) && ((SIZE) <= DATA_FRAME_MAX_BLOCK_SAMPLES))
+
+/**
+ * @def IS_ANALOG_BATCH_LATENCY(LATENCY)
+ * @brief Checks that the specified latency bound is valid.
+ */
+#define IS_ANALOG_BATCH_LATENCY(LATENCY)	(((LATENCY) >= 1U) && ((LATENCY) <= ANALOG_BATCH_MAX_LATENCY))
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Discards any pending blocks and restores the default batch size and latency bound.
+ */
+void AnalogBatch_Init(void);
+
+/**
+ * @brief Sets the number of samples per block and the latency bound.
+ */
+bool AnalogBatch_Configure(uint8_t size, uint32_t latency);
+
+/**
+ * @brief Retrieves the number of samples per block.
+ */
+uint8_t AnalogBatch_GetSize(void);
+
+/**
+ * @brief Retrieves the latency bound in milliseconds.
+ */
+uint32_t AnalogBatch_GetLatency(void);
+
+/**
+ * @brief Adds a sample to the pending block of its channel.
+ */
+void AnalogBatch_Add(uint8_t channel, uint64_t timestamp, int32_t value);
+
+/**
+ * @brief Writes out every pending block which has reached the latency bound.
+ */
+void AnalogBatch_Service(uint64_t now);
+
+/**
+ * @brief Writes out every pending block.
+ */
+void AnalogBatch_Flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_BATCH_H_ */
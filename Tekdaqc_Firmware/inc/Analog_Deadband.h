@@ -0,0 +1,128 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Deadband.h
+ * @brief Header file for the analog input deadband filter.
+ *
+ * Contains public definitions and data types for reporting analog inputs by exception. An input with a deadband only
+ * has a sample written to the data connection when it moves outside a band around the last sample written, or when
+ * no sample has been written for a heartbeat interval.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_DEADBAND_H_
+#define ANALOG_DEADBAND_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_deadband Analog Deadband
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief How the band around the last reported sample is measured.
+ */
+typedef enum {
+	DEADBAND_MODE_NONE, /**< Every sample is reported. */
+	DEADBAND_MODE_ABSOLUTE, /**< The band is a number of ADC counts. */
+	DEADBAND_MODE_PERCENT /**< The band is a percentage of the last reported sample. */
+} AnalogDeadband_Mode_t;
+
+/**
+ * @brief Deadband configuration of an input.
+ */
+typedef struct {
+	AnalogDeadband_Mode_t mode; /**< How the band is measured. */
+	float band; /**< The half width of the band, in ADC counts or percent depending on the mode. */
+	uint32_t heartbeat; /**< The longest time between reported samples in microseconds, 0 for no heartbeat. */
+} AnalogDeadband_Config_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Turns off the deadband of every input.
+ */
+void AnalogDeadband_Init(void);
+
+/**
+ * @brief Sets the deadband configuration of an input.
+ */
+bool AnalogDeadband_Configure(uint8_t channel, const AnalogDeadband_Config_t* config);
+
+/**
+ * @brief Retrieves the deadband configuration of an input.
+ */
+void AnalogDeadband_GetConfig(uint8_t channel, AnalogDeadband_Config_t* config);
+
+/**
+ * @brief Turns off the deadband of an input.
+ */
+void AnalogDeadband_Disable(uint8_t channel);
+
+/**
+ * @brief Forgets the last reported samples, so the next sample of every input is reported.
+ */
+void AnalogDeadband_Restart(void);
+
+/**
+ * @brief Decides if a sample should be reported.
+ */
+bool AnalogDeadband_Filter(uint8_t channel, uint64_t timestamp, int32_t value);
+
+/**
+ * @brief Retrieves the number of samples of an input which were not reported.
+ */
+uint32_t AnalogDeadband_GetSuppressed(uint8_t channel);
+
+/**
+ * @brief Converts a deadband mode into a human readable string.
+ */
+const char* AnalogDeadband_ModeToString(AnalogDeadband_Mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_DEADBAND_H_ */
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_History.h
+ * @brief Header file for the analog input history arena.
+ *
+ * Contains public definitions and data types for the history of recent samples kept for each added analog input. The
+ * history of every input is carved out of a single shared arena when the input is added, so inputs which are not
+ * added cost nothing and the depth can be chosen per input.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_HISTORY_H_
+#define ANALOG_HISTORY_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+#include "Tekdaqc_BSP.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_history Analog History
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def ANALOG_HISTORY_DEFAULT_DEPTH
+ * @brief The number of samples kept for an input when no depth is given.
+ */
+#define ANALOG_HISTORY_DEFAULT_DEPTH	50U
+
+/**
+ * @def ANALOG_HISTORY_ARENA_SIZE
+ * @brief The number of samples shared between the histories of all added inputs. Every input, the cold junction
+ * included, can be added at the default depth; deeper histories take from what shallower ones leave.
+ */
+#define ANALOG_HISTORY_ARENA_SIZE		(NUM_ANALOG_INPUTS * ANALOG_HISTORY_DEFAULT_DEPTH)
+
+/**
+ * @def IS_ANALOG_HISTORY_DEPTH(DEPTH)
+ * @brief Checks that a history depth is one which could be allocated from an empty arena.
+ */
+#define IS_ANALOG_HISTORY_DEPTH(DEPTH)	(((DEPTH) > 0) && ((DEPTH) <= ANALOG_HISTORY_ARENA_SIZE))
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Iterator over the recent samples of an input, newest first.
+ */
+typedef struct {
+	uint8_t channel; /**< The physical input being iterated. */
+	uint16_t index; /**< The position in the input's history of the last sample returned. */
+	uint16_t remaining; /**< The number of samples left to return. */
+} AnalogHistory_Iterator_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Releases the history of every input.
+ */
+void AnalogHistory_Init(void);
+
+/**
+ * @brief Allocates the history of an input from the arena.
+ */
+bool AnalogHistory_Allocate(uint8_t channel, uint16_t depth);
+
+/**
+ * @brief Returns the history of an input to the arena.
+ */
+void AnalogHistory_Free(uint8_t channel);
+
+/**
+ * @brief Records a sample in the history of an input.
+ */
+bool AnalogHistory_Write(uint8_t channel, uint64_t timestamp, int32_t value);
+
+/**
+ * @brief Reads the oldest sample of an input which has not yet been read.
+ */
+bool AnalogHistory_Read(uint8_t channel, uint64_t* timestamp, int32_t* value);
+
+/**
+ * @brief Marks every sample in the history of an input as read.
+ */
+void AnalogHistory_Discard(uint8_t channel);
+
+/**
+ * @brief Retrieves the number of samples of an input which have not yet been read.
+ */
+uint16_t AnalogHistory_GetUnread(uint8_t channel);
+
+/**
+ * @brief Retrieves the number of samples the history of an input holds.
+ */
+uint16_t AnalogHistory_GetDepth(uint8_t channel);
+
+/**
+ * @brief Retrieves the number of samples of the arena not allocated to any input.
+ */
+uint16_t AnalogHistory_GetFree(void);
+
+/**
+ * @brief Starts iterating over the most recent samples of an input.
+ */
+void AnalogHistory_Begin(AnalogHistory_Iterator_t* iterator, uint8_t channel, uint16_t count);
+
+/**
+ * @brief Retrieves the next most recent sample from an iterator.
+ */
+bool AnalogHistory_Next(AnalogHistory_Iterator_t* iterator, uint64_t* timestamp, int32_t* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_HISTORY_H_ */
@@ -39,6 +39,7 @@ extern "C" {
 #include "stm32f4xx.h"
 #include "Tekdaqc_Config.h"
 #include "ADS1256_Driver.h"
+#include "Tekdaqc_RingBuffer.h"
 #include "boolean.h"
 
 /** @addtogroup tekdaqc_firmware Tekdaqc Firmware
@@ -59,15 +60,10 @@ extern "C" {
  */
 #define MAX_ANALOG_INPUT_NAME_LENGTH 24
 
-/**
- * @def ANALOG_INPUT_BUFFER_SIZE
- * @brief The number or readings to store in the circular buffer for the input.
- */
-#define ANALOG_INPUT_BUFFER_SIZE	50U /* 50 samples. Other code expects it to <= 255. */
-
 
 //lfao-defines the size of the buffer where samples taken from the DRDY interrupt handler are written
-#define ANALOG_SAMPLES_BUFFER_SIZE 100
+//must be a power of two...
+#define ANALOG_SAMPLES_BUFFER_SIZE 512U
 /*--------------------------------------------------------------------------------------------------------*/
 /* EXPORTED TYPES */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -95,16 +91,14 @@ typedef struct {
 	ExternalMuxedInput_t externalInput; /**< If an external input, which channel. */
 	InternalAnalogInput_t internalInput; /**< If an internal input, which channel. */
 	char name[MAX_ANALOG_INPUT_NAME_LENGTH]; /**< Pointer to a C string name for this input. */
-	uint8_t bufferReadIdx; /**< The index of the buffer to read data from. */
-	uint8_t bufferWriteIdx; /**< The index of the buffer to write data to. */
+	uint16_t historyDepth; /**< The number of recent samples kept in the history arena for this input. */
+	uint32_t period; /**< The target time between samples in a multi-rate scan in microseconds, 0 for every pass. */
 	AnalogInputStatus_t status; /**< The current status of this input. */
 	ADS1256_BUFFER_t buffer; /**< Analog buffer state to use. */
 	ADS1256_PGA_t gain; /**< Gain setting to use for analog measurements. */
 	ADS1256_SPS_t rate; /**< Sample rate to use for measurements. */
 	int32_t min; /**< The low value of the allowable range of this input. */
 	int32_t max; /**< The high value of the allowable range of this input. */
-	int32_t values[ANALOG_INPUT_BUFFER_SIZE]; /**< The recorded values of this input (ADC Counts). */
-	uint64_t timestamps[ANALOG_INPUT_BUFFER_SIZE]; /**< The timestamps of the measurements in UNIX epoch format. */
 } Analog_Input_t;
 
 
@@ -129,8 +123,28 @@ void AnalogInputsInit(void);
 void InitAnalogSamplesBuffer(void);
 int WriteSampleToBuffer(Analog_Samples_t *Data);
 int ReadSampleFromBuffer(Analog_Samples_t *Data);
+
+/**
+ * @brief Retrieves the counters of the analog sample buffer.
+ */
+void GetAnalogSamplesBufferStats(RingBuffer_Statistics_t* stats);
+
+/**
+ * @brief Stores a conversion result for the channel currently being sampled.
+ */
+void AnalogSampleReady(uint32_t reading);
+
+/**
+ * @brief Writes a block of corrected samples to the data connection.
+ */
+void WriteAnalogSamples(const Analog_Samples_t* samples, const int32_t* corrected, uint32_t count);
 void WriteToTelnet_Analog(void);
 void AnalogChannelHandler(void);
+
+/**
+ * @brief Starts sampling the compiled scan list.
+ */
+void AnalogScanStart(void);
 void AnalogHalt(void);
 /*--------------------------------------------------------------------------------------------------------*/
 /* INPUT ADD/REMOVE METHODS */
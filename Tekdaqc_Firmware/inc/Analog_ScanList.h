@@ -0,0 +1,189 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_ScanList.h
+ * @brief Header file for the compiled analog scan list.
+ *
+ * Contains public definitions and data types for the table of analog inputs walked by the channel switch handler
+ * during multi-channel acquisition. The table is ordered by a planner which hides the external multiplexer relay
+ * settling behind conversions of the internal inputs.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_SCANLIST_H_
+#define ANALOG_SCANLIST_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "Analog_Input.h"
+#include "ADS1256_Driver.h"
+#include "Tekdaqc_Error.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_scan_list Analog Scan List
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def ANALOG_SCAN_MUX_SETTLE_TIME
+ * @brief The time to wait after switching the external multiplexer before a conversion is started, in microseconds.
+ */
+#define ANALOG_SCAN_MUX_SETTLE_TIME		((uint32_t) EXTERNAL_MUX_DELAY)
+
+/**
+ * @def ANALOG_SCAN_HOP_OVERHEAD
+ * @brief The time budgeted for the SPI traffic and handler work of each hop of a multi-rate scan, in microseconds.
+ */
+#define ANALOG_SCAN_HOP_OVERHEAD		50U
+
+/**
+ * @def ANALOG_SCAN_MAX_FRAMES
+ * @brief The number of frames the load of a multi-rate scan is balanced over. Must be a power of two. Inputs slower
+ * than this many frames keep a slot in the frame they are placed in, which is only used once every few passes.
+ */
+#define ANALOG_SCAN_MAX_FRAMES			64U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief A single hop of the scan list.
+ * Everything needed to switch to and start sampling an input, worked out when the scan list is compiled so that the
+ * channel switch handler does no lookups.
+ */
+typedef struct AnalogScan_Entry {
+	Analog_Input_t* input; /**< The input this entry samples. */
+	uint8_t physicalInput; /**< The physical input reported with the samples. */
+	bool external; /**< TRUE if the input is reached through the external multiplexer. */
+	uint16_t muxWord; /**< The external multiplexer GPIO bits, if external. */
+	uint32_t settleTime; /**< The time to wait between selecting the input and sampling it, in microseconds. */
+	uint32_t convertTime; /**< The time taken by the first settled conversion, in microseconds. */
+	const struct AnalogScan_Entry* relay; /**< The external entry the relays are switched to while this one samples. */
+	uint32_t frameMask; /**< The entry is sampled in the frames whose number masked with this equals framePhase. */
+	uint32_t framePhase; /**< The first frame the entry is sampled in. */
+	uint8_t registers[ADS1256_REGISTER_IMAGE_SIZE]; /**< The ADC register image, including calibration. */
+} AnalogScan_Entry_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Empties the scan list.
+ */
+void AnalogScan_Clear(void);
+
+/**
+ * @brief Compiles the added inputs of a list into the scan list.
+ */
+Tekdaqc_Function_Error_t AnalogScan_Compile(Analog_Input_t* inputs[], uint8_t count);
+
+/**
+ * @brief Retrieves the number of entries in the scan list.
+ */
+uint8_t AnalogScan_GetCount(void);
+
+/**
+ * @brief Retrieves an entry of the scan list.
+ */
+const AnalogScan_Entry_t* AnalogScan_GetEntry(uint8_t index);
+
+/**
+ * @brief Retrieves the entry used for interleaved cold junction reads.
+ */
+const AnalogScan_Entry_t* AnalogScan_GetColdJunction(void);
+
+/**
+ * @brief Retrieves the number of external multiplexer changes made by each pass of the scan list.
+ */
+uint8_t AnalogScan_GetRelayHops(void);
+
+/**
+ * @brief Retrieves the predicted time taken by each pass of the scan list.
+ */
+uint32_t AnalogScan_GetPredictedPeriod(void);
+
+/**
+ * @brief Retrieves the length of a frame of a multi-rate scan.
+ */
+uint32_t AnalogScan_GetFramePeriod(void);
+
+/**
+ * @brief Retrieves the number of frames started since the scan was rewound.
+ */
+uint32_t AnalogScan_GetFrame(void);
+
+/**
+ * @brief Starts the schedule over from its first frame.
+ */
+uint8_t AnalogScan_Rewind(uint64_t now);
+
+/**
+ * @brief Moves on to the next entry of the schedule.
+ */
+uint8_t AnalogScan_Advance(uint8_t index);
+
+/**
+ * @brief Retrieves the entry of the schedule after an entry, without moving on.
+ */
+uint8_t AnalogScan_Peek(uint8_t index);
+
+/**
+ * @brief Retrieves the time left before the current entry's frame may start.
+ */
+uint32_t AnalogScan_Pace(uint64_t now);
+
+/**
+ * @brief Switches the multiplexers to the input of an entry.
+ */
+uint32_t AnalogScan_Select(const AnalogScan_Entry_t* entry, const AnalogScan_Entry_t* next);
+
+/**
+ * @brief Configures the ADC for an entry and starts a conversion.
+ */
+void AnalogScan_Start(const AnalogScan_Entry_t* entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_SCANLIST_H_ */
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Statistics.h
+ * @brief Header file for the analog input statistics engine.
+ *
+ * Contains public definitions and data types for computing the mean, minimum, maximum, RMS and standard deviation of
+ * each analog input over a window of samples. A window is defined by a number of samples or a length of time, and
+ * either tumbles (consecutive windows do not overlap) or slides (a window ending at the latest sample is reported
+ * every step). An input can report only these aggregates instead of every sample.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_STATISTICS_H_
+#define ANALOG_STATISTICS_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_statistics Analog Statistics
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Statistics window types.
+ */
+typedef enum {
+	STATISTICS_WINDOW_NONE, /**< No statistics are computed. */
+	STATISTICS_WINDOW_TUMBLING, /**< Consecutive windows which do not overlap, each reported when it is complete. */
+	STATISTICS_WINDOW_SLIDING /**< A window ending at the latest sample, reported every step. */
+} AnalogStatistics_Window_t;
+
+/**
+ * @brief What the size and step of a window are measured in.
+ */
+typedef enum {
+	STATISTICS_BASIS_COUNT, /**< A number of samples. */
+	STATISTICS_BASIS_TIME /**< A length of time in microseconds. */
+} AnalogStatistics_Basis_t;
+
+/**
+ * @brief What is written to the data connection for an input with statistics.
+ */
+typedef enum {
+	STATISTICS_REPORT_ALL, /**< Every sample as well as the statistics. */
+	STATISTICS_REPORT_AGGREGATE /**< Only the statistics. */
+} AnalogStatistics_Report_t;
+
+/**
+ * @brief Statistics configuration of an input.
+ */
+typedef struct {
+	AnalogStatistics_Window_t window; /**< The window type. */
+	AnalogStatistics_Basis_t basis; /**< What the size and step are measured in. */
+	uint32_t size; /**< The length of the window. */
+	uint32_t step; /**< The distance between reports of a sliding window. */
+	AnalogStatistics_Report_t report; /**< What is written to the data connection. */
+} AnalogStatistics_Config_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Turns off the statistics of every input.
+ */
+void AnalogStatistics_Init(void);
+
+/**
+ * @brief Sets the statistics configuration of an input.
+ */
+bool AnalogStatistics_Configure(uint8_t channel, const AnalogStatistics_Config_t* config);
+
+/**
+ * @brief Retrieves the statistics configuration of an input.
+ */
+void AnalogStatistics_GetConfig(uint8_t channel, AnalogStatistics_Config_t* config);
+
+/**
+ * @brief Turns off the statistics of an input.
+ */
+void AnalogStatistics_Disable(uint8_t channel);
+
+/**
+ * @brief Discards any partially filled windows.
+ */
+void AnalogStatistics_Restart(void);
+
+/**
+ * @brief Adds a sample to the statistics of its input, reporting any window it completes.
+ */
+bool AnalogStatistics_Record(uint8_t channel, uint64_t timestamp, int32_t value);
+
+/**
+ * @brief Converts a window type into a human readable string.
+ */
+const char* AnalogStatistics_WindowToString(AnalogStatistics_Window_t window);
+
+/**
+ * @brief Converts a window basis into a human readable string.
+ */
+const char* AnalogStatistics_BasisToString(AnalogStatistics_Basis_t basis);
+
+/**
+ * @brief Converts a report mode into a human readable string.
+ */
+const char* AnalogStatistics_ReportToString(AnalogStatistics_Report_t report);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_STATISTICS_H_ */
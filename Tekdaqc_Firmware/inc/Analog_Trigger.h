@@ -0,0 +1,200 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Trigger.h
+ * @brief Header file for the analog trigger engine.
+ *
+ * Contains public definitions and data types for triggered acquisition. While armed, analog samples are recorded into
+ * a circular capture buffer instead of being streamed. When the trigger fires, a window of samples around it is frozen
+ * and only that window is written to the data connection.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ANALOG_TRIGGER_H_
+#define ANALOG_TRIGGER_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "Analog_Input.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup analog_trigger Analog Trigger
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def ANALOG_TRIGGER_BUFFER_SIZE
+ * @brief The number of samples the capture buffer holds. A window of pre-trigger samples, the trigger sample and
+ * post-trigger samples must fit within it.
+ */
+#define ANALOG_TRIGGER_BUFFER_SIZE			512U
+
+/**
+ * @def ANALOG_TRIGGER_DEFAULT_PRE
+ * @brief The default number of samples kept from before the trigger.
+ */
+#define ANALOG_TRIGGER_DEFAULT_PRE			64U
+
+/**
+ * @def ANALOG_TRIGGER_DEFAULT_POST
+ * @brief The default number of samples captured after the trigger.
+ */
+#define ANALOG_TRIGGER_DEFAULT_POST			192U
+
+/**
+ * @def IS_ANALOG_TRIGGER_WINDOW(PRE, POST)
+ * @brief Checks that a window of pre-trigger and post-trigger samples fits in the capture buffer.
+ */
+#define IS_ANALOG_TRIGGER_WINDOW(PRE, POST)	(((uint64_t) (PRE) + (POST)) < ANALOG_TRIGGER_BUFFER_SIZE)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Trigger sources.
+ */
+typedef enum {
+	TRIGGER_SOURCE_SOFTWARE, /**< Fired by the TRIGGER command. */
+	TRIGGER_SOURCE_DIGITAL, /**< Fired by an edge on a digital input. */
+	TRIGGER_SOURCE_ANALOG /**< Fired by an analog input crossing a level. */
+} AnalogTrigger_Source_t;
+
+/**
+ * @brief Trigger edges. Digital edges are of the level as reported to the client.
+ */
+typedef enum {
+	TRIGGER_EDGE_RISING, /**< Fire on a low to high transition. */
+	TRIGGER_EDGE_FALLING, /**< Fire on a high to low transition. */
+	TRIGGER_EDGE_EITHER /**< Fire on either transition. */
+} AnalogTrigger_Edge_t;
+
+/**
+ * @brief Trigger engine states.
+ */
+typedef enum {
+	TRIGGER_IDLE, /**< Samples are streamed as normal. */
+	TRIGGER_ARMED, /**< Samples are recorded while waiting for the trigger. */
+	TRIGGER_TRIGGERED, /**< The trigger has fired and post-trigger samples are being recorded. */
+	TRIGGER_FROZEN /**< The window is complete and is being written out. */
+} AnalogTrigger_State_t;
+
+/**
+ * @brief Trigger configuration.
+ */
+typedef struct {
+	AnalogTrigger_Source_t source; /**< What fires the trigger. */
+	AnalogTrigger_Edge_t edge; /**< The transition which fires a digital or analog trigger. */
+	uint8_t input; /**< The digital or analog input watched by the trigger. */
+	int32_t level; /**< The corrected value an analog trigger fires at, in the units samples are streamed in. */
+	uint32_t preSamples; /**< The number of samples kept from before the trigger. */
+	uint32_t postSamples; /**< The number of samples captured after the trigger. */
+} AnalogTrigger_Config_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Disarms the trigger and restores the default configuration.
+ */
+void AnalogTrigger_Init(void);
+
+/**
+ * @brief Sets the trigger configuration.
+ */
+bool AnalogTrigger_Configure(const AnalogTrigger_Config_t* config);
+
+/**
+ * @brief Retrieves the trigger configuration.
+ */
+void AnalogTrigger_GetConfig(AnalogTrigger_Config_t* config);
+
+/**
+ * @brief Starts recording and waiting for the trigger.
+ */
+bool AnalogTrigger_Arm(void);
+
+/**
+ * @brief Abandons any capture in progress.
+ */
+void AnalogTrigger_Disarm(void);
+
+/**
+ * @brief Fires a software trigger.
+ */
+bool AnalogTrigger_Fire(uint64_t time);
+
+/**
+ * @brief Retrieves the state of the trigger engine.
+ */
+AnalogTrigger_State_t AnalogTrigger_GetState(void);
+
+/**
+ * @brief Checks if samples should be handed to the trigger engine rather than streamed.
+ */
+bool AnalogTrigger_IsCapturing(void);
+
+/**
+ * @brief Records a block of samples into the capture buffer.
+ */
+void AnalogTrigger_Record(const Analog_Samples_t* samples, const int32_t* corrected, uint32_t count);
+
+/**
+ * @brief Watches digital trigger inputs and writes out a frozen window.
+ */
+void AnalogTrigger_Service(void);
+
+/**
+ * @brief Converts a trigger source into a human readable string.
+ */
+const char* AnalogTrigger_SourceToString(AnalogTrigger_Source_t source);
+
+/**
+ * @brief Converts a trigger edge into a human readable string.
+ */
+const char* AnalogTrigger_EdgeToString(AnalogTrigger_Edge_t edge);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ANALOG_TRIGGER_H_ */
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file ColdJunction_Policy.h
+ * @brief Header file for the cold junction sampling policy.
+ *
+ * Contains public definitions for deciding when a cold junction read is interleaved with a multi-channel scan. The
+ * interval between reads adapts to how fast the board temperature is changing.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef COLDJUNCTION_POLICY_H_
+#define COLDJUNCTION_POLICY_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup cold_junction_policy Cold Junction Policy
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def COLD_JUNCTION_MIN_INTERVAL
+ * @brief The shortest time between cold junction reads, used while the board is warming up, in microseconds.
+ */
+#define COLD_JUNCTION_MIN_INTERVAL		100000U
+
+/**
+ * @def COLD_JUNCTION_MAX_INTERVAL
+ * @brief The longest time between cold junction reads, used once the board temperature is stable, in microseconds.
+ */
+#define COLD_JUNCTION_MAX_INTERVAL		10000000U
+
+/**
+ * @def COLD_JUNCTION_TARGET_STEP
+ * @brief The change in board temperature allowed between cold junction reads, in degrees C.
+ */
+#define COLD_JUNCTION_TARGET_STEP		0.05f
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Restarts the policy at the shortest interval.
+ */
+void ColdJunction_PolicyReset(uint64_t now);
+
+/**
+ * @brief Checks if a cold junction read is due.
+ */
+bool ColdJunction_PolicyIsDue(uint64_t now);
+
+/**
+ * @brief Records that a cold junction read has been scheduled.
+ */
+void ColdJunction_PolicyScheduled(uint64_t now);
+
+/**
+ * @brief Adapts the interval to a new board temperature reading.
+ */
+void ColdJunction_PolicyObserve(uint64_t time, float temperature);
+
+/**
+ * @brief Retrieves the current time between cold junction reads.
+ */
+uint32_t ColdJunction_PolicyGetInterval(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* COLDJUNCTION_POLICY_H_ */
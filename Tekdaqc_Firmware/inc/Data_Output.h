@@ -0,0 +1,92 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Data_Output.h
+ * @brief Header file for the sampled data output routing.
+ *
+ * Contains the functions the producers of sampled data write through. Sampled data goes as binary frames to the UDP
+ * stream while it is enabled, otherwise to the data server while it has a client and otherwise to the telnet
+ * connection, in the format selected there. ASCII records are therefore only ever written to the telnet connection.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DATA_OUTPUT_H_
+#define DATA_OUTPUT_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+#include "TelnetServer.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup data_output Data Output
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Indicates if there is a connection to write sampled data to.
+ */
+bool DataOutput_IsConnected(void);
+
+/**
+ * @brief Retrieves the format sampled data is written in.
+ */
+TelnetDataFormat_t DataOutput_GetFormat(void);
+
+/**
+ * @brief Writes a binary frame to the data connection.
+ */
+void DataOutput_WriteBuffer(const uint8_t* data, uint32_t length);
+
+/**
+ * @brief Retrieves the number of bytes which can be written to the data connection without waiting.
+ */
+uint32_t DataOutput_GetWriteSpace(void);
+
+/**
+ * @brief Waits for room to write the specified number of bytes to the data connection.
+ */
+bool DataOutput_WaitWriteSpace(uint32_t length, uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* DATA_OUTPUT_H_ */
@@ -37,6 +37,7 @@ extern "C" {
 #include "Tekdaqc_Debug.h"
 #include "Tekdaqc_Config.h"
 #include "Tekdaqc_Error.h"
+#include "Tekdaqc_RingBuffer.h"
 #include <boolean.h>
 
 /** @addtogroup tekdaqc_firmware Tekdaqc Firmware
@@ -57,7 +58,11 @@ extern "C" {
  */
 #define MAX_DIGITAL_INPUT_NAME_LENGTH 24
 
-#define DIGITAL_SAMPLES_BUFFER_SIZE 100
+/**
+ * @def DIGITAL_SAMPLES_BUFFER_SIZE
+ * @brief The number of samples the digital sample buffer can hold. Must be a power of two.
+ */
+#define DIGITAL_SAMPLES_BUFFER_SIZE 256U
 
 /*--------------------------------------------------------------------------------------------------------*/
 /* EXPORTED TYPES */
@@ -96,6 +101,12 @@ void DigitalInputsInit(void);
 void WriteToTelnet_Digital(void);
 void ReadDigitalInputs(void);
 void DigitalInputHalt(void);
+void InitDigitalSamplesBuffer(void);
+
+/**
+ * @brief Retrieves the counters of the digital sample buffer.
+ */
+void GetDigitalSamplesBufferStats(RingBuffer_Statistics_t* stats);
 
 /**
  * @brief Retrieves the requested digital input.
@@ -136,6 +136,11 @@ Tekdaqc_Function_Error_t CreateDigitalOutput(char keys[][MAX_COMMANDPART_LENGTH]
  */
 Tekdaqc_Function_Error_t SetDigitalOutput(char keys[][MAX_COMMANDPART_LENGTH], char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
 
+/**
+ * @brief Turns a single digital output on or off.
+ */
+void SetDigitalOutputChannel(uint8_t output, DigitalLevel_t level);
+
 /**
  * @brief Reads the digital output.
  */
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Output_Backpressure.h
+ * @brief Header file for the sampled data output backpressure policies.
+ *
+ * Contains public definitions and data types for deciding what happens to sampled data when the data connection
+ * cannot keep up with it. The producers of analog and digital records consult the selected policy before writing,
+ * so a slow client costs data, in a way the user chose and can see, rather than stalling the main loop.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OUTPUT_BACKPRESSURE_H_
+#define OUTPUT_BACKPRESSURE_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware Tekdaqc Firmware
+ * @{
+ */
+
+/** @addtogroup output_backpressure Output Backpressure
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def OUTPUT_BACKPRESSURE_RECORD_SIZE
+ * @brief The room set aside for a single sample record, in bytes. Covers the longest ASCII record.
+ */
+#define OUTPUT_BACKPRESSURE_RECORD_SIZE		64U
+
+/**
+ * @def OUTPUT_BACKPRESSURE_DEFAULT_TIMEOUT
+ * @brief The time a record waits for room under the BLOCK policy unless configured otherwise, in microseconds.
+ */
+#define OUTPUT_BACKPRESSURE_DEFAULT_TIMEOUT	10000U
+
+/**
+ * @def OUTPUT_BACKPRESSURE_PAUSE_POLL
+ * @brief How often paused acquisition checks if it may continue, in microseconds.
+ */
+#define OUTPUT_BACKPRESSURE_PAUSE_POLL		1000U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief What is done with sampled data the data connection has no room for.
+ */
+typedef enum {
+	BACKPRESSURE_BLOCK, /**< Wait up to a timeout for room, then shed records until the connection catches up. */
+	BACKPRESSURE_DROP_OLDEST, /**< Leave samples buffered, discarding the oldest ones when the buffers fill. */
+	BACKPRESSURE_DECIMATE, /**< While the connection is congested, write only every Nth record. */
+	BACKPRESSURE_PAUSE /**< While the connection is congested, hold acquisition between scan hops or conversions. */
+} OutputBackpressure_Policy_t;
+
+/**
+ * @brief Backpressure configuration.
+ */
+typedef struct {
+	OutputBackpressure_Policy_t policy; /**< The policy. */
+	uint32_t timeout; /**< The longest wait for room under BACKPRESSURE_BLOCK, in microseconds. */
+	uint32_t decimation; /**< The N of BACKPRESSURE_DECIMATE, at least 1. */
+} OutputBackpressure_Config_t;
+
+/**
+ * @brief Backpressure counters, kept since the policy was last configured.
+ */
+typedef struct {
+	uint32_t timeouts; /**< Records shed under BACKPRESSURE_BLOCK. */
+	uint32_t droppedOldest; /**< Buffered samples discarded under BACKPRESSURE_DROP_OLDEST. */
+	uint32_t decimated; /**< Records skipped under BACKPRESSURE_DECIMATE. */
+	uint32_t pauses; /**< Times acquisition was held under BACKPRESSURE_PAUSE. */
+	uint64_t pausedTime; /**< The total time acquisition was held, in microseconds. */
+	uint32_t overflows; /**< Records shed under any policy because there was no room at all. */
+	uint32_t overruns; /**< Samples lost because a producer's buffer was full. */
+	uint32_t notices; /**< Shed notices written to the data connection. */
+} OutputBackpressure_Counters_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Selects the default policy and clears the counters.
+ */
+void OutputBackpressure_Init(void);
+
+/**
+ * @brief Sets the backpressure configuration.
+ */
+bool OutputBackpressure_Configure(const OutputBackpressure_Config_t* config);
+
+/**
+ * @brief Retrieves the backpressure configuration.
+ */
+void OutputBackpressure_GetConfig(OutputBackpressure_Config_t* config);
+
+/**
+ * @brief Retrieves the backpressure counters.
+ */
+void OutputBackpressure_GetCounters(OutputBackpressure_Counters_t* counters);
+
+/**
+ * @brief Decides if a producer should leave its samples buffered for now.
+ */
+bool OutputBackpressure_Hold(uint32_t length);
+
+/**
+ * @brief Retrieves the number of oldest buffered samples a held producer should discard.
+ */
+uint32_t OutputBackpressure_Excess(uint32_t held, uint32_t capacity);
+
+/**
+ * @brief Decides if a record should be written.
+ */
+bool OutputBackpressure_Admit(uint32_t length);
+
+/**
+ * @brief Counts samples lost because a producer's buffer was full.
+ */
+void OutputBackpressure_Overrun(uint32_t count);
+
+/**
+ * @brief Writes any pending shed notice and releases paused acquisition once the connection has caught up.
+ */
+void OutputBackpressure_Service(void);
+
+/**
+ * @brief Indicates if acquisition is being held.
+ */
+bool OutputBackpressure_IsPaused(void);
+
+/**
+ * @brief Converts a backpressure policy into a human readable string.
+ */
+const char* OutputBackpressure_PolicyToString(OutputBackpressure_Policy_t policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* OUTPUT_BACKPRESSURE_H_ */
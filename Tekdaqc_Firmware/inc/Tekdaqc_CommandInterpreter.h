@@ -130,11 +130,161 @@ extern "C" {
  */
 #define PARAMETER_INDEX			"INDEX"
 
+/**
+ * @def PARAMETER_FORMAT
+ * @brief String constant definition for the FORMAT parameter.
+ */
+#define PARAMETER_FORMAT		"FORMAT"
+
+/**
+ * @def PARAMETER_SIZE
+ * @brief String constant definition for the SIZE parameter.
+ */
+#define PARAMETER_SIZE			"SIZE"
+
+/**
+ * @def PARAMETER_LATENCY
+ * @brief String constant definition for the LATENCY parameter.
+ */
+#define PARAMETER_LATENCY		"LATENCY"
+
+/**
+ * @def PARAMETER_SOURCE
+ * @brief String constant definition for the SOURCE parameter.
+ */
+#define PARAMETER_SOURCE		"SOURCE"
+
+/**
+ * @def PARAMETER_EDGE
+ * @brief String constant definition for the EDGE parameter.
+ */
+#define PARAMETER_EDGE			"EDGE"
+
+/**
+ * @def PARAMETER_LEVEL
+ * @brief String constant definition for the LEVEL parameter.
+ */
+#define PARAMETER_LEVEL			"LEVEL"
+
+/**
+ * @def PARAMETER_PRE
+ * @brief String constant definition for the PRE parameter.
+ */
+#define PARAMETER_PRE			"PRE"
+
+/**
+ * @def PARAMETER_POST
+ * @brief String constant definition for the POST parameter.
+ */
+#define PARAMETER_POST			"POST"
+
+/**
+ * @def PARAMETER_DEPTH
+ * @brief String constant definition for the DEPTH parameter.
+ */
+#define PARAMETER_DEPTH			"DEPTH"
+
+/**
+ * @def PARAMETER_WINDOW
+ * @brief String constant definition for the WINDOW parameter.
+ */
+#define PARAMETER_WINDOW		"WINDOW"
+
+/**
+ * @def PARAMETER_BASIS
+ * @brief String constant definition for the BASIS parameter.
+ */
+#define PARAMETER_BASIS			"BASIS"
+
+/**
+ * @def PARAMETER_STEP
+ * @brief String constant definition for the STEP parameter.
+ */
+#define PARAMETER_STEP			"STEP"
+
+/**
+ * @def PARAMETER_REPORT
+ * @brief String constant definition for the REPORT parameter.
+ */
+#define PARAMETER_REPORT		"REPORT"
+
+/**
+ * @def PARAMETER_MIN
+ * @brief String constant definition for the MIN parameter.
+ */
+#define PARAMETER_MIN			"MIN"
+
+/**
+ * @def PARAMETER_MAX
+ * @brief String constant definition for the MAX parameter.
+ */
+#define PARAMETER_MAX			"MAX"
+
+/**
+ * @def PARAMETER_HYSTERESIS
+ * @brief String constant definition for the HYSTERESIS parameter.
+ */
+#define PARAMETER_HYSTERESIS	"HYSTERESIS"
+
+/**
+ * @def PARAMETER_MODE
+ * @brief String constant definition for the MODE parameter.
+ */
+#define PARAMETER_MODE			"MODE"
+
+/**
+ * @def PARAMETER_BAND
+ * @brief String constant definition for the BAND parameter.
+ */
+#define PARAMETER_BAND			"BAND"
+
+/**
+ * @def PARAMETER_HEARTBEAT
+ * @brief String constant definition for the HEARTBEAT parameter.
+ */
+#define PARAMETER_HEARTBEAT		"HEARTBEAT"
+
+/**
+ * @def PARAMETER_PERIOD
+ * @brief String constant definition for the PERIOD parameter.
+ */
+#define PARAMETER_PERIOD		"PERIOD"
+
+/**
+ * @def PARAMETER_POLICY
+ * @brief String constant definition for the POLICY parameter.
+ */
+#define PARAMETER_POLICY		"POLICY"
+
+/**
+ * @def PARAMETER_TIMEOUT
+ * @brief String constant definition for the TIMEOUT parameter.
+ */
+#define PARAMETER_TIMEOUT		"TIMEOUT"
+
+/**
+ * @def PARAMETER_DECIMATION
+ * @brief String constant definition for the DECIMATION parameter.
+ */
+#define PARAMETER_DECIMATION	"DECIMATION"
+
+/**
+ * @def PARAMETER_ADDRESS
+ * @brief String constant definition for the ADDRESS parameter.
+ */
+#define PARAMETER_ADDRESS		"ADDRESS"
+
+/**
+ * @def PARAMETER_PORT
+ * @brief String constant definition for the PORT parameter.
+ */
+#define PARAMETER_PORT			"PORT"
+
 /**
  * @def NUM_COMMANDS
  * @brief The total number of commands known by this board.
  */
-#define NUM_COMMANDS 41
+#define NUM_COMMANDS 55
 
 /**
  * @def TELNET_EOF
@@ -191,7 +341,21 @@ typedef enum {
 	COMMAND_EXIT_CALIBRATION_MODE = 37,
 	COMMAND_SET_FACTORY_MAC_ADDR = 38,
 	COMMAND_SET_BOARD_SERIAL_NUM = 39,
-	COMMAND_NONE = 40
+	COMMAND_GET_BUFFER_STATS = 40,
+	COMMAND_SET_OUTPUT_FORMAT = 41,
+	COMMAND_SET_SAMPLE_BATCH = 42,
+	COMMAND_SET_TRIGGER = 43,
+	COMMAND_ARM_TRIGGER = 44,
+	COMMAND_TRIGGER = 45,
+	COMMAND_SET_STATISTICS = 46,
+	COMMAND_SET_ALARM = 47,
+	COMMAND_SET_DEADBAND = 48,
+	COMMAND_SET_BACKPRESSURE = 49,
+	COMMAND_SET_UDP_STREAM = 50,
+	COMMAND_GET_SCAN_STATUS = 51,
+	COMMAND_GET_DATA_PORT_STATUS = 52,
+	COMMAND_SET_GAIN_CORRECTION_STEP = 53,
+	COMMAND_NONE = 54
 } Command_t;
 
 /**
@@ -234,7 +398,7 @@ extern const char* READ_ANALOG_INPUT_PARAMS[NUM_READ_ANALOG_INPUT_PARAMS];
  * @def NUM_ADD_ANALOG_INPUT_PARAMS
  * @brief The number of parameters for the ADD_ANALOG_INPUT command.
  */
-#define NUM_ADD_ANALOG_INPUT_PARAMS 5
+#define NUM_ADD_ANALOG_INPUT_PARAMS 7
 /* Prototype the ADD_ANALOG_INPUT command params array */
 extern const char* ADD_ANALOG_INPUT_PARAMS[NUM_ADD_ANALOG_INPUT_PARAMS];
 
@@ -526,6 +690,118 @@ extern const char* SET_FACTORY_MAC_ADDR_PARAMS[NUM_SET_FACTORY_MAC_ADDR_PARAMS];
 /* Prototype the SET_BOARD_SERIAL_NUM command params array */
 extern const char* SET_BOARD_SERIAL_NUM_PARAMS[NUM_SET_BOARD_SERIAL_NUM_PARAMS];
 
+/**
+ * @def NUM_GET_BUFFER_STATS_PARAMS
+ * @brief The number of parameters for the GET_BUFFER_STATS command.
+ */
+#define NUM_GET_BUFFER_STATS_PARAMS 0
+/* Prototype the GET_BUFFER_STATS command params array */
+extern const char* GET_BUFFER_STATS_PARAMS[NUM_GET_BUFFER_STATS_PARAMS];
+
+/**
+ * @def NUM_SET_OUTPUT_FORMAT_PARAMS
+ * @brief The number of parameters for the SET_OUTPUT_FORMAT command.
+ */
+#define NUM_SET_OUTPUT_FORMAT_PARAMS 1
+/* Prototype the SET_OUTPUT_FORMAT command params array */
+extern const char* SET_OUTPUT_FORMAT_PARAMS[NUM_SET_OUTPUT_FORMAT_PARAMS];
+
+/**
+ * @def NUM_SET_SAMPLE_BATCH_PARAMS
+ * @brief The number of parameters for the SET_SAMPLE_BATCH command.
+ */
+#define NUM_SET_SAMPLE_BATCH_PARAMS 2
+/* Prototype the SET_SAMPLE_BATCH command params array */
+extern const char* SET_SAMPLE_BATCH_PARAMS[NUM_SET_SAMPLE_BATCH_PARAMS];
+
+/**
+ * @def NUM_SET_TRIGGER_PARAMS
+ * @brief The number of parameters for the SET_TRIGGER command.
+ */
+#define NUM_SET_TRIGGER_PARAMS 6
+/* Prototype the SET_TRIGGER command params array */
+extern const char* SET_TRIGGER_PARAMS[NUM_SET_TRIGGER_PARAMS];
+
+/**
+ * @def NUM_ARM_TRIGGER_PARAMS
+ * @brief The number of parameters for the ARM_TRIGGER command.
+ */
+#define NUM_ARM_TRIGGER_PARAMS 1
+/* Prototype the ARM_TRIGGER command params array */
+extern const char* ARM_TRIGGER_PARAMS[NUM_ARM_TRIGGER_PARAMS];
+
+/**
+ * @def NUM_TRIGGER_PARAMS
+ * @brief The number of parameters for the TRIGGER command.
+ */
+#define NUM_TRIGGER_PARAMS 0
+/* Prototype the TRIGGER command params array */
+extern const char* TRIGGER_PARAMS[NUM_TRIGGER_PARAMS];
+
+/**
+ * @def NUM_SET_STATISTICS_PARAMS
+ * @brief The number of parameters for the SET_STATISTICS command.
+ */
+#define NUM_SET_STATISTICS_PARAMS 6
+/* Prototype the SET_STATISTICS command params array */
+extern const char* SET_STATISTICS_PARAMS[NUM_SET_STATISTICS_PARAMS];
+
+/**
+ * @def NUM_SET_ALARM_PARAMS
+ * @brief The number of parameters for the SET_ALARM command.
+ */
+#define NUM_SET_ALARM_PARAMS 6
+/* Prototype the SET_ALARM command params array */
+extern const char* SET_ALARM_PARAMS[NUM_SET_ALARM_PARAMS];
+
+/**
+ * @def NUM_SET_DEADBAND_PARAMS
+ * @brief The number of parameters for the SET_DEADBAND command.
+ */
+#define NUM_SET_DEADBAND_PARAMS 4
+/* Prototype the SET_DEADBAND command params array */
+extern const char* SET_DEADBAND_PARAMS[NUM_SET_DEADBAND_PARAMS];
+
+/**
+ * @def NUM_SET_BACKPRESSURE_PARAMS
+ * @brief The number of parameters for the SET_BACKPRESSURE command.
+ */
+#define NUM_SET_BACKPRESSURE_PARAMS 3
+/* Prototype the SET_BACKPRESSURE command params array */
+extern const char* SET_BACKPRESSURE_PARAMS[NUM_SET_BACKPRESSURE_PARAMS];
+
+/**
+ * @def NUM_SET_UDP_STREAM_PARAMS
+ * @brief The number of parameters for the SET_UDP_STREAM command.
+ */
+#define NUM_SET_UDP_STREAM_PARAMS 3
+/* Prototype the SET_UDP_STREAM command params array */
+extern const char* SET_UDP_STREAM_PARAMS[NUM_SET_UDP_STREAM_PARAMS];
+
+/**
+ * @def NUM_GET_SCAN_STATUS_PARAMS
+ * @brief The number of parameters for the GET_SCAN_STATUS command.
+ */
+#define NUM_GET_SCAN_STATUS_PARAMS 0
+/* Prototype the GET_SCAN_STATUS command params array */
+extern const char* GET_SCAN_STATUS_PARAMS[NUM_GET_SCAN_STATUS_PARAMS];
+
+/**
+ * @def NUM_GET_DATA_PORT_STATUS_PARAMS
+ * @brief The number of parameters for the GET_DATA_PORT_STATUS command.
+ */
+#define NUM_GET_DATA_PORT_STATUS_PARAMS 0
+/* Prototype the GET_DATA_PORT_STATUS command params array */
+extern const char* GET_DATA_PORT_STATUS_PARAMS[NUM_GET_DATA_PORT_STATUS_PARAMS];
+
+/**
+ * @def NUM_SET_GAIN_CORRECTION_STEP_PARAMS
+ * @brief The number of parameters for the SET_GAIN_CORRECTION_STEP command.
+ */
+#define NUM_SET_GAIN_CORRECTION_STEP_PARAMS 1
+/* Prototype the SET_GAIN_CORRECTION_STEP command params array */
+extern const char* SET_GAIN_CORRECTION_STEP_PARAMS[NUM_SET_GAIN_CORRECTION_STEP_PARAMS];
+
 /**
  * @def NUM_NONE_PARAMS
  * @brief The number of parameters for the NONE command.
@@ -98,6 +98,8 @@ typedef enum {
 	ERR_CALIBRATION_WRITE_FAILED	=	24U, /**< The function failed due to a failure to write the calibration value in flash. */
 	ERR_CALIBRATION_PARSE_ERROR		=	25U, /**< The function failed due to a failure to parse the calibration arguments. */
 	ERR_CALIBRATION_MISSING_KEY		=	26U, /**< The function failed due to a missing required key in the command. */
+	ERR_AIN_HISTORY_FULL			=	27U, /**< The function failed because the history arena has no room for the analog input. */
+	ERR_AIN_SCAN_INFEASIBLE			=	28U, /**< The function failed because the sample periods of the analog inputs can not all be met. */
 } Tekdaqc_Function_Error_t;
 
 /*--------------------------------------------------------------------------------------------------------*/
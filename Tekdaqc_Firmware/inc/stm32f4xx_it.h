@@ -54,6 +54,8 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 void EXTI15_10_IRQHandler(void);
+void DMA1_Stream3_IRQHandler(void);
+void TIM7_IRQHandler(void);
 void TIM5_IRQHandler(void);
 void CAN1_RX0_IRQHandler(void);
 
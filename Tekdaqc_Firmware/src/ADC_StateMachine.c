@@ -29,6 +29,7 @@
 #include <ADC_StateMachine.h>
 #include <ADS1256_Driver.h>
 #include <AnalogInput_Multiplexer.h>
+#include <Analog_History.h>
 #include <BoardTemperature.h>
 #include <core_cm4.h>
 #include <CommandState.h>
@@ -41,6 +42,7 @@
 #include <Tekdaqc_config.h>
 #include <Tekdaqc_Calibration.h>
 #include <Tekdaqc_CalibrationTable.h>
+#include <Tekdaqc_SampleCorrection.h>
 #include <Tekdaqc_Timers.h>
 #include <TelnetServer.h>
 #include <math.h>
@@ -85,6 +87,9 @@ static uint8_t numberSamplingInputs = 0U;
 /* The current input to sample */
 static uint8_t currentSamplingInput = 0U;
 
+/* The time the conversion in progress was started */
+static uint64_t conversionTime = 0U;
+
 /* Used to indicate if we are waiting on a temperature sample */
 static bool waitingOnTemp = false;
 
@@ -183,7 +188,7 @@ static void BeginNextConversion(Analog_Input_t* input) {
 	ApplyCalibrationParameters(input);
 	ADS1256_Sync(true);
 	ADS1256_Wakeup();
-	input->timestamps[input->bufferWriteIdx] = GetLocalTime();
+	conversionTime = GetLocalTime();
 }
 
 /**
@@ -359,32 +364,20 @@ static void ADC_Machine_Service_Idle(void) {
 			ADS1256_Sync(true);
 			waitingOnTemp = false;
 			/* We need to read it */
-			input->values[input->bufferWriteIdx] = ADS1256_GetMeasurement();
+			int32_t reading = ADS1256_GetMeasurement();
 			/* Update temperature */
-			updateBoardTemperature(input, input->values[input->bufferWriteIdx]);
-			++(input->bufferWriteIdx);
-			input->timestamps[input->bufferWriteIdx] = GetLocalTime();
-			ADS1256_Wakeup();
-#ifdef BOARD_TEMPERATURE_DEBUG
-			//printf("[ADC STATE MACHINE] Cold junction temperature sample is complete.\n\r");
-#endif
-			/* Check the buffer positions for errors/roll over */
-			if (input->bufferWriteIdx == input->bufferReadIdx) {
-				/* Check the buffer positions for errors/roll over */
+			updateBoardTemperature(input, reading);
+			if (AnalogHistory_Write(IN_COLD_JUNCTION, conversionTime, reading) == FALSE) {
+				/* The history is full, the oldest unread reading was overwritten */
 #ifdef BOARD_TEMPERATURE_DEBUG
 				printf("[ADC STATE MACHINE] Cold junction sampling overwrote data before it could be read.\n\r");
 #endif
-				//TelnetWriteErrorMessage("[ADC STATE MACHINE] Cold junction sampling overwrote data before it could be read.\n\r");
-				/* Buffer is full, overwrite */
-				input->bufferReadIdx = (input->bufferReadIdx + 1) % ANALOG_INPUT_BUFFER_SIZE;
-			}
-			if (((input->bufferWriteIdx - 1U) == input->bufferReadIdx) && ((input->bufferWriteIdx - 1U) > 0U)) {
-				/* This means we wrote over some data */
-			}
-			if (input->bufferWriteIdx == ANALOG_INPUT_BUFFER_SIZE) {
-				/* We have reached the end of the buffer and need to start writing to the beginning */
-				input->bufferWriteIdx = 0U;
 			}
+			ADS1256_Wakeup();
+			conversionTime = GetLocalTime();
+#ifdef BOARD_TEMPERATURE_DEBUG
+			//printf("[ADC STATE MACHINE] Cold junction temperature sample is complete.\n\r");
+#endif
 		}
 	}
 }
@@ -399,24 +392,20 @@ static void ADC_Machine_Service_Sampling(void) {
 	/* Check if data is ready */
 	if (ADS1256_IsDataReady(false)) {
 		/* We need to read it */
-		uint8_t writeIndex = samplingInputs[currentSamplingInput]->bufferWriteIdx;
 		int32_t reading = ADS1256_GetMeasurement();
 		Analog_Input_t* input = samplingInputs[currentSamplingInput];
-		float factor = (input->physicalInput == IN_COLD_JUNCTION) ? 1.0f :
-				Tekdaqc_GetGainCorrectionFactor(input->rate, input->gain, input->buffer, getBoardTemperature());
-		int32_t corrected = (int32_t) roundf(factor * reading);
-		samplingInputs[currentSamplingInput]->values[writeIndex] = corrected;
-		samplingInputs[currentSamplingInput]->bufferWriteIdx = (writeIndex + 1) % ANALOG_INPUT_BUFFER_SIZE;
-		if (samplingInputs[currentSamplingInput]->bufferWriteIdx
-				== samplingInputs[currentSamplingInput]->bufferReadIdx) {
-			/* Check the buffer positions for errors/roll over */
+		SampleCorrection_t correction;
+		SampleCorrection_Init(&correction);
+		if (input->physicalInput != IN_COLD_JUNCTION) {
+			correction.gain = Tekdaqc_GetCachedGainCorrection(input->rate, input->gain, input->buffer);
+		}
+		int32_t corrected = SampleCorrection_Apply(&correction, reading);
+		if (AnalogHistory_Write(input->physicalInput, conversionTime, corrected) == FALSE) {
+			/* The history is full, the oldest unread sample was overwritten */
 #ifdef ADC_STATE_MACHINE_DEBUG
 			printf("[ADC STATE MACHINE] Analog sampling overwrote data before it could be read.\n\r");
 #endif
 			TelnetWriteErrorMessage("Analog sampling overwrote data before it could be read.");
-			/* Buffer is full, overwrite */
-			samplingInputs[currentSamplingInput]->bufferReadIdx = (samplingInputs[currentSamplingInput]->bufferReadIdx
-					+ 1) % ANALOG_INPUT_BUFFER_SIZE;
 		}
 
 		/* Select the next input */
@@ -450,8 +439,7 @@ static void ADC_Machine_Service_Sampling(void) {
 #endif
 				ADS1256_Wakeup(); /* Begin the next sample */
 				/* Save the real time clock entry for the sample */
-				samplingInputs[currentSamplingInput]->timestamps[samplingInputs[currentSamplingInput]->bufferWriteIdx] =
-						GetLocalTime();
+				conversionTime = GetLocalTime();
 			}
 		} else {
 			/* We are single channel sampling */
@@ -463,8 +451,7 @@ static void ADC_Machine_Service_Sampling(void) {
 			BeginNextConversion(samplingInputs[currentSamplingInput]);
 			//ADS1256_Wakeup(); /* Begin the next sample */
 			/* Save the real time clock entry for the sample */
-			//samplingInputs[currentSamplingInput]->timestamps[samplingInputs[currentSamplingInput]->bufferWriteIdx] =
-			//		GetLocalTime();
+			//conversionTime = GetLocalTime();
 		}
 		if ((SampleCurrent == SampleTotal) && !((numberSamplingInputs > 1) && SampleCurrent == 0)) {
 			/* The equality check is because we incremented already */
@@ -499,20 +486,11 @@ static void ADC_Machine_Service_Muxing(void) {
 		/* We are waiting for a temperature sample to complete */
 		if (ADS1256_IsDataReady(false)) {
 			/* We need to read it */
-			uint8_t writeIndex = input->bufferWriteIdx;
-			input->values[writeIndex] = ADS1256_GetMeasurement();
+			int32_t reading = ADS1256_GetMeasurement();
 			/* Update temperature */
-			updateBoardTemperature(input, input->values[writeIndex]);
-			input->bufferWriteIdx = (writeIndex + 1) % ANALOG_INPUT_BUFFER_SIZE;
-			if (input->bufferWriteIdx == input->bufferReadIdx) {
-				/* Check the buffer positions for errors/roll over */
-				/*#ifdef ADC_STATE_MACHINE_DEBUG
-				 printf("[ADC STATE MACHINE] Analog sampling overwrote data before it could be read.\n\r");
-				 #endif
-				 TelnetWriteErrorMessage("Analog sampling overwrote data before it could be read.");*/
-				/* Buffer is full, overwrite */
-				input->bufferReadIdx = (input->bufferReadIdx + 1) % ANALOG_INPUT_BUFFER_SIZE;
-			}
+			updateBoardTemperature(input, reading);
+			/* The history overwrites the oldest reading if it is full */
+			AnalogHistory_Write(IN_COLD_JUNCTION, GetLocalTime(), reading);
 
 #ifdef BOARD_TEMPERATURE_DEBUG
 			printf("[ADC STATE MACHINE] Cold junction temperature sample is complete.\n\r");
@@ -857,6 +835,12 @@ void ADC_Machine_Input_Sample(Analog_Input_t** inputs, uint32_t count, bool sing
 	}
 
 	samplingInputs = inputs;
+	/* Only samples taken from here on are written out */
+	for (uint8_t i = 0U; i < numberSamplingInputs; ++i) {
+		if (samplingInputs[i] != NULL) {
+			AnalogHistory_Discard(samplingInputs[i]->physicalInput);
+		}
+	}
 
 	Analog_Input_t* input = samplingInputs[currentSamplingInput];
 	CurrentState = ADC_CHANNEL_SAMPLING;
@@ -872,7 +856,7 @@ void ADC_Machine_Input_Sample(Analog_Input_t** inputs, uint32_t count, bool sing
 		ADS1256_Sync(false);
 		ADS1256_Wakeup(); /* Start Sampling */
 		/* Save the real time clock entry for the sample */
-		input->timestamps[input->bufferWriteIdx] = GetLocalTime();
+		conversionTime = GetLocalTime();
 	}
 }
 
@@ -121,28 +121,7 @@ static void SelectInternalInput(InternalAnalogInput_t input) {
 	ADS1256_AIN_t pos;
 	ADS1256_AIN_t neg;
 	/* Make the switch */
-	switch (input) {
-	case SUPPLY_9V:
-		pos = SUPPLY_9V_AINP;
-		neg = SUPPLY_9V_AINN;
-		break;
-	case SUPPLY_5V:
-		pos = SUPPLY_5V_AINP;
-		neg = SUPPLY_5V_AINN;
-		break;
-	case SUPPLY_3_3V:
-		pos = SUPPLY_3_3V_AINP;
-		neg = SUPPLY_3_3V_AINN;
-		break;
-	case COLD_JUNCTION:
-		pos = COLD_JUNCTION_AINP;
-		neg = COLD_JUNCTION_AINN;
-		break;
-	case EXTERNAL_ANALOG_IN:
-		pos = EXTERNAL_ANALOG_IN_AINP;
-		neg = EXTERNAL_ANALOG_IN_AINN;
-		break;
-	default:
+	if (GetInternalInputChannels(input, &pos, &neg) == false) {
 #ifdef INPUT_MULTIPLEXER_DEBUG
 		printf("[Analog Input Multiplexer] The requested internal input is invalid.\n\r");
 #endif
@@ -332,6 +311,42 @@ void ResetSelectedInput(void) {
 	SelectInternalInput(EXTERNAL_ANALOG_IN);
 }
 
+/**
+ * Looks up the ADC input channels which the specified internal input is connected to.
+ *
+ * @param input InternalAnalogInput_t The internal input to lookup.
+ * @param pos ADS1256_AIN_t* Set to the high side analog input channel.
+ * @param neg ADS1256_AIN_t* Set to the low side analog input channel.
+ * @retval bool TRUE if the input was valid.
+ */
+bool GetInternalInputChannels(InternalAnalogInput_t input, ADS1256_AIN_t* pos, ADS1256_AIN_t* neg) {
+	switch (input) {
+	case SUPPLY_9V:
+		*pos = SUPPLY_9V_AINP;
+		*neg = SUPPLY_9V_AINN;
+		break;
+	case SUPPLY_5V:
+		*pos = SUPPLY_5V_AINP;
+		*neg = SUPPLY_5V_AINN;
+		break;
+	case SUPPLY_3_3V:
+		*pos = SUPPLY_3_3V_AINP;
+		*neg = SUPPLY_3_3V_AINN;
+		break;
+	case COLD_JUNCTION:
+		*pos = COLD_JUNCTION_AINP;
+		*neg = COLD_JUNCTION_AINN;
+		break;
+	case EXTERNAL_ANALOG_IN:
+		*pos = EXTERNAL_ANALOG_IN_AINP;
+		*neg = EXTERNAL_ANALOG_IN_AINN;
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
 /**
  * Looks up the corresponding ExternalMuxedInput_t for the specified input number.
  *
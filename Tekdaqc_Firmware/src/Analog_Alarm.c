@@ -0,0 +1,255 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Alarm.c
+ * @brief Source file for the analog input range alarms.
+ *
+ * The main loop hands every block of corrected samples to AnalogAlarm_Check(). When an alarm is configured, a pair of
+ * thresholds is precomputed for each of the three range states. The thresholds of the current state already include
+ * the hysteresis, so the next state is found from two compares without any branches:
+ *
+ *     next = IN_RANGE - (value < low[status]) + (value > high[status])
+ *
+ * Only a change of state takes a branch, which writes an event and drives the alarm output.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_Alarm.h"
+#include "Digital_Output.h"
+#include "Tekdaqc_BSP.h"
+#include "Tekdaqc_Config.h"
+#include "Tekdaqc_DataFrame.h"
+#include "Tekdaqc_Memory.h"
+#include "TelnetServer.h"
+#include "Data_Output.h"
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def NUM_ALARM_STATES
+ * @brief The number of values of AnalogInputStatus_t.
+ */
+#define NUM_ALARM_STATES	3U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Alarm state of an input.
+ */
+typedef struct {
+	AnalogAlarm_Config_t config; /**< The configuration. */
+	int32_t low[NUM_ALARM_STATES]; /**< For each current status, a sample below this is BELOW_RANGE. */
+	int32_t high[NUM_ALARM_STATES]; /**< For each current status, a sample above this is ABOVE_RANGE. */
+	bool driving; /**< If the alarm output is currently turned on. */
+} AnalogAlarm_Channel_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The alarm state of each physical input */
+static AnalogAlarm_Channel_t channels[NUM_ANALOG_INPUTS] CCM_BSS;
+
+/* The frame buffer used for binary events */
+static uint8_t frame[DATA_FRAME_ALARM_SIZE];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * Writes a change of range status to the data connection in the current output format and drives the alarm output.
+ *
+ * @param input Analog_Input_t* The input, with its new status.
+ * @param alarm AnalogAlarm_Channel_t* The alarm state of the input.
+ * @param timestamp uint64_t The time of the sample which changed the status.
+ * @param value int32_t The sample which changed the status.
+ * @retval none
+ */
+static void WriteAlarm(const Analog_Input_t* input, AnalogAlarm_Channel_t* alarm, uint64_t timestamp,
+		int32_t value) {
+	uint8_t channel = (uint8_t) input->physicalInput;
+	if (DataOutput_GetFormat() == TELNET_FORMAT_BINARY) {
+		DataOutput_WriteBuffer(frame, DataFrame_EncodeAnalogAlarm(frame, channel, timestamp, (uint8_t) input->status,
+				value));
+	} else {
+		snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, "?L%" PRIu8 "\r\n%" PRIu64 ",%s,%" PRIi32 "%c\r\n", channel,
+				timestamp, AnalogAlarm_StatusToString(input->status), value, 0x1e);
+		TelnetWriteString(TOSTRING_BUFFER);
+	}
+	if (alarm->config.output != ANALOG_ALARM_NO_OUTPUT) {
+		alarm->driving = (input->status == IN_RANGE) ? FALSE : TRUE;
+		SetDigitalOutputChannel(alarm->config.output, (alarm->driving == TRUE) ? OUTPUT_ON : OUTPUT_OFF);
+	}
+}
+
+/**
+ * @internal
+ * Turns off the output of an alarm if the alarm turned it on.
+ *
+ * @param alarm AnalogAlarm_Channel_t* The alarm state of the input.
+ * @retval none
+ */
+static void ReleaseOutput(AnalogAlarm_Channel_t* alarm) {
+	if (alarm->driving == TRUE) {
+		SetDigitalOutputChannel(alarm->config.output, OUTPUT_OFF);
+		alarm->driving = FALSE;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Turns off the alarms of every input.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogAlarm_Init(void) {
+	memset(channels, 0, sizeof(channels));
+	for (uint_fast8_t i = 0U; i < NUM_ANALOG_INPUTS; ++i) {
+		channels[i].config.output = ANALOG_ALARM_NO_OUTPUT;
+	}
+}
+
+/**
+ * Sets the alarm configuration of an input. The range is stored in the input and its status is reset to IN_RANGE,
+ * so the first sample outside the range raises an event.
+ *
+ * @param input Analog_Input_t* The input.
+ * @param config const AnalogAlarm_Config_t* The new configuration.
+ * @retval bool TRUE if the configuration was applied, FALSE if the range, hysteresis or output is invalid.
+ */
+bool AnalogAlarm_Configure(Analog_Input_t* input, const AnalogAlarm_Config_t* config) {
+	uint8_t channel = (uint8_t) input->physicalInput;
+	if (channel >= NUM_ANALOG_INPUTS) {
+		return FALSE;
+	}
+	if ((config->hysteresis < 0) || ((int64_t) config->min + config->hysteresis > config->max)
+			|| ((config->output >= NUM_DIGITAL_OUTPUTS) && (config->output != ANALOG_ALARM_NO_OUTPUT))) {
+#ifdef ANALOG_ALARM_DEBUG
+		printf("[Analog Alarm] Invalid alarm for input %" PRIu8 ".\n\r", channel);
+#endif
+		return FALSE;
+	}
+	AnalogAlarm_Channel_t* alarm = &channels[channel];
+	ReleaseOutput(alarm);
+	alarm->config = *config;
+	alarm->low[BELOW_RANGE] = config->min + config->hysteresis;
+	alarm->low[IN_RANGE] = config->min;
+	alarm->low[ABOVE_RANGE] = config->min;
+	alarm->high[BELOW_RANGE] = config->max;
+	alarm->high[IN_RANGE] = config->max;
+	alarm->high[ABOVE_RANGE] = config->max - config->hysteresis;
+	input->min = config->min;
+	input->max = config->max;
+	input->status = IN_RANGE;
+	return TRUE;
+}
+
+/**
+ * Retrieves the alarm configuration of an input.
+ *
+ * @param channel uint8_t The physical input.
+ * @param config AnalogAlarm_Config_t* The structure to fill.
+ * @retval none
+ */
+void AnalogAlarm_GetConfig(uint8_t channel, AnalogAlarm_Config_t* config) {
+	if (channel < NUM_ANALOG_INPUTS) {
+		*config = channels[channel].config;
+	}
+}
+
+/**
+ * Turns off the alarm of an input, releasing its output if the alarm turned it on.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval none
+ */
+void AnalogAlarm_Disable(uint8_t channel) {
+	if (channel < NUM_ANALOG_INPUTS) {
+		ReleaseOutput(&channels[channel]);
+		memset(&channels[channel], 0, sizeof(AnalogAlarm_Channel_t));
+		channels[channel].config.output = ANALOG_ALARM_NO_OUTPUT;
+	}
+}
+
+/**
+ * Checks a block of corrected samples of one input against its range, in the order they were taken. Every change of
+ * range status is written to the data connection.
+ *
+ * @param input Analog_Input_t* The input the samples were taken from.
+ * @param samples const Analog_Samples_t* The raw samples, for their timestamps.
+ * @param values const int32_t* The corrected values of the samples.
+ * @param count uint32_t The number of samples.
+ * @retval none
+ */
+void AnalogAlarm_Check(Analog_Input_t* input, const Analog_Samples_t* samples, const int32_t* values, uint32_t count) {
+	uint8_t channel = (uint8_t) input->physicalInput;
+	if ((channel >= NUM_ANALOG_INPUTS) || (channels[channel].config.enabled == FALSE)) {
+		return;
+	}
+	AnalogAlarm_Channel_t* alarm = &channels[channel];
+	uint_fast8_t status = (uint_fast8_t) input->status;
+	for (uint32_t i = 0U; i < count; ++i) {
+		int32_t value = values[i];
+		uint_fast8_t next = (uint_fast8_t) IN_RANGE - (value < alarm->low[status]) + (value > alarm->high[status]);
+		if (next != status) {
+			status = next;
+			input->status = (AnalogInputStatus_t) next;
+			WriteAlarm(input, alarm, samples[i].ui64TimeStamp, value);
+		}
+	}
+}
+
+/**
+ * Converts an input range status into a human readable string.
+ *
+ * @param status AnalogInputStatus_t The range status.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogAlarm_StatusToString(AnalogInputStatus_t status) {
+	switch (status) {
+	case BELOW_RANGE:
+		return "BELOW";
+	case IN_RANGE:
+		return "IN";
+	case ABOVE_RANGE:
+		return "ABOVE";
+	default:
+		return "UNKNOWN";
+	}
+}
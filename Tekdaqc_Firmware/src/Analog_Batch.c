@@ -0,0 +1,247 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Batch.c
+ * @brief Groups binary analog samples into block frames.
+ *
+ * Sits between the analog sample ring and the data connection. Each channel being sampled gets a slot which collects
+ * consecutive samples until the batch size is reached or the oldest sample has waited for the latency bound, and is
+ * then written out as a single DATA_FRAME_ANALOG_BLOCK frame. Everything here runs in the main loop.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_Batch.h"
+#include "TelnetServer.h"
+#include "Data_Output.h"
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief A block of samples being collected for one channel. The slot is free while count is zero.
+ */
+typedef struct {
+	uint8_t channel; /**< The physical channel the samples belong to. */
+	uint8_t count; /**< The number of samples collected. */
+	uint64_t timestamps[DATA_FRAME_MAX_BLOCK_SAMPLES]; /**< The sample times in microseconds since the UNIX epoch. */
+	int32_t values[DATA_FRAME_MAX_BLOCK_SAMPLES]; /**< The sample values. */
+} AnalogBatch_Slot_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The blocks being collected */
+static AnalogBatch_Slot_t slots[ANALOG_BATCH_SLOTS];
+
+/* The number of samples per block */
+static uint8_t batchSize = ANALOG_BATCH_DEFAULT_SIZE;
+
+/* The longest time a sample may wait, in microseconds */
+static uint64_t batchLatency = ANALOG_BATCH_DEFAULT_LATENCY * 1000U;
+
+/* Scratch buffer the frames are encoded into */
+static uint8_t frame[DATA_FRAME_MAX_BLOCK_SIZE(DATA_FRAME_MAX_BLOCK_SAMPLES)];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Writes out the block held by a slot and frees it.
+ */
+static void AnalogBatch_WriteSlot(AnalogBatch_Slot_t* slot);
+
+/**
+ * @internal
+ * @brief Finds the slot to use for a channel.
+ */
+static AnalogBatch_Slot_t* AnalogBatch_GetSlot(uint8_t channel);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Writes out the block held by a slot and frees it. A single sample is sent as a plain sample frame, which is smaller
+ * than a block of one.
+ *
+ * @param slot AnalogBatch_Slot_t* The slot to write out.
+ * @retval none
+ */
+static void AnalogBatch_WriteSlot(AnalogBatch_Slot_t* slot) {
+	uint32_t length;
+	if (slot->count == 1U) {
+		length = DataFrame_EncodeAnalog(frame, slot->channel, slot->timestamps[0], slot->values[0]);
+	} else {
+		length = DataFrame_EncodeAnalogBlock(frame, slot->channel, slot->timestamps, slot->values, slot->count);
+	}
+	slot->count = 0U;
+	if (DataOutput_GetFormat() == TELNET_FORMAT_BINARY) {
+		DataOutput_WriteBuffer(frame, length);
+	}
+}
+
+/**
+ * Finds the slot to use for a channel. This is the slot already collecting the channel if there is one, otherwise a
+ * free slot. If every slot is busy, the one holding the oldest sample is written out and reused.
+ *
+ * @param channel uint8_t The physical channel.
+ * @retval AnalogBatch_Slot_t* The slot to use.
+ */
+static AnalogBatch_Slot_t* AnalogBatch_GetSlot(uint8_t channel) {
+	AnalogBatch_Slot_t* empty = NULL;
+	AnalogBatch_Slot_t* oldest = &slots[0];
+	for (uint_fast8_t i = 0U; i < ANALOG_BATCH_SLOTS; ++i) {
+		if (slots[i].count == 0U) {
+			if (empty == NULL) {
+				empty = &slots[i];
+			}
+		} else if (slots[i].channel == channel) {
+			return &slots[i];
+		} else if (slots[i].timestamps[0] < oldest->timestamps[0]) {
+			oldest = &slots[i];
+		}
+	}
+	if (empty == NULL) {
+#ifdef ANALOG_BATCH_DEBUG
+		printf("[Analog Batch] Evicting channel %i for channel %i.\n\r", oldest->channel, channel);
+#endif
+		AnalogBatch_WriteSlot(oldest);
+		empty = oldest;
+	}
+	empty->channel = channel;
+	return empty;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Discards any pending blocks and restores the default batch size and latency bound.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogBatch_Init(void) {
+	for (uint_fast8_t i = 0U; i < ANALOG_BATCH_SLOTS; ++i) {
+		slots[i].count = 0U;
+	}
+	batchSize = ANALOG_BATCH_DEFAULT_SIZE;
+	batchLatency = ANALOG_BATCH_DEFAULT_LATENCY * 1000U;
+}
+
+/**
+ * Sets the number of samples per block and the latency bound. Any pending blocks are written out first so that no
+ * block spans two configurations.
+ *
+ * @param size uint8_t The number of samples per block, from 1 to DATA_FRAME_MAX_BLOCK_SAMPLES. 1 disables batching.
+ * @param latency uint32_t The longest time a sample may wait in a block before it is written, in milliseconds.
+ * @retval bool TRUE if the configuration was applied, FALSE if either value was out of range.
+ */
+bool AnalogBatch_Configure(uint8_t size, uint32_t latency) {
+	if (!IS_ANALOG_BATCH_SIZE(size) || !IS_ANALOG_BATCH_LATENCY(latency)) {
+		return FALSE;
+	}
+	AnalogBatch_Flush();
+	batchSize = size;
+	batchLatency = (uint64_t) latency * 1000U;
+	return TRUE;
+}
+
+/**
+ * Retrieves the number of samples per block.
+ *
+ * @param none
+ * @retval uint8_t The number of samples per block.
+ */
+uint8_t AnalogBatch_GetSize(void) {
+	return batchSize;
+}
+
+/**
+ * Retrieves the latency bound.
+ *
+ * @param none
+ * @retval uint32_t The longest time a sample may wait in a block, in milliseconds.
+ */
+uint32_t AnalogBatch_GetLatency(void) {
+	return (uint32_t) (batchLatency / 1000U);
+}
+
+/**
+ * Adds a sample to the pending block of its channel, writing the block out once it holds the batch size. A sample
+ * which is older than the last one in its block, such as after the clock was set, starts a new block.
+ *
+ * @param channel uint8_t The physical channel the sample was taken from.
+ * @param timestamp uint64_t The time of the sample in microseconds since the UNIX epoch.
+ * @param value int32_t The sample value.
+ * @retval none
+ */
+void AnalogBatch_Add(uint8_t channel, uint64_t timestamp, int32_t value) {
+	AnalogBatch_Slot_t* slot = AnalogBatch_GetSlot(channel);
+	if ((slot->count > 0U) && (timestamp < slot->timestamps[slot->count - 1U])) {
+		AnalogBatch_WriteSlot(slot);
+	}
+	slot->timestamps[slot->count] = timestamp;
+	slot->values[slot->count] = value;
+	++slot->count;
+	if (slot->count >= batchSize) {
+		AnalogBatch_WriteSlot(slot);
+	}
+}
+
+/**
+ * Writes out every pending block whose oldest sample has waited for the latency bound, so that slow channels are
+ * still delivered promptly.
+ *
+ * @param now uint64_t The current time in microseconds since the UNIX epoch.
+ * @retval none
+ */
+void AnalogBatch_Service(uint64_t now) {
+	for (uint_fast8_t i = 0U; i < ANALOG_BATCH_SLOTS; ++i) {
+		if ((slots[i].count > 0U) && ((now < slots[i].timestamps[0]) || (now - slots[i].timestamps[0] >= batchLatency))) {
+			AnalogBatch_WriteSlot(&slots[i]);
+		}
+	}
+}
+
+/**
+ * Writes out every pending block regardless of its age.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogBatch_Flush(void) {
+	for (uint_fast8_t i = 0U; i < ANALOG_BATCH_SLOTS; ++i) {
+		if (slots[i].count > 0U) {
+			AnalogBatch_WriteSlot(&slots[i]);
+		}
+	}
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Deadband.c
+ * @brief Source file for the analog input deadband filter.
+ *
+ * The main loop passes every corrected sample which would be written to the data connection through
+ * AnalogDeadband_Filter(). The band is converted to ADC counts each time a sample is reported, so a percentage band
+ * costs no more per sample than an absolute one: a sample is only compared against the last reported sample and the
+ * time it was reported.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_Deadband.h"
+#include "Tekdaqc_BSP.h"
+#include "Tekdaqc_Memory.h"
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#include <inttypes.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Deadband state of an input.
+ */
+typedef struct {
+	AnalogDeadband_Config_t config; /**< The configuration. */
+	bool reported; /**< If a sample has been reported since the deadband was restarted. */
+	int32_t last; /**< The last reported sample. */
+	uint64_t lastTime; /**< The time of the last reported sample. */
+	int64_t threshold; /**< The band around the last reported sample, in ADC counts. */
+	uint32_t suppressed; /**< The number of samples not reported since the deadband was configured. */
+} AnalogDeadband_Channel_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The deadband state of each physical input */
+static AnalogDeadband_Channel_t channels[NUM_ANALOG_INPUTS] CCM_BSS;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Turns off the deadband of every input.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogDeadband_Init(void) {
+	memset(channels, 0, sizeof(channels));
+}
+
+/**
+ * Sets the deadband configuration of an input, clearing its count of suppressed samples. The next sample of the
+ * input is always reported.
+ *
+ * @param channel uint8_t The physical input.
+ * @param config const AnalogDeadband_Config_t* The new configuration.
+ * @retval bool TRUE if the configuration was applied, FALSE if the band is negative.
+ */
+bool AnalogDeadband_Configure(uint8_t channel, const AnalogDeadband_Config_t* config) {
+	if (channel >= NUM_ANALOG_INPUTS) {
+		return FALSE;
+	}
+	if (!(config->band >= 0.0f)) {
+#ifdef ANALOG_DEADBAND_DEBUG
+		printf("[Analog Deadband] Invalid band for input %" PRIu8 ".\n\r", channel);
+#endif
+		return FALSE;
+	}
+	memset(&channels[channel], 0, sizeof(AnalogDeadband_Channel_t));
+	channels[channel].config = *config;
+	return TRUE;
+}
+
+/**
+ * Retrieves the deadband configuration of an input.
+ *
+ * @param channel uint8_t The physical input.
+ * @param config AnalogDeadband_Config_t* The structure to fill.
+ * @retval none
+ */
+void AnalogDeadband_GetConfig(uint8_t channel, AnalogDeadband_Config_t* config) {
+	if (channel < NUM_ANALOG_INPUTS) {
+		*config = channels[channel].config;
+	}
+}
+
+/**
+ * Turns off the deadband of an input, so every sample is reported again.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval none
+ */
+void AnalogDeadband_Disable(uint8_t channel) {
+	if (channel < NUM_ANALOG_INPUTS) {
+		memset(&channels[channel], 0, sizeof(AnalogDeadband_Channel_t));
+	}
+}
+
+/**
+ * Forgets the last reported sample of every input, so each input reports its first sample. Called when a scan is
+ * started.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogDeadband_Restart(void) {
+	for (uint_fast8_t i = 0U; i < NUM_ANALOG_INPUTS; ++i) {
+		channels[i].reported = FALSE;
+	}
+}
+
+/**
+ * Decides if a sample should be written to the data connection. It is if the input has no deadband, if it is the
+ * first sample since a restart, if it is outside the band around the last reported sample, or if the heartbeat
+ * interval has passed since the last reported sample.
+ *
+ * @param channel uint8_t The physical input.
+ * @param timestamp uint64_t The time the sample was taken, in microseconds.
+ * @param value int32_t The corrected sample value.
+ * @retval bool TRUE if the sample should be written out.
+ */
+bool AnalogDeadband_Filter(uint8_t channel, uint64_t timestamp, int32_t value) {
+	if (channel >= NUM_ANALOG_INPUTS) {
+		return TRUE;
+	}
+	AnalogDeadband_Channel_t* state = &channels[channel];
+	if (state->config.mode == DEADBAND_MODE_NONE) {
+		return TRUE;
+	}
+	if ((state->reported == TRUE) && (llabs((int64_t) value - state->last) <= state->threshold)
+			&& ((state->config.heartbeat == 0U) || ((timestamp - state->lastTime) < state->config.heartbeat))) {
+		++state->suppressed;
+		return FALSE;
+	}
+	state->reported = TRUE;
+	state->last = value;
+	state->lastTime = timestamp;
+	if (state->config.mode == DEADBAND_MODE_PERCENT) {
+		state->threshold = (int64_t) fabsf((float) value * state->config.band / 100.0f);
+	} else {
+		state->threshold = (int64_t) state->config.band;
+	}
+	return TRUE;
+}
+
+/**
+ * Retrieves the number of samples of an input which were not reported since its deadband was configured.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval uint32_t The number of suppressed samples.
+ */
+uint32_t AnalogDeadband_GetSuppressed(uint8_t channel) {
+	return (channel < NUM_ANALOG_INPUTS) ? channels[channel].suppressed : 0U;
+}
+
+/**
+ * Converts a deadband mode into a human readable string.
+ *
+ * @param mode AnalogDeadband_Mode_t The deadband mode.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogDeadband_ModeToString(AnalogDeadband_Mode_t mode) {
+	switch (mode) {
+	case DEADBAND_MODE_NONE:
+		return "NONE";
+	case DEADBAND_MODE_ABSOLUTE:
+		return "ABSOLUTE";
+	case DEADBAND_MODE_PERCENT:
+		return "PERCENT";
+	default:
+		return "UNKNOWN";
+	}
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_History.c
+ * @brief Source file for the analog input history arena.
+ *
+ * Each added input owns a contiguous region of the arena, used as a circular buffer of its most recent samples. The
+ * regions are kept packed at the start of the arena: a new region is taken from the end of the allocated part, and
+ * when one is freed the regions above it are moved down to close the gap. Inputs are only added and removed while
+ * the ADC is not sampling, and the history is only written from the main loop, so no locking is needed.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_History.h"
+#include "Tekdaqc_BSP.h"
+#include "Tekdaqc_Memory.h"
+#include <string.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#include <inttypes.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief The region of the arena owned by an input.
+ */
+typedef struct {
+	uint16_t offset; /**< The first sample of the region. */
+	uint16_t depth; /**< The number of samples in the region, 0 if the input has no history. */
+	uint16_t head; /**< The position the next sample is written at. */
+	uint16_t count; /**< The number of valid samples. */
+	uint16_t unread; /**< The number of samples not yet read by AnalogHistory_Read(). */
+} AnalogHistory_Region_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The sample values of the arena (ADC counts) */
+static int32_t arenaValues[ANALOG_HISTORY_ARENA_SIZE] CCM_BSS;
+
+/* The sample timestamps of the arena, in microseconds */
+static uint64_t arenaTimestamps[ANALOG_HISTORY_ARENA_SIZE] CCM_BSS;
+
+/* The number of samples of the arena allocated to inputs */
+static uint16_t arenaUsed = 0U;
+
+/* The region owned by each physical input */
+static AnalogHistory_Region_t regions[NUM_ANALOG_INPUTS];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * Retrieves the region of an input which has a history.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval AnalogHistory_Region_t* The region, or NULL if the input has no history.
+ */
+static AnalogHistory_Region_t* GetRegion(uint8_t channel) {
+	if ((channel >= NUM_ANALOG_INPUTS) || (regions[channel].depth == 0U)) {
+		return NULL;
+	}
+	return &regions[channel];
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Releases the history of every input, leaving the whole arena free.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogHistory_Init(void) {
+	memset(regions, 0, sizeof(regions));
+	arenaUsed = 0U;
+}
+
+/**
+ * Allocates the history of an input from the arena. Any history the input already had is released first.
+ *
+ * @param channel uint8_t The physical input.
+ * @param depth uint16_t The number of samples to keep.
+ * @retval bool TRUE if the history was allocated, FALSE if the depth is invalid or the arena does not have room.
+ */
+bool AnalogHistory_Allocate(uint8_t channel, uint16_t depth) {
+	if ((channel >= NUM_ANALOG_INPUTS) || !IS_ANALOG_HISTORY_DEPTH(depth)) {
+		return FALSE;
+	}
+	AnalogHistory_Free(channel);
+	if (depth > (ANALOG_HISTORY_ARENA_SIZE - arenaUsed)) {
+#ifdef ANALOG_HISTORY_DEBUG
+		printf("[Analog History] Unable to allocate %" PRIu16 " samples for input %" PRIu8 ", %" PRIu16 " free.\n\r",
+				depth, channel, (uint16_t) (ANALOG_HISTORY_ARENA_SIZE - arenaUsed));
+#endif
+		return FALSE;
+	}
+	regions[channel].offset = arenaUsed;
+	regions[channel].depth = depth;
+	regions[channel].head = 0U;
+	regions[channel].count = 0U;
+	regions[channel].unread = 0U;
+	arenaUsed += depth;
+	return TRUE;
+}
+
+/**
+ * Returns the history of an input to the arena. The regions above it are moved down so the free part of the arena
+ * stays contiguous.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval none
+ */
+void AnalogHistory_Free(uint8_t channel) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	if (region == NULL) {
+		return;
+	}
+	uint16_t start = region->offset;
+	uint16_t depth = region->depth;
+	uint16_t moved = arenaUsed - (start + depth);
+	memmove(&arenaValues[start], &arenaValues[start + depth], moved * sizeof(arenaValues[0]));
+	memmove(&arenaTimestamps[start], &arenaTimestamps[start + depth], moved * sizeof(arenaTimestamps[0]));
+	for (uint_fast8_t i = 0U; i < NUM_ANALOG_INPUTS; ++i) {
+		if ((regions[i].depth != 0U) && (regions[i].offset > start)) {
+			regions[i].offset -= depth;
+		}
+	}
+	arenaUsed -= depth;
+	memset(region, 0, sizeof(AnalogHistory_Region_t));
+}
+
+/**
+ * Records a sample in the history of an input, replacing the oldest sample if the history is full. Samples for an
+ * input without a history are dropped.
+ *
+ * @param channel uint8_t The physical input.
+ * @param timestamp uint64_t The time the sample was taken, in microseconds.
+ * @param value int32_t The sample value.
+ * @retval bool FALSE if a sample which had not yet been read was replaced.
+ */
+bool AnalogHistory_Write(uint8_t channel, uint64_t timestamp, int32_t value) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	bool retval = TRUE;
+	if (region == NULL) {
+		return TRUE;
+	}
+	arenaValues[region->offset + region->head] = value;
+	arenaTimestamps[region->offset + region->head] = timestamp;
+	region->head = (region->head + 1U) % region->depth;
+	if (region->count < region->depth) {
+		++region->count;
+	}
+	if (region->unread < region->depth) {
+		++region->unread;
+	} else {
+		retval = FALSE;
+	}
+	return retval;
+}
+
+/**
+ * Reads the oldest sample of an input which has not yet been read.
+ *
+ * @param channel uint8_t The physical input.
+ * @param timestamp uint64_t* Set to the time the sample was taken.
+ * @param value int32_t* Set to the sample value.
+ * @retval bool TRUE if a sample was read, FALSE if there are no unread samples.
+ */
+bool AnalogHistory_Read(uint8_t channel, uint64_t* timestamp, int32_t* value) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	if ((region == NULL) || (region->unread == 0U)) {
+		return FALSE;
+	}
+	uint16_t index = (region->head + region->depth - region->unread) % region->depth;
+	*timestamp = arenaTimestamps[region->offset + index];
+	*value = arenaValues[region->offset + index];
+	--region->unread;
+	return TRUE;
+}
+
+/**
+ * Marks every sample in the history of an input as read. The samples remain available to iterators.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval none
+ */
+void AnalogHistory_Discard(uint8_t channel) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	if (region != NULL) {
+		region->unread = 0U;
+	}
+}
+
+/**
+ * Retrieves the number of samples of an input which have not yet been read.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval uint16_t The number of unread samples.
+ */
+uint16_t AnalogHistory_GetUnread(uint8_t channel) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	return (region == NULL) ? 0U : region->unread;
+}
+
+/**
+ * Retrieves the number of samples the history of an input holds.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval uint16_t The depth, or 0 if the input has no history.
+ */
+uint16_t AnalogHistory_GetDepth(uint8_t channel) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	return (region == NULL) ? 0U : region->depth;
+}
+
+/**
+ * Retrieves the number of samples of the arena not allocated to any input.
+ *
+ * @param none
+ * @retval uint16_t The number of free samples.
+ */
+uint16_t AnalogHistory_GetFree(void) {
+	return ANALOG_HISTORY_ARENA_SIZE - arenaUsed;
+}
+
+/**
+ * Starts iterating over the most recent samples of an input. Fewer samples are returned if the history holds fewer.
+ *
+ * @param iterator AnalogHistory_Iterator_t* The iterator to start.
+ * @param channel uint8_t The physical input.
+ * @param count uint16_t The maximum number of samples to return.
+ * @retval none
+ */
+void AnalogHistory_Begin(AnalogHistory_Iterator_t* iterator, uint8_t channel, uint16_t count) {
+	AnalogHistory_Region_t* region = GetRegion(channel);
+	iterator->channel = channel;
+	if (region == NULL) {
+		iterator->index = 0U;
+		iterator->remaining = 0U;
+	} else {
+		iterator->index = region->head;
+		iterator->remaining = (count < region->count) ? count : region->count;
+	}
+}
+
+/**
+ * Retrieves the next most recent sample from an iterator. Samples are returned newest first.
+ *
+ * @param iterator AnalogHistory_Iterator_t* The iterator.
+ * @param timestamp uint64_t* Set to the time the sample was taken.
+ * @param value int32_t* Set to the sample value.
+ * @retval bool TRUE if a sample was returned, FALSE if the iteration is complete.
+ */
+bool AnalogHistory_Next(AnalogHistory_Iterator_t* iterator, uint64_t* timestamp, int32_t* value) {
+	AnalogHistory_Region_t* region = GetRegion(iterator->channel);
+	if ((region == NULL) || (iterator->remaining == 0U)) {
+		return FALSE;
+	}
+	iterator->index = (iterator->index == 0U) ? (region->depth - 1U) : (iterator->index - 1U);
+	*timestamp = arenaTimestamps[region->offset + iterator->index];
+	*value = arenaValues[region->offset + iterator->index];
+	--iterator->remaining;
+	return TRUE;
+}
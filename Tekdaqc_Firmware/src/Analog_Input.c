@@ -30,7 +30,25 @@
 #include "AnalogInput_Multiplexer.h"
 #include "Tekdaqc_CommandInterpreter.h"
 #include "ADS1256_Driver.h"
+#include "ADS1256_SPI_DMA.h"
+#include "Tekdaqc_Timers.h"
+#include "Tekdaqc_Timestamp.h"
 #include "TelnetServer.h"
+#include "Data_Output.h"
+#include "Tekdaqc_DataFrame.h"
+#include "Analog_Batch.h"
+#include "Analog_ScanList.h"
+#include "Analog_Trigger.h"
+#include "Analog_History.h"
+#include "Analog_Statistics.h"
+#include "Analog_Alarm.h"
+#include "Analog_Deadband.h"
+#include "ColdJunction_Policy.h"
+#include "Output_Backpressure.h"
+#include "BoardTemperature.h"
+#include "Tekdaqc_CalibrationTable.h"
+#include "Tekdaqc_SampleCorrection.h"
+#include "Tekdaqc_Memory.h"
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
@@ -52,25 +70,29 @@
  */
 #define ANALOG_INPUT_HEADER "\n\r--------------------\n\rAnalog Input\n\r\tName: %s\n\r\tPhysical Input: %i\n\r\tPGA: %s\n\r\tRate: %s\n\r\tBuffer Status: %s\n\r--------------------\n\r"
 
+/**
+ * @internal
+ * @def ANALOG_CORRECTION_BLOCK_SIZE
+ * @brief The number of samples drained from the sample buffer and corrected together.
+ */
+#define ANALOG_CORRECTION_BLOCK_SIZE 16U
+
 #define ANALOGHANDLER_INITIALIZING 0
 #define ANALOGHANDLER_SAMPLING 1
-#define COLD_JUNCTION_READ_INTERVAL 333
 //lfao-these variables are used by the DRDY interrupt handler for it to know which channel is sampling and
 //the number of samples to take...
 volatile int viCurrentChannel;
 volatile uint64_t viSamplesToTake;
 //lfao-circular buffer details...
-Analog_Samples_t AnalogSampleBuffer[ANALOG_SAMPLES_BUFFER_SIZE];
-volatile int iHead;
-volatile int iTail;
+static Analog_Samples_t AnalogSampleBuffer[ANALOG_SAMPLES_BUFFER_SIZE] CCM_BSS;
+static RingBuffer_t AnalogSampleRing;
+//the buffer's drop count already reported as shed...
+static uint32_t reportedDrops = 0U;
 
 extern Analog_Input_t* aInputs[];
 extern volatile uint64_t numAnalogSamples;
 extern volatile int numOfInputs;
-extern void ApplyCalibrationParameters(Analog_Input_t* input);
 extern void updateBoardTemperature(Analog_Input_t* input, int32_t code);
-extern float Tekdaqc_GetGainCorrectionFactor(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1256_BUFFER_t buffer, float temperature);
-extern float getBoardTemperature(void);
 extern volatile int totalDelay;
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE VARIABLES */
@@ -84,13 +106,13 @@ static WriteFunction writer = 0;
 /*--------------------------------------------------------------------------------------------------------*/
 
 /* List of external analog inputs */
-Analog_Input_t Ext_AInputs[NUM_EXT_ANALOG_INPUTS];
+Analog_Input_t Ext_AInputs[NUM_EXT_ANALOG_INPUTS] CCM_BSS;
 
 /* The offset calibration input */
-Analog_Input_t Offset_Cal_AInput;
+Analog_Input_t Offset_Cal_AInput CCM_BSS;
 
 /* List of internal analog inputs */
-Analog_Input_t Int_AInputs[NUM_INT_ANALOG_INPUTS];
+Analog_Input_t Int_AInputs[NUM_INT_ANALOG_INPUTS] CCM_BSS;
 
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION PROTOTYPES */
@@ -108,6 +130,12 @@ static void InitializeInput(Analog_Input_t* input);
  */
 static void RemoveAnalogInputByID(uint8_t id);
 
+/**
+ * @internal
+ * @brief Empties the list of inputs being sampled and the scan list compiled from it.
+ */
+static void ClearAnalogScan(void);
+
 
 
 /*--------------------------------------------------------------------------------------------------------*/
@@ -117,294 +145,388 @@ static void RemoveAnalogInputByID(uint8_t id);
 //lfao-init buffer and indexes
 void InitAnalogSamplesBuffer(void)
 {
-	iHead=0;
-	iTail=0;
+	RingBuffer_Init(&AnalogSampleRing, AnalogSampleBuffer, sizeof(Analog_Samples_t), ANALOG_SAMPLES_BUFFER_SIZE);
+	reportedDrops = 0U;
 }
 
-//lfao-writes a new sample and updates the iHead
+//lfao-writes a new sample, called only from the DRDY/DMA interrupt...
 int WriteSampleToBuffer(Analog_Samples_t *Data)
 {
+	return (RingBuffer_Write(&AnalogSampleRing, Data) == true) ? 0 : 1;
+}
+
+//lfao-reads sample from buffer, called only from the main loop...
+int ReadSampleFromBuffer(Analog_Samples_t *Data)
+{
+	return (RingBuffer_Read(&AnalogSampleRing, Data) == true) ? 0 : 1;
+}
+
+/**
+ * Retrieves the counters of the buffer which carries samples from the DRDY interrupt to the main loop.
+ *
+ * @param stats RingBuffer_Statistics_t* Pointer to the structure to fill.
+ * @retval none
+ */
+void GetAnalogSamplesBufferStats(RingBuffer_Statistics_t* stats)
+{
+	RingBuffer_GetStatistics(&AnalogSampleRing, stats);
+}
 
-	//full or empty
-	if((iHead+2)%ANALOG_SAMPLES_BUFFER_SIZE ==  iTail%ANALOG_SAMPLES_BUFFER_SIZE)
+/**
+ * Stores a conversion result for the channel currently being sampled and counts it against the samples remaining.
+ * Called from interrupt context, either by the DRDY handler or by the ADS1256 DMA read engine.
+ *
+ * @param reading uint32_t The raw 24 bit reading from the ADS1256.
+ * @retval none
+ */
+void AnalogSampleReady(uint32_t reading)
+{
+	Analog_Samples_t newAnalogSample;
+	newAnalogSample.iChannel = viCurrentChannel;
+	newAnalogSample.iReading = reading;
+	//stamped with the DRDY edge latched by the capture timer...
+	newAnalogSample.ui64TimeStamp = Timestamp_GetDataReadyTime();
+	WriteSampleToBuffer(&newAnalogSample);
+	//lfao - infinite sampling, just let it run unless the data connection needs it held, else disable this interrupt...
+	if(viSamplesToTake==-1)
 	{
-		return 1;
+		if(OutputBackpressure_IsPaused())
+		{
+			//the stream never returns to switch channels, so hand it back to the channel handler to wait...
+			ADS1256_EXTI_Disable();
+			TriggerChannelSwitch();
+		}
 	}
 	else
 	{
-		iHead=iHead%ANALOG_SAMPLES_BUFFER_SIZE;
-		AnalogSampleBuffer[iHead].iChannel = Data->iChannel;
-		AnalogSampleBuffer[iHead].iReading = Data->iReading;
-		AnalogSampleBuffer[iHead].ui64TimeStamp= Data->ui64TimeStamp;
-		iHead++;
-	    return 0;
+		viSamplesToTake--;
+		if(viSamplesToTake==0)
+		{
+			ADS1256_EXTI_Disable();
+			//the entry is done, move on to the next hop right away...
+			TriggerChannelSwitch();
+		}
 	}
 }
-//lfao-reads sample from buffer and updates iTail
-int ReadSampleFromBuffer(Analog_Samples_t *Data)
-{
 
-	//full/empty
-	if(iTail%ANALOG_SAMPLES_BUFFER_SIZE ==  iHead%ANALOG_SAMPLES_BUFFER_SIZE)
+/**
+ * Corrects a block of samples, checks them against their inputs' alarms, updates the board temperature from the cold
+ * junction and keeps them in the inputs' history. Every sample taken passes through here, whether or not it is later
+ * written out. Consecutive samples of the same channel are corrected in a single pass.
+ *
+ * @param samples const Analog_Samples_t* The samples, oldest first.
+ * @param corrected int32_t* Receives the corrected value of each sample.
+ * @param count uint32_t The number of samples, at most ANALOG_CORRECTION_BLOCK_SIZE.
+ * @retval none
+ */
+static void CorrectAnalogSamples(const Analog_Samples_t* samples, int32_t* corrected, uint32_t count)
+{
+	uint32_t raw[ANALOG_CORRECTION_BLOCK_SIZE];
+	SampleCorrection_t correction;
+	Analog_Input_t* input;
+	uint32_t start;
+	uint32_t end;
+	uint32_t i;
+	for(i = 0; i < count; i++)
 	{
-		return 1;
+		raw[i] = samples[i].iReading;
 	}
-	else
+	//correct each run of samples from the same channel in a single pass...
+	for(start = 0; start < count; start = end)
 	{
-		iTail=iTail%ANALOG_SAMPLES_BUFFER_SIZE;
-		Data->iChannel = AnalogSampleBuffer[iTail].iChannel;
-		Data->iReading = AnalogSampleBuffer[iTail].iReading;
-		Data->ui64TimeStamp = AnalogSampleBuffer[iTail].ui64TimeStamp;
-		iTail++;
-	    return 0;
+		for(end = start + 1; (end < count) && (samples[end].iChannel == samples[start].iChannel); end++);
+		input = GetAnalogInputByNumber(samples[start].iChannel);
+		SampleCorrection_Init(&correction);
+		if(input->physicalInput != IN_COLD_JUNCTION)
+		{
+			correction.gain = Tekdaqc_GetCachedGainCorrection(input->rate, input->gain, input->buffer);
+		}
+		SampleCorrection_ApplyRawBlock(&correction, &raw[start], &corrected[start], end - start);
+		//check the run against the input's range, raising an event on any change of status...
+		AnalogAlarm_Check(input, &samples[start], &corrected[start], end - start);
+		if(input->physicalInput == IN_COLD_JUNCTION)
+		{
+			//cold junction, the latest reading updates the board temperature and paces the next read...
+			updateBoardTemperature(input, corrected[end - 1]);
+			ColdJunction_PolicyObserve(samples[end - 1].ui64TimeStamp, getBoardTemperature());
+		}
+	}
+	for(i = 0; i < count; i++)
+	{
+		//keep the corrected sample in the input's history
+		AnalogHistory_Write((uint8_t) samples[i].iChannel, samples[i].ui64TimeStamp, corrected[i]);
+	}
+}
+
+/**
+ * Writes a block of corrected samples to the data connection, in the current output format.
+ *
+ * @param samples const Analog_Samples_t* The samples, oldest first, giving the channel and time stamp of each.
+ * @param corrected const int32_t* The corrected value of each sample.
+ * @param count uint32_t The number of samples.
+ * @retval none
+ */
+void WriteAnalogSamples(const Analog_Samples_t* samples, const int32_t* corrected, uint32_t count)
+{
+	uint32_t i;
+	for(i = 0; i < count; i++)
+	{
+		//keep the sample's statistics, inputs reporting only aggregates are not written out sample by sample...
+		if(AnalogStatistics_Record((uint8_t) samples[i].iChannel, samples[i].ui64TimeStamp, corrected[i]) == FALSE)
+		{
+			continue;
+		}
+		//...and only written out when it leaves the input's deadband...
+		if(AnalogDeadband_Filter((uint8_t) samples[i].iChannel, samples[i].ui64TimeStamp, corrected[i]) == FALSE)
+		{
+			continue;
+		}
+		//...and the data connection can take it
+		if(OutputBackpressure_Admit(OUTPUT_BACKPRESSURE_RECORD_SIZE) == FALSE)
+		{
+			continue;
+		}
+		if(DataOutput_GetFormat() == TELNET_FORMAT_BINARY)
+		{
+			AnalogBatch_Add((uint8_t) samples[i].iChannel, samples[i].ui64TimeStamp, corrected[i]);
+		}
+		else
+		{
+			TelnetWriteFormatted("?A%i\r\n%" PRIu64 ",%" PRIi32 "%c\r\n", samples[i].iChannel, samples[i].ui64TimeStamp, corrected[i], 0x1e);
+		}
 	}
 }
 
 //lfao-converts the gathered data into ASCII and writes it to Telnet...
 void WriteToTelnet_Analog(void)
 {
-	Analog_Samples_t tempData;
-	Analog_Input_t* input;
-	float factor;
-	int32_t corrected;
-	int32_t reading;
-	while(1)
+	Analog_Samples_t samples[ANALOG_CORRECTION_BLOCK_SIZE];
+	int32_t corrected[ANALOG_CORRECTION_BLOCK_SIZE];
+	RingBuffer_Statistics_t stats;
+	uint32_t count;
+	//samples the interrupt found no room for are shed as well...
+	GetAnalogSamplesBufferStats(&stats);
+	OutputBackpressure_Overrun(stats.drops - reportedDrops);
+	reportedDrops = stats.drops;
+	do
 	{
-		if(ReadSampleFromBuffer(&tempData)==0)
+		//while the data connection cannot take a block, leave the samples buffered...
+		if(!AnalogTrigger_IsCapturing()
+				&& OutputBackpressure_Hold(ANALOG_CORRECTION_BLOCK_SIZE * OUTPUT_BACKPRESSURE_RECORD_SIZE))
 		{
-			input = GetAnalogInputByNumber(tempData.iChannel);
-			reading = ADS1256_ConvertRawValue(tempData.iReading);
-			//lfao_todo: Need to apply gain correction factor, the code below complains of Out Of Range Temperature,
-			//probably due to the "temperature" is not updated...
-			if(tempData.iChannel == 36)
+			//...making way for new samples if the policy prefers them to the oldest
+			for(count = OutputBackpressure_Excess(RingBuffer_Count(&AnalogSampleRing), ANALOG_SAMPLES_BUFFER_SIZE); count > 0; count--)
 			{
-				//cold junction...
-				input = GetAnalogInputByNumber(36);
-			    updateBoardTemperature(input, reading);
+				ReadSampleFromBuffer(&samples[0]);
 			}
-			factor = (input->physicalInput == IN_COLD_JUNCTION) ? 1.0f :
-					Tekdaqc_GetGainCorrectionFactor(input->rate, input->gain, input->buffer, getBoardTemperature());
-			corrected = (int32_t) roundf(factor * reading);
-			/* Update temperature */
-
-
-		    snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, "?A%i\r\n%" PRIu64 ",%" PRIi32 "%c\r\n", tempData.iChannel, tempData.ui64TimeStamp, corrected, 0x1e);
-		    TelnetWriteString(TOSTRING_BUFFER);
+			break;
+		}
+		//drain a block of samples from the buffer...
+		for(count = 0; count < ANALOG_CORRECTION_BLOCK_SIZE; count++)
+		{
+			if(ReadSampleFromBuffer(&samples[count])!=0)
+			{
+				break;
+			}
+		}
+		//...correct it, alarms and history see every sample...
+		CorrectAnalogSamples(samples, corrected, count);
+		//...but while a trigger is armed the samples are only recorded, the captured window is written out later
+		if(AnalogTrigger_IsCapturing())
+		{
+			AnalogTrigger_Record(samples, corrected, count);
 		}
 		else
 		{
-			break;
+			WriteAnalogSamples(samples, corrected, count);
 		}
+	} while(count == ANALOG_CORRECTION_BLOCK_SIZE);
+	if(DataOutput_GetFormat() == TELNET_FORMAT_BINARY)
+	{
+		//flush the blocks of channels which have waited long enough...
+		AnalogBatch_Service(GetLocalTime());
 	}
 }
 
 //lfao
 volatile int currentAnalogChannel=0;
 volatile int currentAnHandlerState=0;
-volatile int multipleChannelSamples=0;
-volatile int readColdJunction=0;
+//the scan entry being sampled...
+static const AnalogScan_Entry_t* currentScanEntry = NULL;
 
 //lfao-processes the switching of channels and enabling of the DRDY interrupt...
+//the inputs are walked in the order of the scan list compiled by the read command...
 void AnalogChannelHandler(void)
 {
-	int i;
-	ExternalMuxedInput_t exmuxedinput;
-	Analog_Input_t* coldJunctionInput;
-	readColdJunction++;
-	//switching channels
-	if(currentAnHandlerState==1)
+	uint8_t scanCount = AnalogScan_GetCount();
+	const AnalogScan_Entry_t* nextScanEntry;
+	uint32_t settleTime;
+	uint64_t now;
+	//bookkeeping for the entry which just finished...
+	if(currentAnHandlerState==3)
 	{
-        for(i=0; ; i++)
-        {
-
-        	if(readColdJunction > COLD_JUNCTION_READ_INTERVAL && numOfInputs > 1)
-        	{
-        		break;
-        	}
-			currentAnalogChannel = currentAnalogChannel%NUM_ANALOG_INPUTS;
-			if(i > NUM_ANALOG_INPUTS)
-				break;
-			if(aInputs[currentAnalogChannel] != NULL)
+		//a continuous stream held by the data connection picks up where it left off, RDATAC is still running...
+		if(viSamplesToTake==-1)
+		{
+			if(OutputBackpressure_IsPaused())
+			{
+				ArmChannelSwitchTimer(OUTPUT_BACKPRESSURE_PAUSE_POLL);
+			}
+			else
 			{
-				if(aInputs[currentAnalogChannel]->added==CHANNEL_ADDED)
-				  break;
+				ADS1256_EXTI_Enable();
 			}
-			currentAnalogChannel++;
+			return;
 		}
-        if(readColdJunction > COLD_JUNCTION_READ_INTERVAL && numOfInputs > 1)
-        {
-        	totalDelay = 0;
-			//do input switching here...
-        	SelectColdJunctionInput();
-
-			viCurrentChannel = 36;
-			viSamplesToTake = 1;
-			coldJunctionInput = GetAnalogInputByNumber(IN_COLD_JUNCTION);
-
-			/* Set sampling parameters */
-			ADS1256_SetDataRate(coldJunctionInput->rate);
-			ADS1256_SetPGASetting(coldJunctionInput->gain);
-			ADS1256_SetInputBufferSetting(coldJunctionInput->buffer);
-			ApplyCalibrationParameters(coldJunctionInput);
-			/* Begin sampling */
-			ADS1256_Sync(true);
-			ADS1256_Wakeup(); /* Start Sampling */
-	        //Enable DRDY interrupt...
-			ADS1256_EXTI_Enable();
-			currentAnHandlerState=3;
-
-        }
-        else
-        {
-			if(aInputs[currentAnalogChannel] != NULL)
+		if(viSamplesToTake!=0)
+		{
+			return;
+		}
+		currentAnHandlerState=1;
+		if(currentScanEntry != AnalogScan_GetColdJunction())
+		{
+			//end of sampling for a single channel...
+			if(numOfInputs==1)
+			{
+				ClearAnalogScan();
+				currentAnHandlerState = 0;
+			}
+			//for multichannel, move on through the schedule...sampling ends after numAnalogSamples
+			//passes of the scan list, or frames of a multi-rate scan, zero samples forever...
+			else
 			{
-				if(aInputs[currentAnalogChannel]->added==CHANNEL_ADDED)
+				currentAnalogChannel = AnalogScan_Advance((uint8_t) currentAnalogChannel);
+				if(numAnalogSamples && AnalogScan_GetFrame() >= (uint32_t) numAnalogSamples)
 				{
-	#if 0
-					if(aInputs[currentAnalogChannel]->physicalInput == IN_COLD_JUNCTION)
-					{
-						aInputs[currentAnalogChannel]->physicalInput = EXTERNAL_3;
-						ADS1256_SetInputChannels(EXTERNAL_ANALOG_IN_AINP, EXTERNAL_ANALOG_IN_AINN);
-						GPIO_WriteBit(OCAL_CONTROL_GPIO_PORT, OCAL_CONTROL_PIN, EXT_ANALOG_SELECT);
-						//exmuxedinput = GetExternalMuxedInputByNumber(aInputs[currentAnalogChannel]->physicalInput);
-						exmuxedinput = EXTERN_3;
-						GPIO_Write(EXT_ANALOG_IN_MUX_PORT, (exmuxedinput | (GPIO_ReadOutputData(EXT_ANALOG_IN_MUX_PORT) & EXT_ANALOG_IN_BITMASK)));
-
-						//lfao---todo---
-						//SelectColdJunctionInput();
-						Analog_Input_t* cold = GetAnalogInputByNumber(IN_COLD_JUNCTION);
-
-						viCurrentChannel = aInputs[currentAnalogChannel]->physicalInput;
-						viSamplesToTake = 1;
-						//BeginNextConversion(cold);
-						//ADS1256_Sync(true);
-						/* We need to read it */
-						//input->values[input->bufferWriteIdx] = ADS1256_GetMeasurement();
-						/* Update temperature */
-						//updateBoardTemperature(input, input->values[input->bufferWriteIdx]);
-						//++(input->bufferWriteIdx);
-						//input->timestamps[input->bufferWriteIdx] = GetLocalTime();
-						//ADS1256_Wakeup();
-
-						currentAnHandlerState=2;
-
-					}
-
-	#endif
-					//else
-					//{
-						if(aInputs[currentAnalogChannel]->physicalInput == IN_COLD_JUNCTION)
-						{
-							SelectColdJunctionInput();
-						}
-						else
-						{
-							//do input switching here...
-							ADS1256_SetInputChannels(EXTERNAL_ANALOG_IN_AINP, EXTERNAL_ANALOG_IN_AINN);
-							GPIO_WriteBit(OCAL_CONTROL_GPIO_PORT, OCAL_CONTROL_PIN, EXT_ANALOG_SELECT);
-							exmuxedinput = GetExternalMuxedInputByNumber(aInputs[currentAnalogChannel]->physicalInput);
-							GPIO_Write(EXT_ANALOG_IN_MUX_PORT, (exmuxedinput | (GPIO_ReadOutputData(EXT_ANALOG_IN_MUX_PORT) & EXT_ANALOG_IN_BITMASK)));
-						}
-						viCurrentChannel = aInputs[currentAnalogChannel]->physicalInput;
-						if(numAnalogSamples)
-						{
-							if(numOfInputs == 1)
-							{
-							   viSamplesToTake = numAnalogSamples;
-							}
-							else
-							{
-								viSamplesToTake = 1;
-							}
-						}
-						else
-						{
-							//for single channel, putting viSamplesToTake to -1, tells the DRDY handler that
-							//we want to sample continuously...
-							if(numOfInputs == 1)
-							{
-							   viSamplesToTake = -1;
-							}
-							else
-							{
-								viSamplesToTake = 1;
-							}
-						}
-						currentAnHandlerState=2;
-					//}
+					ClearAnalogScan();
+					currentAnHandlerState = 0;
 				}
 			}
-        }
-	}
-	//add another state for the 1ms delay????????
-	else if(currentAnHandlerState==2)
-	{
-		/* Set sampling parameters */
-		ADS1256_SetDataRate(aInputs[currentAnalogChannel]->rate);
-		ADS1256_SetPGASetting(aInputs[currentAnalogChannel]->gain);
-		ADS1256_SetInputBufferSetting(aInputs[currentAnalogChannel]->buffer);
-		ApplyCalibrationParameters(aInputs[currentAnalogChannel]);
-		/* Begin sampling */
-		ADS1256_Sync(true);
-		ADS1256_Wakeup(); /* Start Sampling */
-        //Enable DRDY interrupt...
-		ADS1256_EXTI_Enable();
-		currentAnHandlerState=3;
-
+		}
+		scanCount = AnalogScan_GetCount();
 	}
-	else if(currentAnHandlerState==3)
+	//switching channels
+	if(currentAnHandlerState==1)
 	{
-		if(viSamplesToTake==0)
+		if(scanCount == 0U)
+		{
+			currentAnHandlerState = 0;
+			return;
+		}
+		//hold the scan between hops while the data connection catches up...
+		if(OutputBackpressure_IsPaused())
+		{
+			ArmChannelSwitchTimer(OUTPUT_BACKPRESSURE_PAUSE_POLL);
+			return;
+		}
+		now = GetLocalTime();
+		//a multi-rate scan does not start a frame before its time...
+		settleTime = AnalogScan_Pace(now);
+		if(settleTime > 0U)
+		{
+			ArmChannelSwitchTimer(settleTime);
+			return;
+		}
+		//the cold junction policy decides how often to steal a slot from the scan...
+		if(numOfInputs > 1 && ColdJunction_PolicyIsDue(now))
 		{
-			currentAnHandlerState=1;
-			if(viCurrentChannel == 36 && numOfInputs > 1)
+			totalDelay = 0;
+			ColdJunction_PolicyScheduled(now);
+			currentScanEntry = AnalogScan_GetColdJunction();
+			nextScanEntry = AnalogScan_GetEntry((uint8_t) (currentAnalogChannel%scanCount));
+			viSamplesToTake = 1;
+		}
+		else
+		{
+			currentAnalogChannel = currentAnalogChannel%scanCount;
+			currentScanEntry = AnalogScan_GetEntry((uint8_t) currentAnalogChannel);
+			nextScanEntry = AnalogScan_GetEntry(AnalogScan_Peek((uint8_t) currentAnalogChannel));
+			if(numOfInputs == 1 && numAnalogSamples == 0)
 			{
-				readColdJunction = 0;
+				//for single channel, putting viSamplesToTake to -1, tells the DRDY handler that
+				//we want to sample continuously...
+				viSamplesToTake = -1;
+			}
+			else if(numOfInputs == 1)
+			{
+				viSamplesToTake = numAnalogSamples;
 			}
 			else
 			{
-				//end of sampling for a single channel...
-				if(numOfInputs==1)
-				{
-					aInputs[currentAnalogChannel]=NULL;
-					currentAnHandlerState = 0;
-				}
-				//for multichannel, each input should have numAnalogSamples...so we multiply
-				//this value with the numOfInputs and compare it with the total collected samples...
-				else
-				{
-					//multichannel infinite sampling...turn the sample count to zero each time...
-					if(numAnalogSamples)
-					{
-						multipleChannelSamples++;
-						if(numOfInputs*numAnalogSamples==multipleChannelSamples)
-						{
-							//empty the aInputs array...
-							for (uint_fast8_t i = 0; i < NUM_ANALOG_INPUTS; ++i)
-							{
-								aInputs[i] = NULL;
-							}
-							readColdJunction = 0;
-							currentAnHandlerState = 0;
-						}
-					}
-					currentAnalogChannel++;
-				}
+				viSamplesToTake = 1;
 			}
 		}
+		//do input switching here...the relays may already be settling if they were switched ahead
+		settleTime = AnalogScan_Select(currentScanEntry, nextScanEntry);
+		viCurrentChannel = currentScanEntry->physicalInput;
+		currentAnHandlerState=2;
+		if(settleTime > 0U)
+		{
+			//come back once the external multiplexer has settled...
+			ArmChannelSwitchTimer(settleTime);
+			return;
+		}
+	}
+	if(currentAnHandlerState==2)
+	{
+		/* Set sampling parameters and begin sampling */
+		AnalogScan_Start(currentScanEntry);
+		//a single channel sampled forever never changes registers, so stream it with RDATAC...
+		if(numOfInputs==1 && viSamplesToTake==-1)
+		{
+			ADS1256_SetContinuousRead(true);
+		}
+		//Enable DRDY interrupt...the last sample of the entry kicks the handler again
+		currentAnHandlerState=3;
+		ADS1256_EXTI_Enable();
 	}
+}
 
+/**
+ * Starts walking the compiled scan list. The first hop is taken right away and every following one is scheduled by
+ * the channel switch timer or the last conversion of the previous hop, rather than polled.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogScanStart(void)
+{
+	currentAnHandlerState=1;
+	Timestamp_Synchronize();
+	currentAnalogChannel = AnalogScan_Rewind(GetLocalTime());
+	ColdJunction_PolicyReset(GetLocalTime());
+	AnalogStatistics_Restart();
+	AnalogDeadband_Restart();
+	TriggerChannelSwitch();
+}
 
+/**
+ * Empties the list of inputs being sampled and the scan list compiled from it, once sampling has finished.
+ *
+ * @param none
+ * @retval none
+ */
+static void ClearAnalogScan(void)
+{
+	for (uint_fast8_t i = 0; i < NUM_ANALOG_INPUTS; ++i)
+	{
+		aInputs[i] = NULL;
+	}
+	AnalogScan_Clear();
 }
 
 void AnalogHalt(void)
 {
+	CancelChannelSwitchTimer();
 	ADS1256_EXTI_Disable();
+	/* Let any DMA read in flight finish before the SPI is used for register writes */
+	while (ADS1256_DMA_IsBusy());
+	/* Leave continuous read mode so the ADC accepts register commands again */
+	ADS1256_SetContinuousRead(false);
 	currentAnHandlerState=0;
-	multipleChannelSamples=0;
 	numAnalogSamples = 0;
 	numOfInputs = 0;
-	readColdJunction=0;
+	AnalogScan_Clear();
 }
 /**
  * Initializes the members of the specified input structure.
@@ -416,15 +538,11 @@ static void InitializeInput(Analog_Input_t* input) {
 	input->buffer = ADS1256_BUFFER_ENABLED;
 	input->gain = ADS1256_PGAx1;
 	input->rate = ADS1256_SPS_10;
-	input->bufferReadIdx = 0U;
-	input->bufferWriteIdx = 0U;
+	input->historyDepth = ANALOG_HISTORY_DEFAULT_DEPTH;
+	input->period = 0U;
 	input->min = 0;
 	input->max = 0;
-	uint_fast8_t i = 0U;
-	for (; i < ANALOG_INPUT_BUFFER_SIZE; ++i) {
-		input->values[i] = 0;
-		input->timestamps[i] = 0U;
-	}
+	input->status = IN_RANGE;
 	input->added = CHANNEL_NOTADDED;
 }
 
@@ -436,12 +554,20 @@ static void InitializeInput(Analog_Input_t* input) {
  */
 static void RemoveAnalogInputByID(uint8_t id) {
 	if (isExternalInput(id)) {
+		AnalogStatistics_Disable(id);
+		AnalogAlarm_Disable(id);
+		AnalogDeadband_Disable(id);
+		AnalogHistory_Free(id);
 		InitializeInput(&Ext_AInputs[id]);
 	} else if (isInternalInput(id)) {
 		if (id == IN_COLD_JUNCTION) {
 			/* We don't want to allow removal of this, so we return immediately. */
 			return;
 		}
+		AnalogStatistics_Disable(id);
+		AnalogAlarm_Disable(id);
+		AnalogDeadband_Disable(id);
+		AnalogHistory_Free(id);
 		InitializeInput(&Int_AInputs[id - (NUM_EXT_ANALOG_INPUTS + NUM_CAL_ANALOG_INPUTS)]);
 	} else if (id == EXTERNAL_OFFSET_CAL) {
 		/* Do nothing, we don't want to remove this input. */
@@ -467,6 +593,11 @@ static void RemoveAnalogInputByID(uint8_t id) {
 void AnalogInputsInit(void) {
 	/* Initialize the input multiplexer */
 	InputMultiplexerInit();
+	/* No input has a history until it is added */
+	AnalogHistory_Init();
+	AnalogStatistics_Init();
+	AnalogAlarm_Init();
+	AnalogDeadband_Init();
 	uint_fast8_t i = 0;
 	for (; i < NUM_EXT_ANALOG_INPUTS; ++i) {
 		InitializeInput(&Ext_AInputs[i]);
@@ -484,11 +615,18 @@ void AnalogInputsInit(void) {
 	cold->rate = ADS1256_SPS_3750;
 	cold->gain = ADS1256_PGAx4;
 	strcpy(cold->name, "COLD JUNCTION");
-	cold->bufferReadIdx = 0U;
-	cold->bufferWriteIdx = 0U;
+	cold->historyDepth = ANALOG_HISTORY_DEFAULT_DEPTH;
+	cold->period = 0U;
 	cold->min = 0;
 	cold->max = 0;
 	AddAnalogInput(cold);
+
+	/* Samples read by the DMA engine are delivered the same way as those read by the DRDY handler */
+	ADS1256_DMA_SetCompleteCallback(AnalogSampleReady);
+
+	/* Start with no blocks pending */
+	AnalogBatch_Init();
+	AnalogTrigger_Init();
 }
 
 /**
@@ -596,6 +734,8 @@ Tekdaqc_Function_Error_t CreateAnalogInput(char keys[][MAX_COMMANDPART_LENGTH],
 	ADS1256_BUFFER_t buffer = ADS1256_BUFFER_ENABLED; /* The default buffer setting */
 	ADS1256_SPS_t rate = ADS1256_SPS_10; /* The default sample rate setting */
 	ADS1256_PGA_t gain = ADS1256_PGAx1; /* The default gain setting */
+	uint16_t depth = ANALOG_HISTORY_DEFAULT_DEPTH; /* The default history depth */
+	uint32_t period = 0U; /* By default sampled every pass of a scan */
 	char name[MAX_ANALOG_INPUT_NAME_LENGTH]; /* The name */
 	strcpy(name, "NONE");
 	uint_fast8_t i = 0U;
@@ -635,11 +775,31 @@ Tekdaqc_Function_Error_t CreateAnalogInput(char keys[][MAX_COMMANDPART_LENGTH],
 				case 4U: /* NAME key */
 					strcpy(name, param);
 					break;
+				case 5U: { /* DEPTH key */
+					char* testPtr = NULL;
+					long d = strtol(param, &testPtr, 10);
+					if ((testPtr == param) || !IS_ANALOG_HISTORY_DEPTH(d)) {
+						retval = ERR_AIN_PARSE_ERROR;
+					} else {
+						depth = (uint16_t) d;
+					}
+					break;
+				}
+				case 6U: { /* PERIOD key */
+					char* testPtr = NULL;
+					unsigned long p = strtoul(param, &testPtr, 10);
+					if ((testPtr == param) || (*testPtr != '\0')) {
+						retval = ERR_AIN_PARSE_ERROR;
+					} else {
+						period = (uint32_t) p;
+					}
+					break;
+				}
 				default:
 					retval = ERR_AIN_PARSE_ERROR;
 			}
-		} else if (i == 1U || i == 2U || i == 3U || i == 4U || i == 5U) {
-			/* The BUFFER, RATE, GAIN and NAME keys are not strictly required, leave the defaults */
+		} else if (i == 1U || i == 2U || i == 3U || i == 4U || i == 5U || i == 6U) {
+			/* The BUFFER, RATE, GAIN, NAME, DEPTH and PERIOD keys are not strictly required, leave the defaults */
 			continue;
 		} else {
 			/* Somehow an error happened */
@@ -662,8 +822,8 @@ Tekdaqc_Function_Error_t CreateAnalogInput(char keys[][MAX_COMMANDPART_LENGTH],
 					an_input->rate = rate;
 					an_input->gain = gain;
 					strcpy(an_input->name, name);
-					an_input->bufferReadIdx = 0U;
-					an_input->bufferWriteIdx = 0U;
+					an_input->historyDepth = depth;
+					an_input->period = period;
 					an_input->min = 0;
 					an_input->max = 0;
 					retval = AddAnalogInput(an_input);
@@ -691,6 +851,14 @@ Tekdaqc_Function_Error_t CreateAnalogInput(char keys[][MAX_COMMANDPART_LENGTH],
 Tekdaqc_Function_Error_t AddAnalogInput(Analog_Input_t* input) {
 	Tekdaqc_Function_Error_t retval = ERR_FUNCTION_OK;
 	PhysicalAnalogInput_t index = input->physicalInput;
+	if ((index < NUM_ANALOG_INPUTS) && (AnalogHistory_Allocate(index, input->historyDepth) == FALSE)) {
+		/* There is not enough room left in the history arena */
+#ifdef ANALOGINPUT_DEBUG
+		printf("[Analog Input] Unable to allocate a history of %" PRIu16 " samples, %" PRIu16 " free.\n\r",
+				input->historyDepth, AnalogHistory_GetFree());
+#endif
+		return ERR_AIN_HISTORY_FULL;
+	}
 	if (isExternalInput(index)) {
 		/* This is an external analog input */
 		input->externalInput = GetExternalMuxedInputByNumber(index);
@@ -804,8 +972,11 @@ Analog_Input_t* GetAnalogInputByNumber(uint8_t number) {
 void WriteAnalogInput(Analog_Input_t* input) {
 	uint8_t count = 0;
 	uint8_t retval;
+	uint64_t timestamp;
+	int32_t value;
 	if (writer != 0) {
-		while (count < SINGLE_ANALOG_WRITE_COUNT && input->bufferReadIdx != input->bufferWriteIdx) {
+		while (count < SINGLE_ANALOG_WRITE_COUNT
+				&& AnalogHistory_Read(input->physicalInput, &timestamp, &value) == TRUE) {
 			/* We have data to print */
 			if (count == 0) {
 				retval = snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, ANALOG_INPUT_HEADER, input->name,
@@ -819,9 +990,8 @@ void WriteAnalogInput(Analog_Input_t* input) {
 #endif
 				}
 			}
-			retval = snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, "%" PRIu64 ", %" PRIi32 "\x1F\n\r",
-					input->timestamps[input->bufferReadIdx], input->values[input->bufferReadIdx]);
-			input->bufferReadIdx = (input->bufferReadIdx + 1) % ANALOG_INPUT_BUFFER_SIZE;
+			retval = snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, "%" PRIu64 ", %" PRIi32 "\x1F\n\r", timestamp,
+					value);
 			if (retval >= 0) {
 				writer(TOSTRING_BUFFER);
 			} else {
@@ -0,0 +1,658 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_ScanList.c
+ * @brief Compiles the analog inputs being sampled into a dense scan table.
+ *
+ * When a read is requested, each added input is turned into a scan entry holding its external multiplexer word, the
+ * full ADC register image (input channels, buffer, PGA, data rate and calibration) and its settle time. The channel
+ * switch handler then steps through the table by index, and each hop costs a GPIO write and at most one register
+ * burst to the ADC.
+ *
+ * Every change of the external multiplexer leaves the relays settling for EXTERNAL_MUX_DELAY, which dominates large
+ * external scans. Internal inputs do not go through the relays, so the table is ordered with the internal inputs
+ * grouped in front of external inputs, and the relays are switched to the next external input while the group
+ * converts. The time spent on the group comes off the settling wait of that external input.
+ *
+ * When any input asks for a sample period the scan becomes multi-rate. Time is cut into frames as long as the
+ * shortest period, and each input is sampled once every power of two frames, rounded so that it is never sampled
+ * less often than it asked. Inputs are placed fastest first (rate monotonic), each in the phase whose busiest frame
+ * has the most time left. Every hop is budgeted its full conversion and relay settling time, so a schedule which fits
+ * will not overrun a frame whatever order the relays end up in. A frame is not started before its time, so the fast
+ * inputs are sampled at a steady rate rather than as fast as the ADC allows.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_ScanList.h"
+#include "AnalogInput_Multiplexer.h"
+#include "Tekdaqc_CalibrationTable.h"
+#include "Tekdaqc_BSP.h"
+#include "Tekdaqc_Timers.h"
+#include <string.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#include <inttypes.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The compiled scan table */
+static AnalogScan_Entry_t scanList[NUM_ANALOG_INPUTS];
+
+/* The number of entries in the scan table */
+static uint8_t scanCount = 0U;
+
+/* The entry used for the interleaved cold junction reads */
+static AnalogScan_Entry_t coldJunctionEntry;
+
+/* Set when the ADC registers may not match the driver's copy, forcing the next load to write them all */
+static bool forceLoad = TRUE;
+
+/* Set while the external multiplexer is known to hold relayWord */
+static bool relayKnown = FALSE;
+
+/* The external multiplexer word last written */
+static uint16_t relayWord = 0U;
+
+/* The time relayWord was written, in microseconds */
+static uint64_t relaySwitchTime = 0U;
+
+/* The number of relay changes made by each pass of the scan table */
+static uint8_t relayHops = 0U;
+
+/* The predicted time taken by each pass of the scan table, in microseconds */
+static uint32_t predictedPeriod = 0U;
+
+/* The length of a frame of a multi-rate scan in microseconds, 0 if every entry is sampled every pass */
+static uint32_t framePeriod = 0U;
+
+/* The number of frames started since the scan was rewound */
+static uint32_t scanFrame = 0U;
+
+/* Set when a new frame has been moved into but has not yet started */
+static bool framePending = FALSE;
+
+/* The time the pending frame may start, in microseconds */
+static uint64_t frameStart = 0U;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Fills in a scan entry for an input.
+ */
+static bool AnalogScan_BuildEntry(AnalogScan_Entry_t* entry, Analog_Input_t* input);
+
+/**
+ * @internal
+ * @brief Orders the scan table so that internal inputs overlap the relay settling of external inputs.
+ */
+static void AnalogScan_Plan(void);
+
+/**
+ * @internal
+ * @brief Points each entry at the external entry whose relays it should hold.
+ */
+static void AnalogScan_LinkRelays(void);
+
+/**
+ * @internal
+ * @brief Works out the relay hops and time taken by a pass of the scan table.
+ */
+static void AnalogScan_Predict(void);
+
+/**
+ * @internal
+ * @brief Places each entry of a multi-rate scan in the frames it is sampled in.
+ */
+static Tekdaqc_Function_Error_t AnalogScan_Schedule(void);
+
+/**
+ * @internal
+ * @brief Finds the next entry of the schedule.
+ */
+static uint8_t AnalogScan_Find(uint8_t index, uint32_t* frame);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Fills in a scan entry for an input, looking up its multiplexer settings and calibration values.
+ *
+ * @param entry AnalogScan_Entry_t* The entry to fill in.
+ * @param input Analog_Input_t* The input to build the entry for.
+ * @retval bool TRUE if the input can be scanned, FALSE if it is not an external or internal input.
+ */
+static bool AnalogScan_BuildEntry(AnalogScan_Entry_t* entry, Analog_Input_t* input) {
+	ADS1256_AIN_t pos;
+	ADS1256_AIN_t neg;
+	uint32_t offset_cal;
+	uint32_t gain_cal;
+	if (isExternalInput(input->physicalInput)) {
+		entry->external = TRUE;
+		entry->muxWord = (uint16_t) input->externalInput;
+		entry->settleTime = ANALOG_SCAN_MUX_SETTLE_TIME;
+		pos = EXTERNAL_ANALOG_IN_AINP;
+		neg = EXTERNAL_ANALOG_IN_AINN;
+	} else if (isInternalInput(input->physicalInput)
+			&& GetInternalInputChannels(input->internalInput, &pos, &neg)) {
+		/* Internal inputs are switched by the ADC's own multiplexer, which the SYNC takes care of */
+		entry->external = FALSE;
+		entry->muxWord = 0U;
+		entry->settleTime = 0U;
+	} else {
+#ifdef ANALOG_SCAN_DEBUG
+		printf("[Analog Scan] Input %i can not be scanned.\n\r", input->physicalInput);
+#endif
+		return FALSE;
+	}
+	if (input->physicalInput == IN_COLD_JUNCTION) {
+		offset_cal = Tekdaqc_GetColdJunctionOffsetCalibration();
+		gain_cal = Tekdaqc_GetColdJunctionGainCalibration();
+	} else {
+		offset_cal = Tekdaqc_GetOffsetCalibration(input->rate, input->gain, input->buffer);
+		gain_cal = Tekdaqc_GetGainCalibration(input->rate, input->gain, input->buffer);
+	}
+	entry->input = input;
+	entry->physicalInput = input->physicalInput;
+	entry->convertTime = ADS1256_GetSettlingTimeForRate(input->rate);
+	entry->relay = (entry->external == TRUE) ? entry : NULL;
+	entry->frameMask = 0U;
+	entry->framePhase = 0U;
+	ADS1256_BuildRegisterImage(entry->registers, pos, neg, input->buffer, input->gain, input->rate, offset_cal,
+			gain_cal);
+	return TRUE;
+}
+
+/**
+ * Orders the scan table so that internal inputs overlap the relay settling of external inputs. Each external input
+ * has a settling window in front of it, and the internal inputs are dealt out, longest conversion first, to whichever
+ * window has the most time left to hide. Each window's group is placed right before its external input, with the
+ * external inputs keeping their requested order. A table without external inputs is left as requested.
+ *
+ * @param none
+ * @retval none
+ */
+static void AnalogScan_Plan(void) {
+	uint8_t internals[NUM_ANALOG_INPUTS];
+	uint8_t externals[NUM_ANALOG_INPUTS];
+	uint8_t window[NUM_ANALOG_INPUTS];
+	uint32_t fill[NUM_ANALOG_INPUTS];
+	uint8_t order[NUM_ANALOG_INPUTS];
+	uint8_t position[NUM_ANALOG_INPUTS];
+	uint8_t occupant[NUM_ANALOG_INPUTS];
+	uint8_t numInternal = 0U;
+	uint8_t numExternal = 0U;
+	uint8_t numOrdered = 0U;
+	uint_fast8_t i;
+	uint_fast8_t j;
+	for (i = 0U; i < scanCount; ++i) {
+		if (scanList[i].external == TRUE) {
+			fill[numExternal] = 0U;
+			externals[numExternal++] = i;
+		} else {
+			/* Insert longest conversion first, keeping the requested order among equals */
+			for (j = numInternal; (j > 0U) && (scanList[internals[j - 1U]].convertTime < scanList[i].convertTime); --j) {
+				internals[j] = internals[j - 1U];
+			}
+			internals[j] = i;
+			++numInternal;
+		}
+	}
+	if ((numExternal == 0U) || (numInternal == 0U)) {
+		return;
+	}
+	for (i = 0U; i < numInternal; ++i) {
+		uint_fast8_t best = 0U;
+		for (j = 1U; j < numExternal; ++j) {
+			if (fill[j] < fill[best]) {
+				best = j;
+			}
+		}
+		window[i] = best;
+		fill[best] += scanList[internals[i]].convertTime;
+	}
+	for (j = 0U; j < numExternal; ++j) {
+		for (i = 0U; i < numInternal; ++i) {
+			if (window[i] == j) {
+				order[numOrdered++] = internals[i];
+			}
+		}
+		order[numOrdered++] = externals[j];
+	}
+	/* Move the entries into place, tracking where each one has been swapped to */
+	for (i = 0U; i < scanCount; ++i) {
+		position[i] = i;
+		occupant[i] = i;
+	}
+	for (i = 0U; i < scanCount; ++i) {
+		uint8_t from = position[order[i]];
+		if (from != i) {
+			AnalogScan_Entry_t temp = scanList[i];
+			scanList[i] = scanList[from];
+			scanList[from] = temp;
+			position[occupant[i]] = from;
+			occupant[from] = occupant[i];
+			position[order[i]] = i;
+			occupant[i] = order[i];
+		}
+	}
+}
+
+/**
+ * Points each entry at the external entry whose relays it should hold while it samples. External entries hold their
+ * own, and internal entries hold the next external entry of the scan so that its relays settle in the meantime.
+ *
+ * @param none
+ * @retval none
+ */
+static void AnalogScan_LinkRelays(void) {
+	const AnalogScan_Entry_t* next = NULL;
+	/* Walk backwards twice so that entries at the end of the table see the externals at the start */
+	for (int_fast16_t i = (2 * (int_fast16_t) scanCount) - 1; i >= 0; --i) {
+		AnalogScan_Entry_t* entry = &scanList[i % scanCount];
+		if (entry->external == TRUE) {
+			entry->relay = entry;
+			next = entry;
+		} else {
+			entry->relay = next;
+		}
+	}
+}
+
+/**
+ * Works out the relay hops and time taken by a steady state pass of the scan table, taking one sample per entry.
+ * This follows the same rules as AnalogScan_Select() but leaves out the SPI traffic and the interleaved cold
+ * junction reads.
+ *
+ * @param none
+ * @retval none
+ */
+static void AnalogScan_Predict(void) {
+	uint32_t time = 0U;
+	uint32_t ready = 0U;
+	uint16_t word = 0U;
+	relayHops = 0U;
+	/* In the steady state the relays still hold the last external entry of the previous pass */
+	for (uint_fast8_t i = 0U; i < scanCount; ++i) {
+		if (scanList[i].external == TRUE) {
+			word = scanList[i].muxWord;
+		}
+	}
+	for (uint_fast8_t i = 0U; i < scanCount; ++i) {
+		const AnalogScan_Entry_t* relay = scanList[i].relay;
+		if ((relay != NULL) && (relay->muxWord != word)) {
+			word = relay->muxWord;
+			ready = time + relay->settleTime;
+			++relayHops;
+		}
+		if ((scanList[i].external == TRUE) && (ready > time)) {
+			time = ready;
+		}
+		time += scanList[i].convertTime;
+	}
+	predictedPeriod = time;
+}
+
+/**
+ * Places each entry of a multi-rate scan in the frames it is sampled in. The frame is as long as the shortest
+ * requested period, and inputs without a period are sampled every frame. Entries are placed fastest first, each in
+ * the phase whose busiest frame is the least loaded, and every hop is budgeted its conversion, relay settling and
+ * ANALOG_SCAN_HOP_OVERHEAD. A scan without any periods is left to sample every entry every pass.
+ *
+ * @param none
+ * @retval Tekdaqc_Function_Error_t ERR_AIN_SCAN_INFEASIBLE if some frame can not fit its entries.
+ */
+static Tekdaqc_Function_Error_t AnalogScan_Schedule(void) {
+	uint32_t load[ANALOG_SCAN_MAX_FRAMES];
+	uint32_t cost[NUM_ANALOG_INPUTS];
+	uint8_t order[NUM_ANALOG_INPUTS];
+	uint32_t frames = 1U;
+	uint_fast8_t i;
+	uint_fast8_t j;
+	framePeriod = 0U;
+	for (i = 0U; i < scanCount; ++i) {
+		uint32_t period = scanList[i].input->period;
+		if ((period != 0U) && ((framePeriod == 0U) || (period < framePeriod))) {
+			framePeriod = period;
+		}
+	}
+	if (framePeriod == 0U) {
+		return ERR_FUNCTION_OK;
+	}
+	for (i = 0U; i < scanCount; ++i) {
+		/* The largest power of two number of frames which is no longer than the period */
+		uint32_t ratio = scanList[i].input->period / framePeriod;
+		uint32_t multiple = 1U;
+		while (multiple <= (ratio / 2U)) {
+			multiple <<= 1;
+		}
+		scanList[i].frameMask = multiple - 1U;
+		cost[i] = scanList[i].convertTime + scanList[i].settleTime + ANALOG_SCAN_HOP_OVERHEAD;
+		if (multiple > frames) {
+			frames = multiple;
+		}
+		/* Insert fastest first, keeping the table order among equals */
+		for (j = i; (j > 0U) && (scanList[order[j - 1U]].frameMask > scanList[i].frameMask); --j) {
+			order[j] = order[j - 1U];
+		}
+		order[j] = i;
+	}
+	if (frames > ANALOG_SCAN_MAX_FRAMES) {
+		frames = ANALOG_SCAN_MAX_FRAMES;
+	}
+	memset(load, 0, sizeof(load));
+	for (i = 0U; i < scanCount; ++i) {
+		AnalogScan_Entry_t* entry = &scanList[order[i]];
+		uint32_t span = ((entry->frameMask + 1U) < frames) ? (entry->frameMask + 1U) : frames;
+		uint32_t best = 0U;
+		uint32_t bestLoad = UINT32_MAX;
+		uint32_t f;
+		for (uint32_t phase = 0U; phase < span; ++phase) {
+			uint32_t worst = 0U;
+			for (f = phase; f < frames; f += span) {
+				if (load[f] > worst) {
+					worst = load[f];
+				}
+			}
+			if (worst < bestLoad) {
+				bestLoad = worst;
+				best = phase;
+			}
+		}
+		if ((bestLoad + cost[order[i]]) > framePeriod) {
+#ifdef ANALOG_SCAN_DEBUG
+			printf("[Analog Scan] Input %i does not fit a %" PRIu32 " us frame, %" PRIu32 " us already used.\n\r",
+					entry->physicalInput, framePeriod, bestLoad);
+#endif
+			framePeriod = 0U;
+			return ERR_AIN_SCAN_INFEASIBLE;
+		}
+		entry->framePhase = best;
+		for (f = best; f < frames; f += span) {
+			load[f] += cost[order[i]];
+		}
+	}
+	return ERR_FUNCTION_OK;
+}
+
+/**
+ * Finds the entry of the schedule after an entry, moving into the following frame when the end of the table is
+ * reached. Every frame holds at least the fastest entries, so this always finds one.
+ *
+ * @param index uint8_t The index of the current entry.
+ * @param frame uint32_t* The frame of the current entry, updated to the frame of the entry found.
+ * @retval uint8_t The index of the next entry.
+ */
+static uint8_t AnalogScan_Find(uint8_t index, uint32_t* frame) {
+	uint_fast8_t i = index;
+	do {
+		if (++i >= scanCount) {
+			i = 0U;
+			++(*frame);
+		}
+	} while ((*frame & scanList[i].frameMask) != scanList[i].framePhase);
+	return (uint8_t) i;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Empties the scan list.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogScan_Clear(void) {
+	scanCount = 0U;
+}
+
+/**
+ * Compiles the added inputs of a list into the scan list, in list order. The cold junction entry is rebuilt at the
+ * same time so that its calibration matches the rest of the scan. If the inputs have sample periods which can not
+ * all be met, the scan list is left empty.
+ *
+ * @param inputs Analog_Input_t*[] The list of inputs. NULL and not added entries are skipped.
+ * @param count uint8_t The length of the list.
+ * @retval Tekdaqc_Function_Error_t The error status of the compile.
+ */
+Tekdaqc_Function_Error_t AnalogScan_Compile(Analog_Input_t* inputs[], uint8_t count) {
+	Tekdaqc_Function_Error_t retval;
+	scanCount = 0U;
+	for (uint_fast8_t i = 0U; (i < count) && (scanCount < NUM_ANALOG_INPUTS); ++i) {
+		if ((inputs[i] != NULL) && (inputs[i]->added == CHANNEL_ADDED)) {
+			if (AnalogScan_BuildEntry(&scanList[scanCount], inputs[i]) == TRUE) {
+				++scanCount;
+			}
+		}
+	}
+	AnalogScan_Plan();
+	AnalogScan_LinkRelays();
+	AnalogScan_Predict();
+	retval = AnalogScan_Schedule();
+	if (retval != ERR_FUNCTION_OK) {
+		scanCount = 0U;
+	}
+	AnalogScan_BuildEntry(&coldJunctionEntry, GetAnalogInputByNumber(IN_COLD_JUNCTION));
+	/* Calibrations and resets write the ADC and multiplexer behind our back, so start the new scan from scratch */
+	forceLoad = TRUE;
+	relayKnown = FALSE;
+#ifdef ANALOG_SCAN_DEBUG
+	printf("[Analog Scan] Compiled %i inputs, %i relay hops, %" PRIu32 " us per pass, %" PRIu32 " us frames.\n\r",
+			scanCount, relayHops, predictedPeriod, framePeriod);
+#endif
+	return retval;
+}
+
+/**
+ * Retrieves the number of entries in the scan list.
+ *
+ * @param none
+ * @retval uint8_t The number of entries.
+ */
+uint8_t AnalogScan_GetCount(void) {
+	return scanCount;
+}
+
+/**
+ * Retrieves an entry of the scan list.
+ *
+ * @param index uint8_t The index of the entry, which must be less than AnalogScan_GetCount().
+ * @retval const AnalogScan_Entry_t* The entry.
+ */
+const AnalogScan_Entry_t* AnalogScan_GetEntry(uint8_t index) {
+	return &scanList[index];
+}
+
+/**
+ * Retrieves the entry used for cold junction reads interleaved with the scan.
+ *
+ * @param none
+ * @retval const AnalogScan_Entry_t* The cold junction entry.
+ */
+const AnalogScan_Entry_t* AnalogScan_GetColdJunction(void) {
+	return &coldJunctionEntry;
+}
+
+/**
+ * Retrieves the number of external multiplexer changes made by each pass of the scan list.
+ *
+ * @param none
+ * @retval uint8_t The number of relay hops.
+ */
+uint8_t AnalogScan_GetRelayHops(void) {
+	return relayHops;
+}
+
+/**
+ * Retrieves the predicted time taken by each pass of the scan list, taking one sample of every entry. SPI traffic and
+ * interleaved cold junction reads are not included.
+ *
+ * @param none
+ * @retval uint32_t The predicted period in microseconds.
+ */
+uint32_t AnalogScan_GetPredictedPeriod(void) {
+	return predictedPeriod;
+}
+
+/**
+ * Retrieves the length of a frame of a multi-rate scan.
+ *
+ * @param none
+ * @retval uint32_t The frame period in microseconds, 0 if every entry is sampled every pass.
+ */
+uint32_t AnalogScan_GetFramePeriod(void) {
+	return framePeriod;
+}
+
+/**
+ * Retrieves the number of frames started since the scan was rewound. A scan which is not multi-rate has one frame per
+ * pass of the scan list.
+ *
+ * @param none
+ * @retval uint32_t The frame count.
+ */
+uint32_t AnalogScan_GetFrame(void) {
+	return scanFrame;
+}
+
+/**
+ * Starts the schedule over from its first frame, which may start right away.
+ *
+ * @param now uint64_t The current time, in microseconds.
+ * @retval uint8_t The index of the first entry to sample.
+ */
+uint8_t AnalogScan_Rewind(uint64_t now) {
+	scanFrame = 0U;
+	framePending = TRUE;
+	frameStart = now;
+	if ((scanCount == 0U) || (scanList[0].framePhase == 0U)) {
+		return 0U;
+	}
+	return AnalogScan_Find(0U, &scanFrame);
+}
+
+/**
+ * Moves on to the entry of the schedule after an entry. Moving into a new frame leaves it pending until
+ * AnalogScan_Pace() starts it.
+ *
+ * @param index uint8_t The index of the entry just sampled.
+ * @retval uint8_t The index of the next entry to sample.
+ */
+uint8_t AnalogScan_Advance(uint8_t index) {
+	uint32_t frame = scanFrame;
+	if (scanCount == 0U) {
+		return 0U;
+	}
+	index = AnalogScan_Find(index, &frame);
+	if (frame != scanFrame) {
+		scanFrame = frame;
+		framePending = TRUE;
+	}
+	return index;
+}
+
+/**
+ * Retrieves the entry of the schedule after an entry, without moving on.
+ *
+ * @param index uint8_t The index of the current entry.
+ * @retval uint8_t The index of the entry which will be sampled after it.
+ */
+uint8_t AnalogScan_Peek(uint8_t index) {
+	uint32_t frame = scanFrame;
+	return (scanCount == 0U) ? 0U : AnalogScan_Find(index, &frame);
+}
+
+/**
+ * Retrieves the time left before the frame of the current entry may start. Only the first entry of a frame of a
+ * multi-rate scan ever waits. A frame which starts more than a frame late, as after a long cold junction read, sets
+ * the timing of the following frames instead of being caught up on.
+ *
+ * @param now uint64_t The current time, in microseconds.
+ * @retval uint32_t The time to wait in microseconds, 0 if the entry can be sampled now.
+ */
+uint32_t AnalogScan_Pace(uint64_t now) {
+	if ((framePeriod == 0U) || (framePending == FALSE)) {
+		return 0U;
+	}
+	if (now < frameStart) {
+		return (uint32_t) (frameStart - now);
+	}
+	frameStart = ((now - frameStart) >= framePeriod) ? (now + framePeriod) : (frameStart + framePeriod);
+	framePending = FALSE;
+	return 0U;
+}
+
+/**
+ * Switches the external multiplexer for an entry. External entries need their own input on the relays. Internal
+ * entries are selected by the ADC register image, so the relays are switched ahead to the input the entry sampled
+ * next will need instead. The relays are only written when they change.
+ *
+ * @param entry const AnalogScan_Entry_t* The entry to select.
+ * @param next const AnalogScan_Entry_t* The entry which will be sampled after this one. Internal entries switch the
+ * relays ahead for it, which in a multi-rate scan may not be the external entry following them in the table. May be
+ * NULL, in which case the entry's own relay link is used.
+ * @retval uint32_t The time left, in microseconds, before the relays have settled and the entry can be sampled.
+ */
+uint32_t AnalogScan_Select(const AnalogScan_Entry_t* entry, const AnalogScan_Entry_t* next) {
+	const AnalogScan_Entry_t* relay = entry->relay;
+	uint64_t now = GetLocalTime();
+	uint64_t elapsed;
+	if ((entry->external == FALSE) && (next != NULL)) {
+		relay = next->relay;
+	}
+	if ((relay != NULL) && ((relayKnown == FALSE) || (relayWord != relay->muxWord))) {
+		GPIO_WriteBit(OCAL_CONTROL_GPIO_PORT, OCAL_CONTROL_PIN, EXT_ANALOG_SELECT);
+		GPIO_Write(EXT_ANALOG_IN_MUX_PORT,
+				(relay->muxWord | (GPIO_ReadOutputData(EXT_ANALOG_IN_MUX_PORT) & EXT_ANALOG_IN_BITMASK)));
+		relayKnown = TRUE;
+		relayWord = relay->muxWord;
+		relaySwitchTime = now;
+	}
+	if (entry->external == FALSE) {
+		return 0U;
+	}
+	/* If the clock was set backwards, fall back on the full settle time */
+	elapsed = (now >= relaySwitchTime) ? (now - relaySwitchTime) : 0U;
+	return (elapsed >= entry->settleTime) ? 0U : (uint32_t) (entry->settleTime - elapsed);
+}
+
+/**
+ * Loads the register image of an entry into the ADC and starts a conversion. Only the registers which differ from
+ * the previous hop are written, in a single burst.
+ *
+ * @param entry const AnalogScan_Entry_t* The entry to start sampling.
+ * @retval none
+ */
+void AnalogScan_Start(const AnalogScan_Entry_t* entry) {
+	ADS1256_LoadRegisterImage(entry->registers, forceLoad);
+	forceLoad = FALSE;
+	ADS1256_Sync(true);
+	ADS1256_Wakeup(); /* Start Sampling */
+}
@@ -0,0 +1,408 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Statistics.c
+ * @brief Source file for the analog input statistics engine.
+ *
+ * The main loop hands every corrected sample to AnalogStatistics_Record(). Samples are accumulated with Welford's
+ * algorithm, which keeps a running mean and sum of squared deviations instead of raw sums, so single precision is
+ * enough even for long windows of 24 bit readings. The samples are also shifted by the first sample of the window
+ * before being accumulated, which keeps the running values small when the input sits far from zero.
+ *
+ * A tumbling window is accumulated one sample at a time and reported as soon as it is complete. A sliding window is
+ * recomputed at each step from the samples kept in the input's history, so it never has to remove samples from a
+ * running total and can not drift. The history must be deep enough to hold the window.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_Statistics.h"
+#include "Analog_History.h"
+#include "Tekdaqc_BSP.h"
+#include "Tekdaqc_Config.h"
+#include "Tekdaqc_DataFrame.h"
+#include "Tekdaqc_Memory.h"
+#include "TelnetServer.h"
+#include "Data_Output.h"
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Running statistics of a window.
+ */
+typedef struct {
+	uint32_t count; /**< The number of samples accumulated. */
+	int32_t shift; /**< The first sample, subtracted from every sample before it is accumulated. */
+	float mean; /**< The running mean of the shifted samples. */
+	float m2; /**< The running sum of squared deviations from the mean. */
+	int32_t min; /**< The smallest sample. */
+	int32_t max; /**< The largest sample. */
+	uint64_t start; /**< The time of the earliest sample. */
+	uint64_t end; /**< The time of the latest sample. */
+} AnalogStatistics_Accumulator_t;
+
+/**
+ * @internal
+ * @brief Statistics state of an input.
+ */
+typedef struct {
+	AnalogStatistics_Config_t config; /**< The configuration. */
+	AnalogStatistics_Accumulator_t window; /**< The tumbling window being filled. */
+	uint32_t sinceReport; /**< Samples since a sliding window was last reported. */
+	uint64_t lastReport; /**< The time a sliding window was last reported. */
+	bool reported; /**< If a sliding window has been reported since the statistics were restarted. */
+} AnalogStatistics_Channel_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The statistics state of each physical input */
+static AnalogStatistics_Channel_t channels[NUM_ANALOG_INPUTS] CCM_BSS;
+
+/* The frame buffer used for binary reports */
+static uint8_t frame[DATA_FRAME_STATISTICS_SIZE];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * Empties an accumulator.
+ *
+ * @param acc AnalogStatistics_Accumulator_t* The accumulator.
+ * @retval none
+ */
+static void Accumulator_Reset(AnalogStatistics_Accumulator_t* acc) {
+	memset(acc, 0, sizeof(AnalogStatistics_Accumulator_t));
+}
+
+/**
+ * @internal
+ * Adds a sample to an accumulator using Welford's update.
+ *
+ * @param acc AnalogStatistics_Accumulator_t* The accumulator.
+ * @param timestamp uint64_t The time the sample was taken.
+ * @param value int32_t The sample value.
+ * @retval none
+ */
+static void Accumulator_Add(AnalogStatistics_Accumulator_t* acc, uint64_t timestamp, int32_t value) {
+	if (acc->count == 0U) {
+		acc->shift = value;
+		acc->min = value;
+		acc->max = value;
+		acc->start = timestamp;
+		acc->end = timestamp;
+	}
+	float x = (float) ((int64_t) value - acc->shift);
+	float delta = x - acc->mean;
+	++acc->count;
+	acc->mean += delta / (float) acc->count;
+	acc->m2 += delta * (x - acc->mean);
+	if (value < acc->min) {
+		acc->min = value;
+	} else if (value > acc->max) {
+		acc->max = value;
+	}
+	if (timestamp < acc->start) {
+		acc->start = timestamp;
+	} else if (timestamp > acc->end) {
+		acc->end = timestamp;
+	}
+}
+
+/**
+ * @internal
+ * Writes the statistics of a window to the data connection in the current output format. The accumulator holds the
+ * shifted samples in single precision, which is cheap per sample, but the shift is put back and the RMS taken in
+ * double precision: in single precision a mean of several million codes has no fractional digits left, and the
+ * variance vanishes against the square of the mean. The ASCII report gives the mean and RMS to a tenth of a code and
+ * the standard deviation to a hundredth, which is as far as the sample codes carry.
+ *
+ * @param channel uint8_t The physical input.
+ * @param acc const AnalogStatistics_Accumulator_t* The accumulated window. Must not be empty.
+ * @retval none
+ */
+static void WriteStatistics(uint8_t channel, const AnalogStatistics_Accumulator_t* acc) {
+	DataFrame_Statistics_t statistics;
+	double variance = (double) acc->m2 / (double) acc->count;
+	double mean = (double) acc->shift + (double) acc->mean;
+	double rms = sqrt((mean * mean) + variance);
+	double stddev = (acc->count > 1U) ? sqrt((double) acc->m2 / (double) (acc->count - 1U)) : 0.0;
+	statistics.start = acc->start;
+	statistics.end = acc->end;
+	statistics.count = acc->count;
+	statistics.min = acc->min;
+	statistics.max = acc->max;
+	statistics.mean = (float) mean;
+	statistics.rms = (float) rms;
+	statistics.stddev = (float) stddev;
+	if (DataOutput_GetFormat() == TELNET_FORMAT_BINARY) {
+		DataOutput_WriteBuffer(frame, DataFrame_EncodeAnalogStatistics(frame, channel, &statistics));
+	} else {
+		snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER,
+				"?S%" PRIu8 "\r\n%" PRIu64 ",%" PRIu64 ",%" PRIu32 ",%.1f,%" PRIi32 ",%" PRIi32 ",%.1f,%.2f%c\r\n",
+				channel, statistics.start, statistics.end, statistics.count, mean, statistics.min, statistics.max, rms,
+				stddev, 0x1e);
+		TelnetWriteString(TOSTRING_BUFFER);
+	}
+}
+
+/**
+ * @internal
+ * Computes and writes out a sliding window ending at the latest sample in the input's history.
+ *
+ * @param channel uint8_t The physical input.
+ * @param config const AnalogStatistics_Config_t* The statistics configuration of the input.
+ * @retval none
+ */
+static void WriteSlidingWindow(uint8_t channel, const AnalogStatistics_Config_t* config) {
+	AnalogStatistics_Accumulator_t acc;
+	AnalogHistory_Iterator_t iterator;
+	uint64_t timestamp;
+	uint64_t newest = 0U;
+	int32_t value;
+	Accumulator_Reset(&acc);
+	if (config->basis == STATISTICS_BASIS_COUNT) {
+		AnalogHistory_Begin(&iterator, channel, (uint16_t) config->size);
+	} else {
+		AnalogHistory_Begin(&iterator, channel, AnalogHistory_GetDepth(channel));
+	}
+	while (AnalogHistory_Next(&iterator, &timestamp, &value) == TRUE) {
+		if (acc.count == 0U) {
+			newest = timestamp;
+		} else if ((config->basis == STATISTICS_BASIS_TIME) && ((newest - timestamp) >= config->size)) {
+			/* Older than the window */
+			break;
+		}
+		Accumulator_Add(&acc, timestamp, value);
+	}
+	if (acc.count > 0U) {
+		WriteStatistics(channel, &acc);
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Turns off the statistics of every input.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogStatistics_Init(void) {
+	for (uint_fast8_t i = 0U; i < NUM_ANALOG_INPUTS; ++i) {
+		AnalogStatistics_Disable(i);
+	}
+}
+
+/**
+ * Sets the statistics configuration of an input, discarding any partially filled window. A sliding window measured
+ * in samples must fit in the input's history, and a sliding window measured in time needs the input to have a history.
+ *
+ * @param channel uint8_t The physical input.
+ * @param config const AnalogStatistics_Config_t* The new configuration.
+ * @retval bool TRUE if the configuration was applied.
+ */
+bool AnalogStatistics_Configure(uint8_t channel, const AnalogStatistics_Config_t* config) {
+	if (channel >= NUM_ANALOG_INPUTS) {
+		return FALSE;
+	}
+	if (config->window != STATISTICS_WINDOW_NONE) {
+		if (config->size == 0U) {
+			return FALSE;
+		}
+		if (config->window == STATISTICS_WINDOW_SLIDING) {
+			uint16_t depth = AnalogHistory_GetDepth(channel);
+			if ((config->step == 0U) || (depth == 0U)
+					|| ((config->basis == STATISTICS_BASIS_COUNT) && (config->size > depth))) {
+#ifdef ANALOG_STATISTICS_DEBUG
+				printf("[Analog Statistics] Input %" PRIu8 " has a history of %" PRIu16 " samples.\n\r", channel,
+						depth);
+#endif
+				return FALSE;
+			}
+		}
+	}
+	channels[channel].config = *config;
+	Accumulator_Reset(&channels[channel].window);
+	channels[channel].sinceReport = 0U;
+	channels[channel].reported = FALSE;
+	return TRUE;
+}
+
+/**
+ * Retrieves the statistics configuration of an input.
+ *
+ * @param channel uint8_t The physical input.
+ * @param config AnalogStatistics_Config_t* The structure to fill.
+ * @retval none
+ */
+void AnalogStatistics_GetConfig(uint8_t channel, AnalogStatistics_Config_t* config) {
+	if (channel < NUM_ANALOG_INPUTS) {
+		*config = channels[channel].config;
+	}
+}
+
+/**
+ * Turns off the statistics of an input, so every sample is written out again.
+ *
+ * @param channel uint8_t The physical input.
+ * @retval none
+ */
+void AnalogStatistics_Disable(uint8_t channel) {
+	if (channel < NUM_ANALOG_INPUTS) {
+		memset(&channels[channel], 0, sizeof(AnalogStatistics_Channel_t));
+		channels[channel].config.window = STATISTICS_WINDOW_NONE;
+		channels[channel].config.basis = STATISTICS_BASIS_COUNT;
+		channels[channel].config.report = STATISTICS_REPORT_ALL;
+	}
+}
+
+/**
+ * Discards any partially filled windows, so no window spans a gap in sampling. Called when a scan is started.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogStatistics_Restart(void) {
+	for (uint_fast8_t i = 0U; i < NUM_ANALOG_INPUTS; ++i) {
+		Accumulator_Reset(&channels[i].window);
+		channels[i].sinceReport = 0U;
+		channels[i].reported = FALSE;
+	}
+}
+
+/**
+ * Adds a sample to the statistics of its input and writes out any window it completes. For a sliding window the
+ * sample must already have been recorded in the input's history.
+ *
+ * @param channel uint8_t The physical input.
+ * @param timestamp uint64_t The time the sample was taken, in microseconds.
+ * @param value int32_t The corrected sample value.
+ * @retval bool TRUE if the sample itself should also be written out.
+ */
+bool AnalogStatistics_Record(uint8_t channel, uint64_t timestamp, int32_t value) {
+	if (channel >= NUM_ANALOG_INPUTS) {
+		return TRUE;
+	}
+	AnalogStatistics_Channel_t* state = &channels[channel];
+	const AnalogStatistics_Config_t* config = &state->config;
+	switch (config->window) {
+	case STATISTICS_WINDOW_TUMBLING:
+		if ((config->basis == STATISTICS_BASIS_TIME) && (state->window.count > 0U)
+				&& ((timestamp - state->window.start) >= config->size)) {
+			/* This sample begins the next window */
+			WriteStatistics(channel, &state->window);
+			Accumulator_Reset(&state->window);
+		}
+		Accumulator_Add(&state->window, timestamp, value);
+		if ((config->basis == STATISTICS_BASIS_COUNT) && (state->window.count >= config->size)) {
+			WriteStatistics(channel, &state->window);
+			Accumulator_Reset(&state->window);
+		}
+		break;
+	case STATISTICS_WINDOW_SLIDING:
+		if (config->basis == STATISTICS_BASIS_COUNT) {
+			if (++state->sinceReport >= config->step) {
+				state->sinceReport = 0U;
+				WriteSlidingWindow(channel, config);
+			}
+		} else if (state->reported == FALSE) {
+			/* Steps are timed from the first sample */
+			state->reported = TRUE;
+			state->lastReport = timestamp;
+		} else if ((timestamp - state->lastReport) >= config->step) {
+			state->lastReport = timestamp;
+			WriteSlidingWindow(channel, config);
+		}
+		break;
+	case STATISTICS_WINDOW_NONE:
+	default:
+		return TRUE;
+	}
+	return (config->report == STATISTICS_REPORT_ALL) ? TRUE : FALSE;
+}
+
+/**
+ * Converts a window type into a human readable string.
+ *
+ * @param window AnalogStatistics_Window_t The window type.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogStatistics_WindowToString(AnalogStatistics_Window_t window) {
+	switch (window) {
+	case STATISTICS_WINDOW_NONE:
+		return "NONE";
+	case STATISTICS_WINDOW_TUMBLING:
+		return "TUMBLING";
+	case STATISTICS_WINDOW_SLIDING:
+		return "SLIDING";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+/**
+ * Converts a window basis into a human readable string.
+ *
+ * @param basis AnalogStatistics_Basis_t The window basis.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogStatistics_BasisToString(AnalogStatistics_Basis_t basis) {
+	switch (basis) {
+	case STATISTICS_BASIS_COUNT:
+		return "COUNT";
+	case STATISTICS_BASIS_TIME:
+		return "TIME";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+/**
+ * Converts a report mode into a human readable string.
+ *
+ * @param report AnalogStatistics_Report_t The report mode.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogStatistics_ReportToString(AnalogStatistics_Report_t report) {
+	switch (report) {
+	case STATISTICS_REPORT_ALL:
+		return "ALL";
+	case STATISTICS_REPORT_AGGREGATE:
+		return "AGGREGATE";
+	default:
+		return "UNKNOWN";
+	}
+}
@@ -0,0 +1,453 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Analog_Trigger.c
+ * @brief Source file for the analog trigger engine.
+ *
+ * While the trigger is armed, the main loop hands every sample drained from the analog sample buffer to
+ * AnalogTrigger_Record() instead of writing it out. The samples have already been corrected, checked against their
+ * alarms and kept in the inputs' history, only writing them out is deferred. They are kept in a circular capture
+ * buffer, so the buffer always holds the most recent history. The trigger can be fired by software, by an edge on a
+ * digital input (polled from the main loop and matched to the first sample taken at or after it) or by an analog input
+ * crossing a level of its corrected value. Once it fires, the configured number of post-trigger samples are recorded,
+ * acquisition is halted, and the frozen window is written out a block at a time exactly as streamed samples would be.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Analog_Trigger.h"
+#include "Analog_Batch.h"
+#include "Digital_Input.h"
+#include "Tekdaqc_Config.h"
+#include "Tekdaqc_Memory.h"
+#include "TelnetServer.h"
+#include "Data_Output.h"
+#include <inttypes.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def ANALOG_TRIGGER_WRITE_BLOCK
+ * @brief The number of samples of the frozen window written out per pass of the main loop.
+ */
+#define ANALOG_TRIGGER_WRITE_BLOCK		16U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The circular capture buffer */
+static Analog_Samples_t captureBuffer[ANALOG_TRIGGER_BUFFER_SIZE] CCM_BSS;
+
+/* The corrected value of each sample in the capture buffer */
+static int32_t captureValues[ANALOG_TRIGGER_BUFFER_SIZE] CCM_BSS;
+
+/* The index the next sample is recorded at */
+static uint32_t captureHead = 0U;
+
+/* The number of valid samples in the capture buffer */
+static uint32_t captureCount = 0U;
+
+/* The index of the first sample of the window */
+static uint32_t windowStart = 0U;
+
+/* The number of samples in the window */
+static uint32_t windowLength = 0U;
+
+/* The number of samples of the window already written out */
+static uint32_t windowWritten = 0U;
+
+/* The number of post-trigger samples still to be recorded */
+static uint32_t postRemaining = 0U;
+
+/* The time the trigger fired at */
+static uint64_t triggerTime = 0U;
+
+/* If a software or digital trigger is waiting for the first sample taken at or after triggerTime */
+static bool triggerPending = FALSE;
+
+/* The previous corrected value of the analog trigger input */
+static int32_t previousValue = 0;
+
+/* If previousValue is valid */
+static bool havePreviousValue = FALSE;
+
+/* The previous reported level of the digital trigger input, TRUE for high */
+static bool previousHigh = FALSE;
+
+/* The trigger configuration */
+static AnalogTrigger_Config_t triggerConfig;
+
+/* The state of the trigger engine */
+static AnalogTrigger_State_t triggerState = TRIGGER_IDLE;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Checks if a transition between two levels matches the configured edge.
+ */
+static bool AnalogTrigger_IsEdge(bool wasAbove, bool isAbove);
+
+/**
+ * @internal
+ * @brief Samples the digital trigger input and reports if it is high, as reported to the client.
+ */
+static bool AnalogTrigger_SampleDigital(Digital_Input_t* input);
+
+/**
+ * @internal
+ * @brief Fires the trigger on the sample just recorded.
+ */
+static void AnalogTrigger_Trigger(uint32_t index);
+
+/**
+ * @internal
+ * @brief Halts acquisition and reports the window which is about to be written out.
+ */
+static void AnalogTrigger_Freeze(void);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Checks if a transition between two levels matches the configured edge.
+ *
+ * @param wasAbove bool If the input was high, or at or above the level, before.
+ * @param isAbove bool If the input is high, or at or above the level, now.
+ * @retval bool TRUE if the trigger should fire.
+ */
+static bool AnalogTrigger_IsEdge(bool wasAbove, bool isAbove) {
+	if (wasAbove == isAbove) {
+		return FALSE;
+	}
+	switch (triggerConfig.edge) {
+	case TRIGGER_EDGE_RISING:
+		return isAbove;
+	case TRIGGER_EDGE_FALLING:
+		return (isAbove == FALSE) ? TRUE : FALSE;
+	case TRIGGER_EDGE_EITHER:
+	default:
+		return TRUE;
+	}
+}
+
+/**
+ * Samples the digital trigger input. The input circuitry inverts, so a pin read as LOGIC_LOW is reported to the client
+ * as high, and edges are taken on the reported level.
+ *
+ * @param input Digital_Input_t* The digital trigger input.
+ * @retval bool TRUE if the input is reported high.
+ */
+static bool AnalogTrigger_SampleDigital(Digital_Input_t* input) {
+	SampleDigitalInput(input);
+	return (input->level == LOGIC_LOW) ? TRUE : FALSE;
+}
+
+/**
+ * Fires the trigger on the sample just recorded, marking the start of the window as far back as the pre-trigger
+ * count or the recorded history allows.
+ *
+ * @param index uint32_t The index of the trigger sample in the capture buffer.
+ * @retval none
+ */
+static void AnalogTrigger_Trigger(uint32_t index) {
+	uint32_t pre = captureCount - 1U;
+	if (pre > triggerConfig.preSamples) {
+		pre = triggerConfig.preSamples;
+	}
+	windowStart = (index + ANALOG_TRIGGER_BUFFER_SIZE - pre) % ANALOG_TRIGGER_BUFFER_SIZE;
+	windowLength = pre + 1U + triggerConfig.postSamples;
+	triggerTime = captureBuffer[index].ui64TimeStamp;
+	postRemaining = triggerConfig.postSamples;
+	triggerPending = FALSE;
+	triggerState = TRIGGER_TRIGGERED;
+#ifdef ANALOG_TRIGGER_DEBUG
+	printf("[Analog Trigger] Fired at %" PRIu64 " with %" PRIu32 " pre-trigger samples.\n\r", triggerTime, pre);
+#endif
+}
+
+/**
+ * Halts acquisition, so that no more samples are streamed once the window is written, and reports the window.
+ *
+ * @param none
+ * @retval none
+ */
+static void AnalogTrigger_Freeze(void) {
+	AnalogHalt();
+	windowWritten = 0U;
+	triggerState = TRIGGER_FROZEN;
+	snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER,
+			"Trigger\n\r\tSource: %s\n\r\tTime: %" PRIu64 "\n\r\tPre-Trigger Samples: %" PRIu32
+			"\n\r\tPost-Trigger Samples: %" PRIu32 "\n\r", AnalogTrigger_SourceToString(triggerConfig.source),
+			triggerTime, windowLength - 1U - triggerConfig.postSamples, triggerConfig.postSamples);
+	TelnetWriteStatusMessage(TOSTRING_BUFFER);
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Disarms the trigger and restores the default configuration, a software trigger with the default window.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogTrigger_Init(void) {
+	triggerConfig.source = TRIGGER_SOURCE_SOFTWARE;
+	triggerConfig.edge = TRIGGER_EDGE_RISING;
+	triggerConfig.input = 0U;
+	triggerConfig.level = 0;
+	triggerConfig.preSamples = ANALOG_TRIGGER_DEFAULT_PRE;
+	triggerConfig.postSamples = ANALOG_TRIGGER_DEFAULT_POST;
+	AnalogTrigger_Disarm();
+}
+
+/**
+ * Sets the trigger configuration. The trigger must not be armed.
+ *
+ * @param config const AnalogTrigger_Config_t* The new configuration.
+ * @retval bool TRUE if the configuration was accepted.
+ */
+bool AnalogTrigger_Configure(const AnalogTrigger_Config_t* config) {
+	if ((triggerState != TRIGGER_IDLE) || !IS_ANALOG_TRIGGER_WINDOW(config->preSamples, config->postSamples)) {
+		return FALSE;
+	}
+	if ((config->source == TRIGGER_SOURCE_DIGITAL) && (config->input >= NUM_DIGITAL_INPUTS)) {
+		return FALSE;
+	}
+	if ((config->source == TRIGGER_SOURCE_ANALOG) && (GetAnalogInputByNumber(config->input) == NULL)) {
+		return FALSE;
+	}
+	triggerConfig = *config;
+	return TRUE;
+}
+
+/**
+ * Retrieves the trigger configuration.
+ *
+ * @param config AnalogTrigger_Config_t* The structure to fill.
+ * @retval none
+ */
+void AnalogTrigger_GetConfig(AnalogTrigger_Config_t* config) {
+	*config = triggerConfig;
+}
+
+/**
+ * Empties the capture buffer and starts recording. Acquisition itself is started separately.
+ *
+ * @param none
+ * @retval bool TRUE if the trigger was armed, FALSE if the digital trigger input has not been added.
+ */
+bool AnalogTrigger_Arm(void) {
+	Digital_Input_t* input;
+	if (triggerConfig.source == TRIGGER_SOURCE_DIGITAL) {
+		input = GetDigitalInputByNumber(triggerConfig.input);
+		if ((input == NULL) || (input->added != CHANNEL_ADDED)) {
+			return FALSE;
+		}
+		previousHigh = AnalogTrigger_SampleDigital(input);
+	}
+	captureHead = 0U;
+	captureCount = 0U;
+	triggerPending = FALSE;
+	havePreviousValue = FALSE;
+	triggerState = TRIGGER_ARMED;
+	return TRUE;
+}
+
+/**
+ * Abandons any capture in progress. Samples are streamed as normal afterwards.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogTrigger_Disarm(void) {
+	triggerPending = FALSE;
+	triggerState = TRIGGER_IDLE;
+}
+
+/**
+ * Fires a software trigger. The window is centered on the first sample taken at or after the given time.
+ *
+ * @param time uint64_t The local time to trigger at, in microseconds.
+ * @retval bool TRUE if the trigger was armed for a software trigger.
+ */
+bool AnalogTrigger_Fire(uint64_t time) {
+	if ((triggerState != TRIGGER_ARMED) || (triggerConfig.source != TRIGGER_SOURCE_SOFTWARE)) {
+		return FALSE;
+	}
+	triggerTime = time;
+	triggerPending = TRUE;
+	return TRUE;
+}
+
+/**
+ * Retrieves the state of the trigger engine.
+ *
+ * @param none
+ * @retval AnalogTrigger_State_t The current state.
+ */
+AnalogTrigger_State_t AnalogTrigger_GetState(void) {
+	return triggerState;
+}
+
+/**
+ * Checks if samples drained from the analog sample buffer should be handed to AnalogTrigger_Record() rather than
+ * streamed.
+ *
+ * @param none
+ * @retval bool TRUE while a capture is in progress.
+ */
+bool AnalogTrigger_IsCapturing(void) {
+	return (triggerState != TRIGGER_IDLE) ? TRUE : FALSE;
+}
+
+/**
+ * Records a block of samples into the capture buffer, firing the trigger on the first sample which meets it. Samples
+ * arriving once the window is frozen are discarded.
+ *
+ * @param samples const Analog_Samples_t* The samples, oldest first.
+ * @param corrected const int32_t* The corrected value of each sample.
+ * @param count uint32_t The number of samples.
+ * @retval none
+ */
+void AnalogTrigger_Record(const Analog_Samples_t* samples, const int32_t* corrected, uint32_t count) {
+	uint32_t index;
+	bool fire;
+	for (uint32_t i = 0U; (i < count) && (triggerState != TRIGGER_FROZEN); ++i) {
+		index = captureHead;
+		captureBuffer[index] = samples[i];
+		captureValues[index] = corrected[i];
+		captureHead = (captureHead + 1U) % ANALOG_TRIGGER_BUFFER_SIZE;
+		if (captureCount < ANALOG_TRIGGER_BUFFER_SIZE) {
+			++captureCount;
+		}
+		if (triggerState == TRIGGER_TRIGGERED) {
+			if (--postRemaining == 0U) {
+				AnalogTrigger_Freeze();
+			}
+			continue;
+		}
+		fire = FALSE;
+		if (triggerPending == TRUE) {
+			fire = (samples[i].ui64TimeStamp >= triggerTime) ? TRUE : FALSE;
+		} else if ((triggerConfig.source == TRIGGER_SOURCE_ANALOG) && (samples[i].iChannel == triggerConfig.input)) {
+			if (havePreviousValue == TRUE) {
+				fire = AnalogTrigger_IsEdge(previousValue >= triggerConfig.level, corrected[i] >= triggerConfig.level);
+			}
+			previousValue = corrected[i];
+			havePreviousValue = TRUE;
+		}
+		if (fire == TRUE) {
+			AnalogTrigger_Trigger(index);
+			if (postRemaining == 0U) {
+				AnalogTrigger_Freeze();
+			}
+		}
+	}
+}
+
+/**
+ * Watches the digital trigger input while armed, and writes out a block of the frozen window. Called from the main
+ * loop after the analog sample buffer has been drained.
+ *
+ * @param none
+ * @retval none
+ */
+void AnalogTrigger_Service(void) {
+	Analog_Samples_t block[ANALOG_TRIGGER_WRITE_BLOCK];
+	int32_t values[ANALOG_TRIGGER_WRITE_BLOCK];
+	Digital_Input_t* input;
+	uint32_t count;
+	bool high;
+	if ((triggerState == TRIGGER_ARMED) && (triggerConfig.source == TRIGGER_SOURCE_DIGITAL)
+			&& (triggerPending == FALSE)) {
+		input = GetDigitalInputByNumber(triggerConfig.input);
+		high = AnalogTrigger_SampleDigital(input);
+		if (AnalogTrigger_IsEdge(previousHigh, high) == TRUE) {
+			triggerTime = input->timestamp;
+			triggerPending = TRUE;
+		}
+		previousHigh = high;
+	} else if (triggerState == TRIGGER_FROZEN) {
+		for (count = 0U; (count < ANALOG_TRIGGER_WRITE_BLOCK) && (windowWritten < windowLength); ++count) {
+			block[count] = captureBuffer[(windowStart + windowWritten) % ANALOG_TRIGGER_BUFFER_SIZE];
+			values[count] = captureValues[(windowStart + windowWritten) % ANALOG_TRIGGER_BUFFER_SIZE];
+			++windowWritten;
+		}
+		WriteAnalogSamples(block, values, count);
+		if (windowWritten == windowLength) {
+			if (DataOutput_GetFormat() == TELNET_FORMAT_BINARY) {
+				AnalogBatch_Flush();
+			}
+			triggerState = TRIGGER_IDLE;
+		}
+	}
+}
+
+/**
+ * Converts a trigger source into a human readable string.
+ *
+ * @param source AnalogTrigger_Source_t The trigger source.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogTrigger_SourceToString(AnalogTrigger_Source_t source) {
+	switch (source) {
+	case TRIGGER_SOURCE_SOFTWARE:
+		return "SOFTWARE";
+	case TRIGGER_SOURCE_DIGITAL:
+		return "DIGITAL";
+	case TRIGGER_SOURCE_ANALOG:
+		return "ANALOG";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+/**
+ * Converts a trigger edge into a human readable string.
+ *
+ * @param edge AnalogTrigger_Edge_t The trigger edge.
+ * @retval const char* The C-String representation.
+ */
+const char* AnalogTrigger_EdgeToString(AnalogTrigger_Edge_t edge) {
+	switch (edge) {
+	case TRIGGER_EDGE_RISING:
+		return "RISING";
+	case TRIGGER_EDGE_FALLING:
+		return "FALLING";
+	case TRIGGER_EDGE_EITHER:
+		return "EITHER";
+	default:
+		return "UNKNOWN";
+	}
+}
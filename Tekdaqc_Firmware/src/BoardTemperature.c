@@ -32,6 +32,7 @@
 #include "Tekdaqc_Debug.h"
 #include "Tekdaqc_Config.h"
 #include "eeprom.h"
+#include "Tekdaqc_CalibrationTable.h"
 
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE DEFINES */
@@ -95,6 +96,7 @@ void updateBoardTemperature(Analog_Input_t* input, int32_t code) {
 	if (code < 0)
 		++max; /* Add one for negative range. */
 	temperature = LM35_SLOPE * ((2.0f * V_REFERENCE )/ADS1256_GetGainMultiplier(input->gain))* (((float) code)/max);
+	Tekdaqc_UpdateGainCorrectionTemperature(temperature);
 	return;
 #ifdef BOARD_TEMPERATURE_DEBUG
 	//printf("[Board Temperature] New board temperature: %f Deg C.\n\r", temperature);
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file ColdJunction_Policy.c
+ * @brief Source file for the cold junction sampling policy.
+ *
+ * Every cold junction read interleaved with a multi-channel scan takes a slot away from the inputs being scanned, so
+ * the cold junction is only read as often as the board temperature needs. Each reading is compared with the last to
+ * find the rate the temperature is changing, and the interval is set so that the temperature moves about
+ * COLD_JUNCTION_TARGET_STEP between reads. While the board warms up the interval shrinks straight away, and once it is
+ * stable the interval doubles with each quiet reading up to COLD_JUNCTION_MAX_INTERVAL.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "ColdJunction_Policy.h"
+#include <math.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#include <inttypes.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def COLD_JUNCTION_US_PER_S
+ * @brief Microseconds per second.
+ */
+#define COLD_JUNCTION_US_PER_S			1000000.0f
+
+/**
+ * @internal
+ * @def COLD_JUNCTION_BACKOFF_STEP
+ * @brief The fraction of COLD_JUNCTION_TARGET_STEP below which the temperature is considered stable and the interval
+ * is doubled.
+ */
+#define COLD_JUNCTION_BACKOFF_STEP		(COLD_JUNCTION_TARGET_STEP / 4.0f)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The current time between cold junction reads, in microseconds */
+static volatile uint32_t coldJunctionInterval = COLD_JUNCTION_MIN_INTERVAL;
+
+/* The time the last cold junction read was scheduled */
+static volatile uint64_t lastColdJunctionRead = 0U;
+
+/* If a previous reading is available to compare against */
+static bool havePreviousReading = FALSE;
+
+/* The time of the previous reading */
+static uint64_t previousTime = 0U;
+
+/* The board temperature of the previous reading, in degrees C */
+static float previousTemperature = 0.0f;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Restarts the policy at the shortest interval, since nothing is known about how the temperature changed while the
+ * scan was stopped. Must only be called while no scan is running.
+ *
+ * @param now uint64_t The current local time in microseconds.
+ * @retval none
+ */
+void ColdJunction_PolicyReset(uint64_t now) {
+	coldJunctionInterval = COLD_JUNCTION_MIN_INTERVAL;
+	lastColdJunctionRead = now;
+	havePreviousReading = FALSE;
+}
+
+/**
+ * Checks if a cold junction read is due. Called by the channel switch handler.
+ *
+ * @param now uint64_t The current local time in microseconds.
+ * @retval bool TRUE if the cold junction should be read next.
+ */
+bool ColdJunction_PolicyIsDue(uint64_t now) {
+	uint64_t last = lastColdJunctionRead;
+	return ((now < last) || ((now - last) >= coldJunctionInterval)) ? TRUE : FALSE;
+}
+
+/**
+ * Records that a cold junction read has been scheduled. Called by the channel switch handler.
+ *
+ * @param now uint64_t The current local time in microseconds.
+ * @retval none
+ */
+void ColdJunction_PolicyScheduled(uint64_t now) {
+	lastColdJunctionRead = now;
+}
+
+/**
+ * Adapts the interval to a new board temperature reading. Called from the main loop as cold junction samples are
+ * processed.
+ *
+ * @param time uint64_t The time the reading was taken, in microseconds.
+ * @param temperature float The board temperature, in degrees C.
+ * @retval none
+ */
+void ColdJunction_PolicyObserve(uint64_t time, float temperature) {
+	float rate;
+	float step;
+	uint32_t interval = coldJunctionInterval;
+	if ((havePreviousReading == FALSE) || (time <= previousTime)) {
+		havePreviousReading = TRUE;
+		previousTime = time;
+		previousTemperature = temperature;
+		return;
+	}
+	/* Degrees C per second, and how far that would move the temperature over the current interval */
+	rate = fabsf(temperature - previousTemperature) * COLD_JUNCTION_US_PER_S / (float) (time - previousTime);
+	step = rate * (float) interval / COLD_JUNCTION_US_PER_S;
+	previousTime = time;
+	previousTemperature = temperature;
+	if (step > COLD_JUNCTION_TARGET_STEP) {
+		/* Warming up, catch up right away */
+		interval = (uint32_t) (COLD_JUNCTION_TARGET_STEP * COLD_JUNCTION_US_PER_S / rate);
+		if (interval < COLD_JUNCTION_MIN_INTERVAL) {
+			interval = COLD_JUNCTION_MIN_INTERVAL;
+		}
+	} else if (step < COLD_JUNCTION_BACKOFF_STEP) {
+		/* Stable, back off gradually */
+		interval = (interval > (COLD_JUNCTION_MAX_INTERVAL / 2U)) ? COLD_JUNCTION_MAX_INTERVAL : (interval * 2U);
+	}
+#ifdef COLD_JUNCTION_DEBUG
+	if (interval != coldJunctionInterval) {
+		printf("[Cold Junction] Read interval now %" PRIu32 " us.\n\r", interval);
+	}
+#endif
+	coldJunctionInterval = interval;
+}
+
+/**
+ * Retrieves the current time between cold junction reads.
+ *
+ * @param none
+ * @retval uint32_t The interval in microseconds.
+ */
+uint32_t ColdJunction_PolicyGetInterval(void) {
+	return coldJunctionInterval;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Data_Output.c
+ * @brief Source file for the sampled data output routing.
+ *
+ * The data server takes over from the telnet connection the moment a client connects to it and hands back when that
+ * client goes away, and the UDP stream takes over from both while it is enabled, so a producer must not cache which
+ * connection it writes to. The UDP stream has no flow control, so it always has room.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Data_Output.h"
+#include "DataServer.h"
+#include "Tekdaqc_UdpStream.h"
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Indicates if there is a connection to write sampled data to, on the UDP stream, the data port or the telnet port.
+ *
+ * @param none
+ * @retval bool TRUE if sampled data can be written.
+ */
+bool DataOutput_IsConnected(void) {
+	return ((UdpStream_IsEnabled() == TRUE) || (DataServerIsConnected() == TRUE) || (TelnetIsConnected() == TRUE)) ?
+			TRUE : FALSE;
+}
+
+/**
+ * Retrieves the format sampled data is written in. The UDP stream and the data server only carry binary frames,
+ * otherwise this is the format selected for the telnet connection.
+ *
+ * @param none
+ * @retval TelnetDataFormat_t The format in use.
+ */
+TelnetDataFormat_t DataOutput_GetFormat(void) {
+	return ((UdpStream_IsEnabled() == TRUE) || (DataServerIsConnected() == TRUE)) ? TELNET_FORMAT_BINARY :
+			TelnetGetDataFormat();
+}
+
+/**
+ * Writes a binary frame to the data connection. On the UDP stream and the data server the frame is written unchanged,
+ * on the telnet connection any TELNET_IAC byte is doubled.
+ *
+ * @param data const uint8_t* Pointer to the frame.
+ * @param length uint32_t The number of bytes in the frame.
+ * @retval none
+ */
+void DataOutput_WriteBuffer(const uint8_t* data, uint32_t length) {
+	if (UdpStream_IsEnabled() == TRUE) {
+		UdpStream_Write(data, length);
+	} else if (DataServerIsConnected() == TRUE) {
+		DataServerWriteBuffer(data, length);
+	} else {
+		TelnetWriteBuffer(data, length);
+	}
+}
+
+/**
+ * Retrieves the number of bytes which can be written to the data connection without waiting for the client.
+ *
+ * @param none
+ * @retval uint32_t The number of bytes, 0 if there is no connection and UINT32_MAX while the UDP stream is enabled.
+ */
+uint32_t DataOutput_GetWriteSpace(void) {
+	if (UdpStream_IsEnabled() == TRUE) {
+		return UINT32_MAX;
+	}
+	return (DataServerIsConnected() == TRUE) ? DataServerGetWriteSpace() : TelnetGetWriteSpace();
+}
+
+/**
+ * Waits for the client of the data connection to make room for the specified number of bytes. Must not be called
+ * from an lwIP callback.
+ *
+ * @param length uint32_t The number of bytes to make room for.
+ * @param timeout uint32_t The longest time to wait, in microseconds.
+ * @retval bool TRUE if there is room, FALSE if the time ran out or the connection was lost.
+ */
+bool DataOutput_WaitWriteSpace(uint32_t length, uint32_t timeout) {
+	if (UdpStream_IsEnabled() == TRUE) {
+		return TRUE;
+	}
+	if (DataServerIsConnected() == TRUE) {
+		return DataServerWaitWriteSpace(length, timeout);
+	}
+	return TelnetWaitWriteSpace(length, timeout);
+}
@@ -31,6 +31,10 @@
 #include "Tekdaqc_Timers.h"
 #include "boolean.h"
 #include "TelnetServer.h"
+#include "Data_Output.h"
+#include "Tekdaqc_DataFrame.h"
+#include "Tekdaqc_Memory.h"
+#include "Output_Backpressure.h"
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
@@ -62,7 +66,10 @@ static Digital_Input_t Ext_DInputs[NUM_DIGITAL_INPUTS];
 
 
 //lfao-circular buffer details...
-Digital_Samples_t DigitalSampleBuffer[DIGITAL_SAMPLES_BUFFER_SIZE];
+static Digital_Samples_t DigitalSampleBuffer[DIGITAL_SAMPLES_BUFFER_SIZE] CCM_BSS;
+static RingBuffer_t DigitalSampleRing;
+//the buffer's drop count already reported as shed...
+static uint32_t reportedDrops = 0U;
 extern volatile uint64_t numDigitalSamples;
 extern volatile int numOfDigitalInputs;
 volatile uint64_t numSamplesTaken = 0;
@@ -104,73 +111,80 @@ static void RemoveDigitalInputByID(uint8_t id);
 /* PRIVATE FUNCTIONS */
 /*--------------------------------------------------------------------------------------------------------*/
 extern Digital_Input_t* dInputs[];
-volatile int iDigiHead;
-volatile int iDigiTail;
 
 //lfao-init buffer and indexes
 void InitDigitalSamplesBuffer(void)
 {
-	iDigiHead=0;
-	iDigiTail=0;
+	RingBuffer_Init(&DigitalSampleRing, DigitalSampleBuffer, sizeof(Digital_Samples_t), DIGITAL_SAMPLES_BUFFER_SIZE);
+	reportedDrops = 0U;
 }
 
-//lfao-writes a new sample and updates the iDigiHead
+//lfao-writes a new sample to the buffer
 int WriteDigiSampleToBuffer(Digital_Samples_t *Data)
 {
-
-	//full or empty
-	if((iDigiHead+2)%DIGITAL_SAMPLES_BUFFER_SIZE ==  iDigiTail%DIGITAL_SAMPLES_BUFFER_SIZE)
-	{
-		return 1;
-	}
-	else
-	{
-		iDigiHead=iDigiHead%DIGITAL_SAMPLES_BUFFER_SIZE;
-		DigitalSampleBuffer[iDigiHead].iChannel = Data->iChannel;
-		DigitalSampleBuffer[iDigiHead].iLevel = Data->iLevel;
-		DigitalSampleBuffer[iDigiHead].ui64TimeStamp= Data->ui64TimeStamp;
-		iDigiHead++;
-	    return 0;
-	}
+	return (RingBuffer_Write(&DigitalSampleRing, Data) == true) ? 0 : 1;
 }
-//lfao-reads sample from buffer and updates iDigiTail
+
+//lfao-reads sample from buffer
 int ReadDigitalSampleFromBuffer(Digital_Samples_t *Data)
 {
+	return (RingBuffer_Read(&DigitalSampleRing, Data) == true) ? 0 : 1;
+}
 
-	//full/empty
-	if(iDigiTail%DIGITAL_SAMPLES_BUFFER_SIZE ==  iDigiHead%DIGITAL_SAMPLES_BUFFER_SIZE)
-	{
-		return 1;
-	}
-	else
-	{
-		iDigiTail=iDigiTail%DIGITAL_SAMPLES_BUFFER_SIZE;
-		Data->iChannel = DigitalSampleBuffer[iDigiTail].iChannel;
-		Data->iLevel = DigitalSampleBuffer[iDigiTail].iLevel;
-		Data->ui64TimeStamp = DigitalSampleBuffer[iDigiTail].ui64TimeStamp;
-		iDigiTail++;
-	    return 0;
-	}
+/**
+ * Retrieves the counters of the buffer which carries digital samples to the main loop.
+ *
+ * @param stats RingBuffer_Statistics_t* Pointer to the structure to fill.
+ * @retval none
+ */
+void GetDigitalSamplesBufferStats(RingBuffer_Statistics_t* stats)
+{
+	RingBuffer_GetStatistics(&DigitalSampleRing, stats);
 }
 
 //lfao-converts the gathered data into ASCII and writes it to Telnet...
 void WriteToTelnet_Digital(void)
 {
 	Digital_Samples_t tempData;
+	uint8_t frame[DATA_FRAME_MAX_SAMPLE_SIZE];
+	RingBuffer_Statistics_t stats;
+	uint32_t length;
+
+	//samples the interrupt found no room for are shed as well...
+	GetDigitalSamplesBufferStats(&stats);
+	OutputBackpressure_Overrun(stats.drops - reportedDrops);
+	reportedDrops = stats.drops;
 
 	while(1)
 	{
+		//while the data connection cannot take a record, leave the samples buffered...
+		if(OutputBackpressure_Hold(OUTPUT_BACKPRESSURE_RECORD_SIZE))
+		{
+			//...making way for new samples if the policy prefers them to the oldest
+			for(length = OutputBackpressure_Excess(RingBuffer_Count(&DigitalSampleRing), DIGITAL_SAMPLES_BUFFER_SIZE); length > 0; length--)
+			{
+				ReadDigitalSampleFromBuffer(&tempData);
+			}
+			break;
+		}
 		if(ReadDigitalSampleFromBuffer(&tempData)==0)
 		{
-			if(tempData.iLevel==LOGIC_HIGH)
+			if(OutputBackpressure_Admit(OUTPUT_BACKPRESSURE_RECORD_SIZE) == FALSE)
+			{
+				continue;
+			}
+			if(DataOutput_GetFormat() == TELNET_FORMAT_BINARY)
 			{
-		       snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, "?D%i\r\n%" PRIu64 ",L%c\r\n", tempData.iChannel, tempData.ui64TimeStamp, 0x1e);
+				//same inversion as the ASCII format, 1 is reported as H...
+				length = DataFrame_EncodeDigital(frame, (uint8_t) tempData.iChannel, tempData.ui64TimeStamp, (tempData.iLevel==LOGIC_HIGH) ? 0U : 1U);
+				DataOutput_WriteBuffer(frame, length);
 			}
 			else
 			{
-			   snprintf(TOSTRING_BUFFER, SIZE_TOSTRING_BUFFER, "?D%i\r\n%" PRIu64 ",H%c\r\n", tempData.iChannel, tempData.ui64TimeStamp, 0x1e);
-		    }
-		    TelnetWriteString(TOSTRING_BUFFER);
+				//same inversion as the binary format, a high level is reported as L...
+				TelnetWriteFormatted("?D%i\r\n%" PRIu64 ",%c%c\r\n", tempData.iChannel, tempData.ui64TimeStamp,
+						(tempData.iLevel==LOGIC_HIGH) ? 'L' : 'H', 0x1e);
+			}
 		}
 		else
 		{
@@ -184,6 +198,11 @@ void WriteToTelnet_Digital(void)
 void ReadDigitalInputs(void)
 {
 	Digital_Samples_t tempDigitalSample;
+	//acquisition is held while the data connection catches up...
+	if(OutputBackpressure_IsPaused())
+	{
+		return;
+	}
 	for (uint_fast8_t i = 0U; i < NUM_DIGITAL_INPUTS; ++i)
 	{
 		if(dInputs[i] != NULL)
@@ -379,6 +398,9 @@ static void RemoveDigitalInputByID(uint8_t id) {
 void DigitalInputsInit(void) {
 	GPIO_InitTypeDef GPIO_InitStructure;
 
+	/* Initialize the sample buffer */
+	InitDigitalSamplesBuffer();
+
 	/* Enable the GPIO Clock */
 	RCC_AHB1PeriphClockCmd(GPI_GPIO_CLKS, ENABLE);
 
@@ -56,6 +56,15 @@ static WriteFunction writer = NULL;
 //static uint8_t DigitalOutputMap[] = {6, 1, 2, 4, 15, 8, 10,	12, 7, 0, 3, 5, 14, 9, 11, 13};
 //static uint8_t channelMap[16] = {14,9,10,12,7,0,2,4,15,8,11,13,6,1,3,5};
 static uint8_t channelMap[16] = {5,3,1,6,13,11,8,15,4,2,0,7,12,10,9,14};
+
+/* The outputs last written, by channel label */
+static uint16_t currentOutputs = 0U;
+
+/**
+ * @internal
+ * @brief Writes all 16 outputs to the output drivers.
+ */
+static void WriteDigitalOutputs(uint16_t uiOrigOutput);
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE EXTERNAL VARIABLES */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -416,42 +425,19 @@ Digital_Output_t* GetDigitalOutputByNumber(uint8_t number) {
 	}
 }
 #endif
-/* Set the 16-bit digital output */
-Tekdaqc_Function_Error_t SetDigitalOutput(char keys[][MAX_COMMANDPART_LENGTH], char values[][MAX_COMMANDPART_LENGTH], uint8_t count)
+/**
+ * @internal
+ * Writes all 16 outputs to the output drivers, remapping the channel labels to the driver pins.
+ *
+ * @param uiOrigOutput uint16_t The output levels by channel label, a set bit turns the output on.
+ * @retval none
+ */
+static void WriteDigitalOutputs(uint16_t uiOrigOutput)
 {
-	Tekdaqc_Function_Error_t retval = ERR_FUNCTION_OK;
-	char* param;
-	int8_t index = -1, i;
-	uint16_t uiOrigOutput, uiRemappedOutput=0;
+	uint16_t uiRemappedOutput=0;
 	uint8_t uiHighByte;
-
-
-
-	index = GetIndexOfArgument(keys, SET_DIGITAL_OUTPUT_PARAMS[0], count);
-	param = values[index];
-
-	//placed some error checking here...
-	if (strlen(param) != 4)
-	{
-		return ERR_COMMAND_BAD_PARAM;
-	}
-	for (i = 0; i< strlen(param); i++)
-	{
-		if (param[i]<0x30 || param[i]>0x66)
-		{
-			return ERR_COMMAND_BAD_PARAM;
-		}
-		if (param[i]>0x39 && param[i]<0x41)
-		{
-			return ERR_COMMAND_BAD_PARAM;
-		}
-		if (param[i]>0x46 && param[i]<0x61)
-		{
-			return ERR_COMMAND_BAD_PARAM;
-		}
-	}
-
-	sscanf(param, "%x", &uiOrigOutput);
+	uint_fast8_t i;
+	currentOutputs = uiOrigOutput;
     //remap channel labels data to actual output pins...
 	for (i = 0; i < 16; i++)
 	{
@@ -487,6 +473,62 @@ Tekdaqc_Function_Error_t SetDigitalOutput(char keys[][MAX_COMMANDPART_LENGTH], c
 	TLE7232_CS_HIGH();
 	Delay_us(2);
 	//put delay here???
+}
+
+/**
+ * Turns a single digital output on or off, leaving the others as they were last written.
+ *
+ * @param output uint8_t The output channel label.
+ * @param level DigitalLevel_t OUTPUT_ON or OUTPUT_OFF.
+ * @retval none
+ */
+void SetDigitalOutputChannel(uint8_t output, DigitalLevel_t level)
+{
+	uint16_t mask;
+	if (output >= NUM_DIGITAL_OUTPUTS)
+	{
+		return;
+	}
+	mask = (uint16_t) (0x0001U << output);
+	WriteDigitalOutputs((level == OUTPUT_ON) ? (currentOutputs | mask) : (currentOutputs & (uint16_t) ~mask));
+}
+
+/* Set the 16-bit digital output */
+Tekdaqc_Function_Error_t SetDigitalOutput(char keys[][MAX_COMMANDPART_LENGTH], char values[][MAX_COMMANDPART_LENGTH], uint8_t count)
+{
+	Tekdaqc_Function_Error_t retval = ERR_FUNCTION_OK;
+	char* param;
+	int8_t index = -1, i;
+	uint16_t uiOrigOutput;
+
+
+
+	index = GetIndexOfArgument(keys, SET_DIGITAL_OUTPUT_PARAMS[0], count);
+	param = values[index];
+
+	//placed some error checking here...
+	if (strlen(param) != 4)
+	{
+		return ERR_COMMAND_BAD_PARAM;
+	}
+	for (i = 0; i< strlen(param); i++)
+	{
+		if (param[i]<0x30 || param[i]>0x66)
+		{
+			return ERR_COMMAND_BAD_PARAM;
+		}
+		if (param[i]>0x39 && param[i]<0x41)
+		{
+			return ERR_COMMAND_BAD_PARAM;
+		}
+		if (param[i]>0x46 && param[i]<0x61)
+		{
+			return ERR_COMMAND_BAD_PARAM;
+		}
+	}
+
+	sscanf(param, "%x", &uiOrigOutput);
+	WriteDigitalOutputs(uiOrigOutput);
 
 #if 0
 
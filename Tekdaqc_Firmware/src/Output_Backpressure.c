@@ -0,0 +1,357 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Output_Backpressure.c
+ * @brief Source file for the sampled data output backpressure policies.
+ *
+ * Producers call OutputBackpressure_Hold() before draining their sample buffer and OutputBackpressure_Admit() before
+ * writing each record. The connection is congested while less than OUTPUT_BACKPRESSURE_LOW_WATER bytes can be
+ * written without waiting for the client. Every record which is not written is counted against the policy which shed
+ * it, and once the connection has caught up a single notice with the number of records shed is written in band.
+ * Samples a producer's buffer had no room for are reported through OutputBackpressure_Overrun() and included in the
+ * same notice.
+ *
+ * Only the BLOCK policy ever waits, and then only once per congestion: after a wait times out, records are shed
+ * straight away until the connection has caught up again. Status messages are not subject to a policy, they wait at
+ * most the telnet write timeout.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Output_Backpressure.h"
+#include "Tekdaqc_Config.h"
+#include "Tekdaqc_DataFrame.h"
+#include "Tekdaqc_Timers.h"
+#include "TelnetServer.h"
+#include "Data_Output.h"
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def OUTPUT_BACKPRESSURE_LOW_WATER
+ * @brief The connection is congested while less room than this is free, in bytes. The telnet and data server
+ * transmit queues have the same number of blocks.
+ */
+#define OUTPUT_BACKPRESSURE_LOW_WATER	((TELNET_TX_NUM_BLOCKS / 2U) * TX_QUEUE_BLOCK_SIZE)
+
+/**
+ * @internal
+ * @def OUTPUT_BACKPRESSURE_HIGH_WATER
+ * @brief Paused acquisition continues once this much room is free, in bytes.
+ */
+#define OUTPUT_BACKPRESSURE_HIGH_WATER	(((TELNET_TX_NUM_BLOCKS * 3U) / 4U) * TX_QUEUE_BLOCK_SIZE)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The selected policy */
+static OutputBackpressure_Config_t config;
+
+/* The counters since the policy was configured */
+static OutputBackpressure_Counters_t counters;
+
+/* The number of records shed since the last notice */
+static uint32_t pending = 0U;
+
+/* If a BLOCK wait has timed out during the current congestion */
+static bool timedOut = FALSE;
+
+/* The number of records skipped since the last one written under DECIMATE */
+static uint32_t skipped = 0U;
+
+/* If acquisition is being held, read by the channel switch interrupt */
+static volatile bool paused = FALSE;
+
+/* The time acquisition was last held */
+static uint64_t pausedSince = 0U;
+
+/* The frame buffer used for binary notices */
+static uint8_t frame[DATA_FRAME_SHED_SIZE];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * Retrieves the room on the data connection. Without a connection records are simply discarded by the writers, so
+ * there is never any backpressure.
+ *
+ * @param none
+ * @retval uint32_t The number of bytes which can be written without waiting.
+ */
+static uint32_t GetSpace(void) {
+	return (DataOutput_IsConnected() == TRUE) ? DataOutput_GetWriteSpace() : UINT32_MAX;
+}
+
+/**
+ * @internal
+ * Lets acquisition continue, adding the time it was held to the counters.
+ *
+ * @param none
+ * @retval none
+ */
+static void Resume(void) {
+	if (paused == TRUE) {
+		paused = FALSE;
+		counters.pausedTime += GetLocalTime() - pausedSince;
+	}
+}
+
+/**
+ * @internal
+ * Writes the number of records shed since the last notice to the data connection, in the current output format.
+ *
+ * @param none
+ * @retval none
+ */
+static void WriteNotice(void) {
+	uint64_t now = GetLocalTime();
+	if (DataOutput_GetFormat() == TELNET_FORMAT_BINARY) {
+		DataOutput_WriteBuffer(frame, DataFrame_EncodeShed(frame, now, (uint8_t) config.policy, pending));
+	} else {
+		TelnetWriteFormatted("?X\r\n%" PRIu64 ",%s,%" PRIu32 "%c\r\n", now,
+				OutputBackpressure_PolicyToString(config.policy), pending, 0x1e);
+	}
+#ifdef OUTPUT_BACKPRESSURE_DEBUG
+	printf("[Output Backpressure] %" PRIu32 " records were shed.\n\r", pending);
+#endif
+	pending = 0U;
+	++counters.notices;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Selects the BLOCK policy with the default timeout and clears the counters.
+ *
+ * @param none
+ * @retval none
+ */
+void OutputBackpressure_Init(void) {
+	OutputBackpressure_Config_t defaults = { .policy = BACKPRESSURE_BLOCK, .timeout =
+			OUTPUT_BACKPRESSURE_DEFAULT_TIMEOUT, .decimation = 1U };
+	OutputBackpressure_Configure(&defaults);
+}
+
+/**
+ * Sets the backpressure configuration, clearing the counters and letting any held acquisition continue.
+ *
+ * @param cfg const OutputBackpressure_Config_t* The new configuration.
+ * @retval bool TRUE if the configuration was applied, FALSE if the policy or decimation is invalid.
+ */
+bool OutputBackpressure_Configure(const OutputBackpressure_Config_t* cfg) {
+	if ((cfg->policy > BACKPRESSURE_PAUSE) || (cfg->decimation == 0U)) {
+#ifdef OUTPUT_BACKPRESSURE_DEBUG
+		printf("[Output Backpressure] Invalid configuration.\n\r");
+#endif
+		return FALSE;
+	}
+	Resume();
+	config = *cfg;
+	memset(&counters, 0, sizeof(counters));
+	pending = 0U;
+	timedOut = FALSE;
+	skipped = 0U;
+	return TRUE;
+}
+
+/**
+ * Retrieves the backpressure configuration.
+ *
+ * @param cfg OutputBackpressure_Config_t* The structure to fill.
+ * @retval none
+ */
+void OutputBackpressure_GetConfig(OutputBackpressure_Config_t* cfg) {
+	*cfg = config;
+}
+
+/**
+ * Retrieves the backpressure counters. The paused time includes the current pause, if any.
+ *
+ * @param stats OutputBackpressure_Counters_t* The structure to fill.
+ * @retval none
+ */
+void OutputBackpressure_GetCounters(OutputBackpressure_Counters_t* stats) {
+	*stats = counters;
+	if (paused == TRUE) {
+		stats->pausedTime += GetLocalTime() - pausedSince;
+	}
+}
+
+/**
+ * Decides if a producer should leave its samples buffered rather than drain them now. Under DROP_OLDEST this is the
+ * case while there is no room for what would be drained. Under PAUSE, acquisition is also held from the moment the
+ * connection becomes congested.
+ *
+ * @param length uint32_t The most a producer would write after draining, in bytes.
+ * @retval bool TRUE if the producer should not drain its buffer.
+ */
+bool OutputBackpressure_Hold(uint32_t length) {
+	uint32_t space;
+	switch (config.policy) {
+	case BACKPRESSURE_DROP_OLDEST:
+		return (GetSpace() < length) ? TRUE : FALSE;
+	case BACKPRESSURE_PAUSE:
+		space = GetSpace();
+		if ((paused == FALSE) && (space < OUTPUT_BACKPRESSURE_LOW_WATER)) {
+			pausedSince = GetLocalTime();
+			paused = TRUE;
+			++counters.pauses;
+		}
+		return (space < length) ? TRUE : FALSE;
+	case BACKPRESSURE_BLOCK:
+	case BACKPRESSURE_DECIMATE:
+	default:
+		return FALSE;
+	}
+}
+
+/**
+ * Retrieves the number of oldest samples a held producer should discard from its buffer, so new samples can still
+ * be taken. Under DROP_OLDEST, a quarter of the buffer is kept free. Under any other policy, nothing is discarded.
+ *
+ * @param held uint32_t The number of samples in the producer's buffer.
+ * @param capacity uint32_t The capacity of the producer's buffer.
+ * @retval uint32_t The number of samples to discard.
+ */
+uint32_t OutputBackpressure_Excess(uint32_t held, uint32_t capacity) {
+	uint32_t limit = capacity - (capacity / 4U);
+	if ((config.policy != BACKPRESSURE_DROP_OLDEST) || (held <= limit)) {
+		return 0U;
+	}
+	counters.droppedOldest += held - limit;
+	pending += held - limit;
+	return held - limit;
+}
+
+/**
+ * Decides if a record should be written. Under DECIMATE, only every Nth record is written while the connection is
+ * congested. Under BLOCK, a record without room waits for it up to the timeout. Otherwise a record is written if there
+ * is room for it.
+ *
+ * @param length uint32_t The most the record could take, in bytes.
+ * @retval bool TRUE if the record should be written, FALSE if it was shed.
+ */
+bool OutputBackpressure_Admit(uint32_t length) {
+	uint32_t space = GetSpace();
+	if ((config.policy == BACKPRESSURE_DECIMATE) && (space < OUTPUT_BACKPRESSURE_LOW_WATER)) {
+		if (++skipped < config.decimation) {
+			++counters.decimated;
+			++pending;
+			return FALSE;
+		}
+		skipped = 0U;
+	}
+	if (space >= length) {
+		return TRUE;
+	}
+	if (config.policy == BACKPRESSURE_BLOCK) {
+		if ((timedOut == FALSE) && (DataOutput_WaitWriteSpace(length, config.timeout) == TRUE)) {
+			return TRUE;
+		}
+		timedOut = TRUE;
+		++counters.timeouts;
+	} else {
+		++counters.overflows;
+	}
+	++pending;
+	return FALSE;
+}
+
+/**
+ * Counts samples a producer's buffer rejected because it was full, so they are reported in the next shed notice like
+ * any other record which never reached the data connection.
+ *
+ * @param count uint32_t The number of samples lost since the producer last reported.
+ * @retval none
+ */
+void OutputBackpressure_Overrun(uint32_t count) {
+	counters.overruns += count;
+	pending += count;
+}
+
+/**
+ * Called from the main loop once the producers have run. Once the connection is no longer congested, the next BLOCK
+ * wait is allowed and a notice is written if anything was shed. Held acquisition continues once the connection has
+ * more room again.
+ *
+ * @param none
+ * @retval none
+ */
+void OutputBackpressure_Service(void) {
+	uint32_t space = GetSpace();
+	if (space >= OUTPUT_BACKPRESSURE_HIGH_WATER) {
+		Resume();
+	}
+	if (space >= OUTPUT_BACKPRESSURE_LOW_WATER) {
+		timedOut = FALSE;
+		if (pending > 0U) {
+			if (DataOutput_IsConnected() == TRUE) {
+				WriteNotice();
+			} else {
+				pending = 0U;
+			}
+		}
+	}
+}
+
+/**
+ * Indicates if acquisition is being held under the PAUSE policy. Safe to call from interrupt context.
+ *
+ * @param none
+ * @retval bool TRUE if no new samples should be taken.
+ */
+bool OutputBackpressure_IsPaused(void) {
+	return paused;
+}
+
+/**
+ * Converts a backpressure policy into a human readable string.
+ *
+ * @param policy OutputBackpressure_Policy_t The policy.
+ * @retval const char* The C-String representation.
+ */
+const char* OutputBackpressure_PolicyToString(OutputBackpressure_Policy_t policy) {
+	switch (policy) {
+	case BACKPRESSURE_BLOCK:
+		return "BLOCK";
+	case BACKPRESSURE_DROP_OLDEST:
+		return "DROP_OLDEST";
+	case BACKPRESSURE_DECIMATE:
+		return "DECIMATE";
+	case BACKPRESSURE_PAUSE:
+		return "PAUSE";
+	default:
+		return "UNKNOWN";
+	}
+}
@@ -38,6 +38,7 @@
 #include "Digital_Input.h"
 #include "Digital_Output.h"
 #include "TelnetServer.h"
+#include "DataServer.h"
 #include "ADS1256_Driver.h"
 #include "Tekdaqc_Calibration.h"
 #include "Tekdaqc_CalibrationTable.h"
@@ -48,6 +49,15 @@
 #include "eeprom.h"
 #include "Tekdaqc_Locator.h"
 #include "Tekdaqc_Timers.h"
+#include "Analog_Batch.h"
+#include "Analog_ScanList.h"
+#include "Analog_Trigger.h"
+#include "Analog_Statistics.h"
+#include "Analog_Alarm.h"
+#include "Analog_Deadband.h"
+#include "ColdJunction_Policy.h"
+#include "Output_Backpressure.h"
+#include "Tekdaqc_UdpStream.h"
 #include <stdlib.h>
 #include <errno.h>
 #include <stdio.h>
@@ -57,8 +67,6 @@
 #include <stdio.h>
 #endif
 
-extern volatile int currentAnHandlerState;
-extern volatile int readColdJunction;
 extern CalibrationState_t calibrationState;
 extern void SelectCalibrationInput(void);
 extern void ADC_Machine_Service_CalibratingVer2(void);
@@ -131,7 +139,10 @@ static const char* COMMAND_STRINGS[NUM_COMMANDS] = {"LIST_ANALOG_INPUTS", "READ_
 		"REMOVE_DIGITAL_OUTPUT", "CLEAR_DIG_OUTPUT_FAULT", "DISCONNECT", "REBOOT", "UPGRADE", "IDENTIFY", "SAMPLE",
 		"HALT", "SET_RTC", "SET_USER_MAC", "CLEAR_USER_MAC", "SET_STATIC_IP", "GET_CALIBRATION_STATUS",
 		"ENTER_CALIBRATION_MODE", "WRITE_GAIN_CALIBRATION_VALUE", "WRITE_CALIBRATION_TEMP", "WRITE_CALIBRATION_VALID",
-		"EXIT_CALIBRATION_MODE", "SET_FACTORY_MAC_ADDR", "SET_BOARD_SERIAL_NUM", "NONE"};
+		"EXIT_CALIBRATION_MODE", "SET_FACTORY_MAC_ADDR", "SET_BOARD_SERIAL_NUM", "GET_BUFFER_STATS",
+		"SET_OUTPUT_FORMAT", "SET_SAMPLE_BATCH", "SET_TRIGGER", "ARM_TRIGGER", "TRIGGER", "SET_STATISTICS",
+		"SET_ALARM", "SET_DEADBAND", "SET_BACKPRESSURE", "SET_UDP_STREAM", "GET_SCAN_STATUS",
+		"GET_DATA_PORT_STATUS", "SET_GAIN_CORRECTION_STEP", "NONE"};
 
 /**
  * List of all parameters for the LIST_ANALOG_INPUTS command.
@@ -153,7 +164,7 @@ const char* READ_ANALOG_INPUT_PARAMS[NUM_READ_ANALOG_INPUT_PARAMS] = {PARAMETER_
  */
 const char* ADD_ANALOG_INPUT_PARAMS[NUM_ADD_ANALOG_INPUT_PARAMS] = {PARAMETER_INPUT, PARAMETER_BUFFER, PARAMETER_RATE,
 PARAMETER_GAIN,
-PARAMETER_NAME};
+PARAMETER_NAME, PARAMETER_DEPTH, PARAMETER_PERIOD};
 
 /**
  * List of all parameters for the REMOVE_ANALOG_INPUT command.
@@ -336,6 +347,81 @@ const char* SET_FACTORY_MAC_ADDR_PARAMS[NUM_SET_FACTORY_MAC_ADDR_PARAMS] = {PARA
  */
 const char* SET_BOARD_SERIAL_NUM_PARAMS[NUM_SET_BOARD_SERIAL_NUM_PARAMS] = {PARAMETER_VALUE};
 
+/**
+ * List of all parameters for the GET_BUFFER_STATS command.
+ */
+const char* GET_BUFFER_STATS_PARAMS[NUM_GET_BUFFER_STATS_PARAMS] = {};
+
+/**
+ * List of all parameters for the SET_OUTPUT_FORMAT command.
+ */
+const char* SET_OUTPUT_FORMAT_PARAMS[NUM_SET_OUTPUT_FORMAT_PARAMS] = {PARAMETER_FORMAT};
+
+/**
+ * List of all parameters for the SET_SAMPLE_BATCH command.
+ */
+const char* SET_SAMPLE_BATCH_PARAMS[NUM_SET_SAMPLE_BATCH_PARAMS] = {PARAMETER_SIZE, PARAMETER_LATENCY};
+
+/**
+ * List of all parameters for the SET_TRIGGER command.
+ */
+const char* SET_TRIGGER_PARAMS[NUM_SET_TRIGGER_PARAMS] = {PARAMETER_SOURCE, PARAMETER_EDGE, PARAMETER_INPUT,
+		PARAMETER_LEVEL, PARAMETER_PRE, PARAMETER_POST};
+
+/**
+ * List of all parameters for the ARM_TRIGGER command.
+ */
+const char* ARM_TRIGGER_PARAMS[NUM_ARM_TRIGGER_PARAMS] = {PARAMETER_INPUT};
+
+/**
+ * List of all parameters for the TRIGGER command.
+ */
+const char* TRIGGER_PARAMS[NUM_TRIGGER_PARAMS] = {};
+
+/**
+ * List of all parameters for the SET_STATISTICS command.
+ */
+const char* SET_STATISTICS_PARAMS[NUM_SET_STATISTICS_PARAMS] = {PARAMETER_INPUT, PARAMETER_WINDOW, PARAMETER_BASIS,
+		PARAMETER_SIZE, PARAMETER_STEP, PARAMETER_REPORT};
+
+/**
+ * List of all parameters for the SET_ALARM command.
+ */
+const char* SET_ALARM_PARAMS[NUM_SET_ALARM_PARAMS] = {PARAMETER_INPUT, PARAMETER_MIN, PARAMETER_MAX,
+		PARAMETER_HYSTERESIS, PARAMETER_OUTPUT, PARAMETER_STATE};
+
+/**
+ * List of all parameters for the SET_DEADBAND command.
+ */
+const char* SET_DEADBAND_PARAMS[NUM_SET_DEADBAND_PARAMS] = {PARAMETER_INPUT, PARAMETER_MODE, PARAMETER_BAND,
+		PARAMETER_HEARTBEAT};
+
+/**
+ * List of all parameters for the SET_BACKPRESSURE command.
+ */
+const char* SET_BACKPRESSURE_PARAMS[NUM_SET_BACKPRESSURE_PARAMS] = {PARAMETER_POLICY, PARAMETER_TIMEOUT,
+		PARAMETER_DECIMATION};
+
+/**
+ * List of all parameters for the SET_UDP_STREAM command.
+ */
+const char* SET_UDP_STREAM_PARAMS[NUM_SET_UDP_STREAM_PARAMS] = {PARAMETER_STATE, PARAMETER_ADDRESS, PARAMETER_PORT};
+
+/**
+ * List of all parameters for the GET_SCAN_STATUS command.
+ */
+const char* GET_SCAN_STATUS_PARAMS[NUM_GET_SCAN_STATUS_PARAMS] = {};
+
+/**
+ * List of all parameters for the GET_DATA_PORT_STATUS command.
+ */
+const char* GET_DATA_PORT_STATUS_PARAMS[NUM_GET_DATA_PORT_STATUS_PARAMS] = {};
+
+/**
+ * List of all parameters for the SET_GAIN_CORRECTION_STEP command.
+ */
+const char* SET_GAIN_CORRECTION_STEP_PARAMS[NUM_SET_GAIN_CORRECTION_STEP_PARAMS] = {PARAMETER_STEP};
+
 /**
  * List of all parameters for the NONE command.
  */
@@ -770,6 +856,104 @@ static Tekdaqc_Command_Error_t Ex_SetFactoryMACAddr(char keys[][MAX_COMMANDPART_
 static Tekdaqc_Command_Error_t Ex_SetBoardSerialNum(char keys[][MAX_COMMANDPART_LENGTH],
 		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
 
+/**
+ * @internal
+ * @brief Execute the GET_BUFFER_STATS command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_GetBufferStats(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_OUTPUT_FORMAT command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetOutputFormat(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_SAMPLE_BATCH command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetSampleBatch(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_TRIGGER command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetTrigger(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the ARM_TRIGGER command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_ArmTrigger(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the TRIGGER command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_Trigger(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_STATISTICS command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetStatistics(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_ALARM command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetAlarm(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_DEADBAND command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetDeadband(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_BACKPRESSURE command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetBackpressure(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_UDP_STREAM command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetUdpStream(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the GET_SCAN_STATUS command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_GetScanStatus(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the GET_DATA_PORT_STATUS command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_GetDataPortStatus(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
+/**
+ * @internal
+ * @brief Execute the SET_GAIN_CORRECTION_STEP command with the provided parameters.
+ */
+static Tekdaqc_Command_Error_t Ex_SetGainCorrectionStep(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count);
+
 /**
  * @internal
  * @brief Execute the NONE command with the provided parameters.
@@ -789,7 +973,9 @@ static Ex_Command_Function ExecutionFunctions[NUM_COMMANDS] = {Ex_ListAnalogInpu
 		Ex_ClearDigitalOutputFault, Ex_Disconnect, Ex_Reboot, Ex_Upgrade, Ex_Identify, Ex_Sample, Ex_Halt, Ex_SetRTC,
 		Ex_SetUserMac, Ex_ClearUserMac, Ex_SetStaticIP, Ex_GetCalibrationStatus, Ex_EnterCalibrationMode,
 		Ex_WriteGainCalibrationValue, Ex_WriteCalibrationTemp, Ex_WriteCalibrationValid, Ex_ExitCalibrationMode,
-		Ex_SetFactoryMACAddr, Ex_SetBoardSerialNum, Ex_None};
+		Ex_SetFactoryMACAddr, Ex_SetBoardSerialNum, Ex_GetBufferStats, Ex_SetOutputFormat, Ex_SetSampleBatch,
+		Ex_SetTrigger, Ex_ArmTrigger, Ex_Trigger, Ex_SetStatistics, Ex_SetAlarm, Ex_SetDeadband,
+		Ex_SetBackpressure, Ex_SetUdpStream, Ex_GetScanStatus, Ex_GetDataPortStatus, Ex_SetGainCorrectionStep, Ex_None};
 
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE FUNCTIONS */
@@ -1433,7 +1619,7 @@ static Tekdaqc_Command_Error_t Ex_ListAnalogInputs(char keys[][MAX_COMMANDPART_L
 }
 
 /**
- * Execute the READ_ADC_REGISTERS command.
+ * Execute the READ_ADC_REGISTERS command. The register dump is followed by the counters of the register writes.
  *
  * @param keys char[][] C-String of the command parameter keys.
  * @param values char[][] C-String of the command parameter values.
@@ -1447,8 +1633,14 @@ static Tekdaqc_Command_Error_t Ex_ReadADCRegisters(char keys[][MAX_COMMANDPART_L
 		ClearToStringBuffer();
 		ADS1256_RegistersToString();
 		if (TOSTRING_BUFFER[0] != '\0') {
+			ADS1256_WriteStats_t adc;
 			//TelnetWriteString(TOSTRING_BUFFER);
 			TelnetWriteCommandDataMessage(TOSTRING_BUFFER);
+			ADS1256_GetWriteStats(&adc);
+			snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+					"ADC Register Writes\n\r\tBursts: %" PRIu32 "\n\r\tBytes Written: %" PRIu32 "\n\r\tBytes Saved: %"
+					PRIi32 "\n\r", adc.commits, adc.bytesWritten, adc.bytesSaved);
+			TelnetWriteCommandDataMessage(TOSTRING_BUFFER);
 			ClearToStringBuffer();
 		} else {
 			/* An error occurred */
@@ -1568,6 +1760,7 @@ static Tekdaqc_Command_Error_t Ex_ReadAnalogInputVer2(char keys[][MAX_COMMANDPAR
 		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
 	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
 	AnalogHalt();
+	AnalogTrigger_Disarm();
 	if (InputArgsCheck(keys, values, count, NUM_READ_ANALOG_INPUT_PARAMS, READ_ANALOG_INPUT_PARAMS)) {
 		numAnalogSamples = 0;
 		numOfInputs = 0;
@@ -1583,17 +1776,6 @@ static Tekdaqc_Command_Error_t Ex_ReadAnalogInputVer2(char keys[][MAX_COMMANDPAR
 #endif
 						list_type = GetChannelListType(values[index]);
 						BuildAnalogInputList(list_type, values[index]);
-						//get count of all channels to sample...
-						for (uint_fast8_t i = 0; i < NUM_ANALOG_INPUTS; ++i)
-						{
-							if (aInputs[i] != NULL)
-							{
-								if(aInputs[i]->added == CHANNEL_ADDED)
-								{
-								   numOfInputs++;
-								}
-							}
-						}
 						break;
 					case 1: /* NUMBER key */
 #ifdef COMMAND_DEBUG
@@ -1622,6 +1804,15 @@ static Tekdaqc_Command_Error_t Ex_ReadAnalogInputVer2(char keys[][MAX_COMMANDPAR
 				}
 			}
 		}
+		if (retval == ERR_COMMAND_OK) {
+			/* Compile the inputs into the scan list walked by the channel switch handler */
+			Tekdaqc_Function_Error_t error = AnalogScan_Compile(aInputs, NUM_ANALOG_INPUTS);
+			numOfInputs = AnalogScan_GetCount();
+			if (error != ERR_FUNCTION_OK) {
+				lastFunctionError = error;
+				retval = ERR_COMMAND_FUNCTION_ERROR;
+			}
+		}
 
 	} else {
 		/* We can't create a new input */
@@ -1630,7 +1821,7 @@ static Tekdaqc_Command_Error_t Ex_ReadAnalogInputVer2(char keys[][MAX_COMMANDPAR
 #endif
 		retval = ERR_COMMAND_BAD_PARAM;
 	}
-    currentAnHandlerState=1;
+    AnalogScanStart();
 	return retval;
 }
 
@@ -1719,7 +1910,32 @@ static Tekdaqc_Command_Error_t Ex_RemoveAnalogInput(char keys[][MAX_COMMANDPART_
 static Tekdaqc_Command_Error_t Ex_CheckAnalogInput(char keys[][MAX_COMMANDPART_LENGTH],
 		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
 	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
-	/* TODO: Fill in this method */
+	if (InputArgsCheck(keys, values, count, NUM_CHECK_ANALOG_INPUT_PARAMS, CHECK_ANALOG_INPUT_PARAMS)) {
+		AnalogAlarm_Config_t config;
+		Analog_Input_t* input = NULL;
+		unsigned long value;
+		char* end;
+		int8_t index = GetIndexOfArgument(keys, PARAMETER_INPUT, count);
+		if (index >= 0) {
+			value = strtoul(values[index], &end, 10);
+			if ((end != values[index]) && (*end == '\0') && (value < NUM_ANALOG_INPUTS)) {
+				input = GetAnalogInputByNumber((uint8_t) value);
+			}
+		}
+		if ((input == NULL) || (input->added == CHANNEL_NOTADDED)) {
+			lastFunctionError = ERR_AIN_INPUT_NOT_FOUND;
+			return ERR_COMMAND_FUNCTION_ERROR;
+		}
+		AnalogAlarm_GetConfig(input->physicalInput, &config);
+		snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+				"Analog Input Status\n\r\tInput: %" PRIu8 "\n\r\tStatus: %s\n\r\tAlarm: %s\n\r\tMin: %" PRIi32
+				"\n\r\tMax: %" PRIi32 "\n\r\tHysteresis: %" PRIi32 "\n\r", input->physicalInput,
+				AnalogAlarm_StatusToString(input->status), (config.enabled == TRUE) ? "ON" : "OFF", input->min,
+				input->max, config.hysteresis);
+		TelnetWriteStatusMessage(TOSTRING_BUFFER);
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
 	return retval;
 }
 
@@ -2373,6 +2589,7 @@ static Tekdaqc_Command_Error_t Ex_Sample(char keys[][MAX_COMMANDPART_LENGTH], ch
 	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
 	//halt analog...
 	AnalogHalt();
+	AnalogTrigger_Disarm();
 	DigitalInputHalt();
 	if (InputArgsCheck(keys, values, count, NUM_SAMPLE_PARAMS, SAMPLE_PARAMS)) {
 
@@ -2399,16 +2616,12 @@ static Tekdaqc_Command_Error_t Ex_Sample(char keys[][MAX_COMMANDPART_LENGTH], ch
 		}
 		if (retval == ERR_COMMAND_OK) { /* If an error occurred, don't bother continuing */
 			BuildAnalogInputList(ALL_CHANNELS, NULL);
-			//get count of all channels to sample...
-			for (uint_fast8_t i = 0; i < NUM_ANALOG_INPUTS; ++i)
-			{
-				if (aInputs[i] != NULL)
-				{
-					if(aInputs[i]->added == CHANNEL_ADDED)
-					{
-					   numOfInputs++;
-					}
-				}
+			//compile the channels to sample into the scan list...
+			Tekdaqc_Function_Error_t error = AnalogScan_Compile(aInputs, NUM_ANALOG_INPUTS);
+			numOfInputs = AnalogScan_GetCount();
+			if (error != ERR_FUNCTION_OK) {
+				lastFunctionError = error;
+				retval = ERR_COMMAND_FUNCTION_ERROR;
 			}
 			BuildDigitalInputList(ALL_CHANNELS, NULL);
 			//get count of all channels to sample...
@@ -2431,7 +2644,7 @@ static Tekdaqc_Command_Error_t Ex_Sample(char keys[][MAX_COMMANDPART_LENGTH], ch
 		retval = ERR_COMMAND_BAD_PARAM;
 	}
 	//enable analog sampling...
-	currentAnHandlerState = 1;
+	AnalogScanStart();
 	return retval;
 }
 
@@ -2451,6 +2664,7 @@ static Tekdaqc_Command_Error_t Ex_Halt(char keys[][MAX_COMMANDPART_LENGTH], char
 		/* Instruct the command state machine to halt all tasks */
 		//disable analog sampling...
 		AnalogHalt();
+		AnalogTrigger_Disarm();
 		DigitalInputHalt();
 	} else {
 		/* We received some params we weren't expecting */
@@ -2928,6 +3142,774 @@ static Tekdaqc_Command_Error_t Ex_SetBoardSerialNum(char keys[][MAX_COMMANDPART_
 	return retval;
 }
 
+/**
+ * Execute the GET_BUFFER_STATS command. Reports the counters of the analog and digital sample buffers.
+ *
+ * @param keys char[][] C-String of the command parameter keys.
+ * @param values char[][] C-String of the command parameter values.
+ * @param count uint8_t The number of command parameters.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_GetBufferStats(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_GET_BUFFER_STATS_PARAMS, GET_BUFFER_STATS_PARAMS)) {
+		RingBuffer_Statistics_t analog;
+		RingBuffer_Statistics_t digital;
+		GetAnalogSamplesBufferStats(&analog);
+		GetDigitalSamplesBufferStats(&digital);
+		snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+				"Buffer Statistics\n\r\tAnalog: Total: %" PRIu32 ", Dropped: %" PRIu32 ", High Water: %" PRIu32 "/%" PRIu32
+				"\n\r\tDigital: Total: %" PRIu32 ", Dropped: %" PRIu32 ", High Water: %" PRIu32 "/%" PRIu32 "\n\r",
+				analog.total, analog.drops, analog.highWater, analog.capacity, digital.total, digital.drops,
+				digital.highWater, digital.capacity);
+		TelnetWriteStatusMessage(TOSTRING_BUFFER);
+	} else {
+#ifdef COMMAND_DEBUG
+		printf("[Command Interpreter] Provided arguments are not valid for buffer statistics.\n\r");
+#endif
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_OUTPUT_FORMAT command with the provided parameters.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetOutputFormat(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_OUTPUT_FORMAT_PARAMS, SET_OUTPUT_FORMAT_PARAMS)) {
+		int8_t index = GetIndexOfArgument(keys, PARAMETER_FORMAT, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "ASCII") == 0) {
+				AnalogBatch_Flush(); /* Pending blocks belong to the binary stream */
+				TelnetSetDataFormat(TELNET_FORMAT_ASCII);
+			} else if (strcmp(values[index], "BINARY") == 0) {
+				TelnetSetDataFormat(TELNET_FORMAT_BINARY);
+			} else {
+#ifdef COMMAND_DEBUG
+				printf("[Command Interpreter] Unknown output format: %s\n\r", values[index]);
+#endif
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		} else {
+			retval = ERR_COMMAND_PARSE_ERROR;
+		}
+	} else {
+		retval = ERR_COMMAND_PARSE_ERROR;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_SAMPLE_BATCH command with the provided parameters. Either parameter may be omitted to keep its
+ * current value, and the resulting configuration is reported back.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetSampleBatch(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_SAMPLE_BATCH_PARAMS, SET_SAMPLE_BATCH_PARAMS)) {
+		uint32_t size = AnalogBatch_GetSize();
+		uint32_t latency = AnalogBatch_GetLatency();
+		char* end;
+		int8_t index = GetIndexOfArgument(keys, PARAMETER_SIZE, count);
+		if (index >= 0) {
+			size = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0') || !IS_ANALOG_BATCH_SIZE(size)) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_LATENCY, count);
+		if (index >= 0) {
+			latency = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0') || !IS_ANALOG_BATCH_LATENCY(latency)) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if (retval == ERR_COMMAND_OK) {
+			AnalogBatch_Configure((uint8_t) size, latency);
+			snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+					"Sample Batch\n\r\tSize: %" PRIu8 " samples\n\r\tLatency: %" PRIu32 " ms\n\r", AnalogBatch_GetSize(),
+					AnalogBatch_GetLatency());
+			TelnetWriteStatusMessage(TOSTRING_BUFFER);
+		} else {
+#ifdef COMMAND_DEBUG
+			printf("[Command Interpreter] Sample batch size must be 1 to %u and latency 1 to %u ms.\n\r",
+					DATA_FRAME_MAX_BLOCK_SAMPLES, ANALOG_BATCH_MAX_LATENCY);
+#endif
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_TRIGGER command with the provided parameters. Any parameter may be omitted to keep its current
+ * value, and the resulting configuration is reported back. The trigger can not be configured while it is armed.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetTrigger(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_TRIGGER_PARAMS, SET_TRIGGER_PARAMS)) {
+		AnalogTrigger_Config_t config;
+		unsigned long value;
+		char* end;
+		int8_t index;
+		AnalogTrigger_GetConfig(&config);
+		index = GetIndexOfArgument(keys, PARAMETER_SOURCE, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "SOFTWARE") == 0) {
+				config.source = TRIGGER_SOURCE_SOFTWARE;
+			} else if (strcmp(values[index], "DIGITAL") == 0) {
+				config.source = TRIGGER_SOURCE_DIGITAL;
+			} else if (strcmp(values[index], "ANALOG") == 0) {
+				config.source = TRIGGER_SOURCE_ANALOG;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_EDGE, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "RISING") == 0) {
+				config.edge = TRIGGER_EDGE_RISING;
+			} else if (strcmp(values[index], "FALLING") == 0) {
+				config.edge = TRIGGER_EDGE_FALLING;
+			} else if (strcmp(values[index], "EITHER") == 0) {
+				config.edge = TRIGGER_EDGE_EITHER;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_INPUT, count);
+		if (index >= 0) {
+			value = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0') || (value > UINT8_MAX)) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+			config.input = (uint8_t) value;
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_LEVEL, count);
+		if (index >= 0) {
+			config.level = (int32_t) strtol(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_PRE, count);
+		if (index >= 0) {
+			config.preSamples = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_POST, count);
+		if (index >= 0) {
+			config.postSamples = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if (retval == ERR_COMMAND_OK) {
+			if (AnalogTrigger_GetState() != TRIGGER_IDLE) {
+				retval = ERR_COMMAND_ADC_INVALID_OPERATION;
+			} else if (AnalogTrigger_Configure(&config) == FALSE) {
+#ifdef COMMAND_DEBUG
+				printf("[Command Interpreter] Trigger input must exist and the window must be under %u samples.\n\r",
+						ANALOG_TRIGGER_BUFFER_SIZE);
+#endif
+				retval = ERR_COMMAND_BAD_PARAM;
+			} else {
+				snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+						"Trigger\n\r\tSource: %s\n\r\tEdge: %s\n\r\tInput: %" PRIu8 "\n\r\tLevel: %" PRIi32
+						"\n\r\tPre-Trigger Samples: %" PRIu32 "\n\r\tPost-Trigger Samples: %" PRIu32 "\n\r",
+						AnalogTrigger_SourceToString(config.source), AnalogTrigger_EdgeToString(config.edge),
+						config.input, config.level, config.preSamples, config.postSamples);
+				TelnetWriteStatusMessage(TOSTRING_BUFFER);
+			}
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the ARM_TRIGGER command with the provided parameters. The listed analog inputs are sampled continuously, as
+ * for READ_ANALOG_INPUT, but the samples are recorded rather than streamed and only the window captured around the
+ * trigger is written out.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_ArmTrigger(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_ARM_TRIGGER_PARAMS, ARM_TRIGGER_PARAMS)) {
+		/* Without a NUMBER the read samples continuously until the window is captured */
+		retval = Ex_ReadAnalogInputVer2(keys, values, count);
+		if ((retval == ERR_COMMAND_OK) && (AnalogTrigger_Arm() == FALSE)) {
+			AnalogHalt();
+			lastFunctionError = ERR_DIN_INPUT_NOT_FOUND;
+			retval = ERR_COMMAND_FUNCTION_ERROR;
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the TRIGGER command with the provided parameters. Fires an armed software trigger.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_Trigger(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_TRIGGER_PARAMS, TRIGGER_PARAMS)) {
+		if (AnalogTrigger_Fire(GetLocalTime()) == FALSE) {
+			retval = ERR_COMMAND_ADC_INVALID_OPERATION;
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_STATISTICS command with the provided parameters. Configures the statistics window of an added
+ * analog input. Any parameter other than INPUT may be omitted to keep its current value, and the resulting
+ * configuration is reported back.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetStatistics(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_STATISTICS_PARAMS, SET_STATISTICS_PARAMS)) {
+		AnalogStatistics_Config_t config;
+		Analog_Input_t* input = NULL;
+		unsigned long value;
+		char* end;
+		int8_t index;
+		index = GetIndexOfArgument(keys, PARAMETER_INPUT, count);
+		if (index >= 0) {
+			value = strtoul(values[index], &end, 10);
+			if ((end != values[index]) && (*end == '\0') && (value < NUM_ANALOG_INPUTS)) {
+				input = GetAnalogInputByNumber((uint8_t) value);
+			}
+		}
+		if ((input == NULL) || (input->added == CHANNEL_NOTADDED)) {
+			lastFunctionError = ERR_AIN_INPUT_NOT_FOUND;
+			return ERR_COMMAND_FUNCTION_ERROR;
+		}
+		AnalogStatistics_GetConfig(input->physicalInput, &config);
+		index = GetIndexOfArgument(keys, PARAMETER_WINDOW, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "NONE") == 0) {
+				config.window = STATISTICS_WINDOW_NONE;
+			} else if (strcmp(values[index], "TUMBLING") == 0) {
+				config.window = STATISTICS_WINDOW_TUMBLING;
+			} else if (strcmp(values[index], "SLIDING") == 0) {
+				config.window = STATISTICS_WINDOW_SLIDING;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_BASIS, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "COUNT") == 0) {
+				config.basis = STATISTICS_BASIS_COUNT;
+			} else if (strcmp(values[index], "TIME") == 0) {
+				config.basis = STATISTICS_BASIS_TIME;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_SIZE, count);
+		if (index >= 0) {
+			config.size = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_STEP, count);
+		if (index >= 0) {
+			config.step = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_REPORT, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "ALL") == 0) {
+				config.report = STATISTICS_REPORT_ALL;
+			} else if (strcmp(values[index], "AGGREGATE") == 0) {
+				config.report = STATISTICS_REPORT_AGGREGATE;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if (retval == ERR_COMMAND_OK) {
+			if (AnalogStatistics_Configure(input->physicalInput, &config) == FALSE) {
+#ifdef COMMAND_DEBUG
+				printf("[Command Interpreter] A window needs a size, a sliding window a step and a deep enough history.\n\r");
+#endif
+				retval = ERR_COMMAND_BAD_PARAM;
+			} else {
+				snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+						"Statistics\n\r\tInput: %" PRIu8 "\n\r\tWindow: %s\n\r\tBasis: %s\n\r\tSize: %" PRIu32
+						"\n\r\tStep: %" PRIu32 "\n\r\tReport: %s\n\r", input->physicalInput,
+						AnalogStatistics_WindowToString(config.window), AnalogStatistics_BasisToString(config.basis),
+						config.size, config.step, AnalogStatistics_ReportToString(config.report));
+				TelnetWriteStatusMessage(TOSTRING_BUFFER);
+			}
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_ALARM command with the provided parameters. Configures the range alarm of an added analog input.
+ * Any parameter other than INPUT may be omitted to keep its current value, and the resulting configuration is
+ * reported back.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetAlarm(char keys[][MAX_COMMANDPART_LENGTH], char values[][MAX_COMMANDPART_LENGTH],
+		uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_ALARM_PARAMS, SET_ALARM_PARAMS)) {
+		AnalogAlarm_Config_t config;
+		Analog_Input_t* input = NULL;
+		unsigned long value;
+		char* end;
+		int8_t index;
+		index = GetIndexOfArgument(keys, PARAMETER_INPUT, count);
+		if (index >= 0) {
+			value = strtoul(values[index], &end, 10);
+			if ((end != values[index]) && (*end == '\0') && (value < NUM_ANALOG_INPUTS)) {
+				input = GetAnalogInputByNumber((uint8_t) value);
+			}
+		}
+		if ((input == NULL) || (input->added == CHANNEL_NOTADDED)) {
+			lastFunctionError = ERR_AIN_INPUT_NOT_FOUND;
+			return ERR_COMMAND_FUNCTION_ERROR;
+		}
+		AnalogAlarm_GetConfig(input->physicalInput, &config);
+		index = GetIndexOfArgument(keys, PARAMETER_MIN, count);
+		if (index >= 0) {
+			config.min = (int32_t) strtol(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_MAX, count);
+		if (index >= 0) {
+			config.max = (int32_t) strtol(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_HYSTERESIS, count);
+		if (index >= 0) {
+			config.hysteresis = (int32_t) strtol(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_OUTPUT, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "NONE") == 0) {
+				config.output = ANALOG_ALARM_NO_OUTPUT;
+			} else {
+				value = strtoul(values[index], &end, 10);
+				if ((end == values[index]) || (*end != '\0') || (value >= NUM_DIGITAL_OUTPUTS)) {
+					retval = ERR_COMMAND_BAD_PARAM;
+				} else {
+					config.output = (uint8_t) value;
+				}
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_STATE, count);
+		if (index >= 0) {
+			if (strcmp(values[index], "ON") == 0) {
+				config.enabled = TRUE;
+			} else if (strcmp(values[index], "OFF") == 0) {
+				config.enabled = FALSE;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if (retval == ERR_COMMAND_OK) {
+			if (AnalogAlarm_Configure(input, &config) == FALSE) {
+#ifdef COMMAND_DEBUG
+				printf("[Command Interpreter] The range must be at least as wide as a non-negative hysteresis.\n\r");
+#endif
+				retval = ERR_COMMAND_BAD_PARAM;
+			} else {
+				snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+						"Alarm\n\r\tInput: %" PRIu8 "\n\r\tState: %s\n\r\tMin: %" PRIi32 "\n\r\tMax: %" PRIi32
+						"\n\r\tHysteresis: %" PRIi32 "\n\r\tOutput: %i\n\r", input->physicalInput,
+						(config.enabled == TRUE) ? "ON" : "OFF", config.min, config.max, config.hysteresis,
+						(config.output == ANALOG_ALARM_NO_OUTPUT) ? -1 : (int) config.output);
+				TelnetWriteStatusMessage(TOSTRING_BUFFER);
+			}
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_DEADBAND command with the provided parameters. Configures the deadband of an added analog input.
+ * Any parameter other than INPUT may be omitted to keep its current value, and the resulting configuration is
+ * reported back along with the number of samples the deadband has suppressed.
+ *
+ * @param keys char[][] C-String array of the keys for the command.
+ * @param values char[][] C-String array of the values for the command.
+ * @param count uint8_t The number of key/value pairs.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetDeadband(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_DEADBAND_PARAMS, SET_DEADBAND_PARAMS)) {
+		AnalogDeadband_Config_t config;
+		Analog_Input_t* input = NULL;
+		unsigned long value;
+		char* end;
+		int8_t index;
+		bool changed = FALSE;
+		index = GetIndexOfArgument(keys, PARAMETER_INPUT, count);
+		if (index >= 0) {
+			value = strtoul(values[index], &end, 10);
+			if ((end != values[index]) && (*end == '\0') && (value < NUM_ANALOG_INPUTS)) {
+				input = GetAnalogInputByNumber((uint8_t) value);
+			}
+		}
+		if ((input == NULL) || (input->added == CHANNEL_NOTADDED)) {
+			lastFunctionError = ERR_AIN_INPUT_NOT_FOUND;
+			return ERR_COMMAND_FUNCTION_ERROR;
+		}
+		AnalogDeadband_GetConfig(input->physicalInput, &config);
+		index = GetIndexOfArgument(keys, PARAMETER_MODE, count);
+		if (index >= 0) {
+			changed = TRUE;
+			if (strcmp(values[index], "NONE") == 0) {
+				config.mode = DEADBAND_MODE_NONE;
+			} else if (strcmp(values[index], "ABSOLUTE") == 0) {
+				config.mode = DEADBAND_MODE_ABSOLUTE;
+			} else if (strcmp(values[index], "PERCENT") == 0) {
+				config.mode = DEADBAND_MODE_PERCENT;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_BAND, count);
+		if (index >= 0) {
+			changed = TRUE;
+			config.band = strtof(values[index], &end);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_HEARTBEAT, count);
+		if (index >= 0) {
+			changed = TRUE;
+			config.heartbeat = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if ((retval == ERR_COMMAND_OK) && (changed == TRUE)
+				&& (AnalogDeadband_Configure(input->physicalInput, &config) == FALSE)) {
+#ifdef COMMAND_DEBUG
+			printf("[Command Interpreter] The deadband band must not be negative.\n\r");
+#endif
+			retval = ERR_COMMAND_BAD_PARAM;
+		}
+		if (retval == ERR_COMMAND_OK) {
+			snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+					"Deadband\n\r\tInput: %" PRIu8 "\n\r\tMode: %s\n\r\tBand: %.3f\n\r\tHeartbeat: %" PRIu32
+					"\n\r\tSuppressed: %" PRIu32 "\n\r", input->physicalInput, AnalogDeadband_ModeToString(config.mode),
+					config.band, config.heartbeat, AnalogDeadband_GetSuppressed(input->physicalInput));
+			TelnetWriteStatusMessage(TOSTRING_BUFFER);
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_BACKPRESSURE command. Every parameter is optional, so the command without parameters reports the
+ * current policy and its counters.
+ *
+ * @param keys char[][] C-String of the command parameter keys.
+ * @param values char[][] C-String of the command parameter values.
+ * @param count uint8_t The number of command parameters.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetBackpressure(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_BACKPRESSURE_PARAMS, SET_BACKPRESSURE_PARAMS)) {
+		OutputBackpressure_Config_t config;
+		OutputBackpressure_Counters_t counters;
+		char* end;
+		int8_t index;
+		bool changed = FALSE;
+		OutputBackpressure_GetConfig(&config);
+		index = GetIndexOfArgument(keys, PARAMETER_POLICY, count);
+		if (index >= 0) {
+			changed = TRUE;
+			if (strcmp(values[index], "BLOCK") == 0) {
+				config.policy = BACKPRESSURE_BLOCK;
+			} else if (strcmp(values[index], "DROP_OLDEST") == 0) {
+				config.policy = BACKPRESSURE_DROP_OLDEST;
+			} else if (strcmp(values[index], "DECIMATE") == 0) {
+				config.policy = BACKPRESSURE_DECIMATE;
+			} else if (strcmp(values[index], "PAUSE") == 0) {
+				config.policy = BACKPRESSURE_PAUSE;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_TIMEOUT, count);
+		if (index >= 0) {
+			changed = TRUE;
+			config.timeout = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_DECIMATION, count);
+		if (index >= 0) {
+			changed = TRUE;
+			config.decimation = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0')) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if ((retval == ERR_COMMAND_OK) && (changed == TRUE) && (OutputBackpressure_Configure(&config) == FALSE)) {
+#ifdef COMMAND_DEBUG
+			printf("[Command Interpreter] The backpressure decimation must be at least 1.\n\r");
+#endif
+			retval = ERR_COMMAND_BAD_PARAM;
+		}
+		if (retval == ERR_COMMAND_OK) {
+			OutputBackpressure_GetCounters(&counters);
+			snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+					"Backpressure\n\r\tPolicy: %s\n\r\tTimeout: %" PRIu32 "\n\r\tDecimation: %" PRIu32
+					"\n\r\tTimeouts: %" PRIu32 "\n\r\tDropped Oldest: %" PRIu32 "\n\r\tDecimated: %" PRIu32
+					"\n\r\tPauses: %" PRIu32 "\n\r\tPaused Time: %" PRIu64 "\n\r\tOverflows: %" PRIu32
+					"\n\r\tOverruns: %" PRIu32 "\n\r\tNotices: %" PRIu32 "\n\r",
+					OutputBackpressure_PolicyToString(config.policy), config.timeout, config.decimation,
+					counters.timeouts, counters.droppedOldest, counters.decimated, counters.pauses, counters.pausedTime,
+					counters.overflows, counters.overruns, counters.notices);
+			TelnetWriteStatusMessage(TOSTRING_BUFFER);
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_UDP_STREAM command. Every parameter is optional, so the command without parameters reports the
+ * current destination and counters. While the stream is enabled all sampled data is sent over it as binary frames.
+ *
+ * @param keys char[][] C-String of the command parameter keys.
+ * @param values char[][] C-String of the command parameter values.
+ * @param count uint8_t The number of command parameters.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetUdpStream(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_UDP_STREAM_PARAMS, SET_UDP_STREAM_PARAMS)) {
+		UdpStream_Config_t config;
+		UdpStream_Statistics_t statistics;
+		unsigned long value;
+		char* end;
+		int8_t index;
+		bool changed = FALSE;
+		UdpStream_GetConfig(&config);
+		index = GetIndexOfArgument(keys, PARAMETER_ADDRESS, count);
+		if (index >= 0) {
+			changed = TRUE;
+			if (ipaddr_aton(values[index], &config.address) == 0) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_PORT, count);
+		if (index >= 0) {
+			changed = TRUE;
+			value = strtoul(values[index], &end, 10);
+			if ((end == values[index]) || (*end != '\0') || (value > UINT16_MAX)) {
+				retval = ERR_COMMAND_BAD_PARAM;
+			} else {
+				config.port = (uint16_t) value;
+			}
+		}
+		index = GetIndexOfArgument(keys, PARAMETER_STATE, count);
+		if (index >= 0) {
+			changed = TRUE;
+			if (strcmp(values[index], "ON") == 0) {
+				config.enabled = TRUE;
+			} else if (strcmp(values[index], "OFF") == 0) {
+				config.enabled = FALSE;
+			} else {
+				retval = ERR_COMMAND_BAD_PARAM;
+			}
+		}
+		if ((retval == ERR_COMMAND_OK) && (changed == TRUE) && (UdpStream_Configure(&config) == FALSE)) {
+#ifdef COMMAND_DEBUG
+			printf("[Command Interpreter] The UDP stream needs an address and port to be enabled.\n\r");
+#endif
+			retval = ERR_COMMAND_BAD_PARAM;
+		}
+		if (retval == ERR_COMMAND_OK) {
+			UdpStream_GetStatistics(&statistics);
+			snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+					"UDP Stream\n\r\tState: %s\n\r\tAddress: %s\n\r\tPort: %" PRIu16 "\n\r\tSequence: %" PRIu32
+					"\n\r\tFrames: %" PRIu32 "\n\r\tDropped: %" PRIu32 "\n\r", (config.enabled == TRUE) ? "ON" : "OFF",
+					ipaddr_ntoa(&config.address), config.port, statistics.sequence, statistics.frames,
+					statistics.drops);
+			TelnetWriteStatusMessage(TOSTRING_BUFFER);
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the GET_SCAN_STATUS command. Reports the plan of the analog scan last compiled, along with the interval
+ * the cold junction is currently read at between scan entries.
+ *
+ * @param keys char[][] C-String of the command parameter keys.
+ * @param values char[][] C-String of the command parameter values.
+ * @param count uint8_t The number of command parameters.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_GetScanStatus(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_GET_SCAN_STATUS_PARAMS, GET_SCAN_STATUS_PARAMS)) {
+		snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+				"Scan Status\n\r\tInputs: %" PRIu8 "\n\r\tRelay Hops: %" PRIu8 "\n\r\tPredicted Period (us): %" PRIu32
+				"\n\r\tFrame (us): %" PRIu32 "\n\r\tCold Junction Interval (us): %" PRIu32 "\n\r", AnalogScan_GetCount(),
+				AnalogScan_GetRelayHops(), AnalogScan_GetPredictedPeriod(), AnalogScan_GetFramePeriod(),
+				ColdJunction_PolicyGetInterval());
+		TelnetWriteStatusMessage(TOSTRING_BUFFER);
+	} else {
+#ifdef COMMAND_DEBUG
+		printf("[Command Interpreter] Provided arguments are not valid for scan status.\n\r");
+#endif
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the GET_DATA_PORT_STATUS command. Reports if the data port has a client and the counters of its transmit
+ * queue.
+ *
+ * @param keys char[][] C-String of the command parameter keys.
+ * @param values char[][] C-String of the command parameter values.
+ * @param count uint8_t The number of command parameters.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_GetDataPortStatus(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_GET_DATA_PORT_STATUS_PARAMS, GET_DATA_PORT_STATUS_PARAMS)) {
+		const TxQueue_t* data = DataServerGetTransmitQueue();
+		snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER),
+				"Data Port Status\n\r\tConnected: %s\n\r\tDropped: %" PRIu32 "\n\r\tHigh Water: %" PRIu32 "/%" PRIu32
+				"\n\r", (DataServerIsConnected() == TRUE) ? "YES" : "NO", data->drops, data->highWater,
+				DATA_SERVER_TX_NUM_BLOCKS);
+		TelnetWriteStatusMessage(TOSTRING_BUFFER);
+	} else {
+#ifdef COMMAND_DEBUG
+		printf("[Command Interpreter] Provided arguments are not valid for data port status.\n\r");
+#endif
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
+/**
+ * Execute the SET_GAIN_CORRECTION_STEP command. The step is optional, so the command without parameters reports the
+ * current step.
+ *
+ * @param keys char[][] C-String of the command parameter keys.
+ * @param values char[][] C-String of the command parameter values.
+ * @param count uint8_t The number of command parameters.
+ * @retval Tekdaqc_Command_Error_t The command error status.
+ */
+static Tekdaqc_Command_Error_t Ex_SetGainCorrectionStep(char keys[][MAX_COMMANDPART_LENGTH],
+		char values[][MAX_COMMANDPART_LENGTH], uint8_t count) {
+	Tekdaqc_Command_Error_t retval = ERR_COMMAND_OK;
+	if (InputArgsCheck(keys, values, count, NUM_SET_GAIN_CORRECTION_STEP_PARAMS, SET_GAIN_CORRECTION_STEP_PARAMS)) {
+		char* end;
+		float step;
+		int8_t index = GetIndexOfArgument(keys, PARAMETER_STEP, count);
+		if (index >= 0) {
+			step = strtof(values[index], &end);
+			if ((end == values[index]) || (*end != '\0') || (step < 0.0f)) {
+#ifdef COMMAND_DEBUG
+				printf("[Command Interpreter] The gain correction step must be a temperature of at least 0.\n\r");
+#endif
+				retval = ERR_COMMAND_BAD_PARAM;
+			} else {
+				Tekdaqc_SetGainCorrectionStep(step);
+			}
+		}
+		if (retval == ERR_COMMAND_OK) {
+			snprintf(TOSTRING_BUFFER, sizeof(TOSTRING_BUFFER), "Gain Correction\n\r\tStep: %.3f\n\r",
+					Tekdaqc_GetGainCorrectionStep());
+			TelnetWriteStatusMessage(TOSTRING_BUFFER);
+		}
+	} else {
+		retval = ERR_COMMAND_BAD_PARAM;
+	}
+	return retval;
+}
+
 /**
  * Execute the NONE command.
  *
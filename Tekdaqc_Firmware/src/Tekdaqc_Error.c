@@ -87,6 +87,6 @@ const char* Tekdaqc_FunctionError_ToString(Tekdaqc_Function_Error_t error) {
 			"DOUT: OUTPUT OUT OF RANGE", "DOUT: PARSE MISSING KEY", "OUT: OUTPUT NOT FOUND", "DOUT: PARSE ERROR",
 			"DOUT: OUTPUT EXISTS", "DOUT: OUTPUT UNSPECIFIED", "DOUT: DOES NOT EXIST", "DOUT: FAILED WRITE",
 			"CALIBRATION: MODE ENTRY FAILED", "CALIBRATION: WRITE FAILED", "CALIBRATION: PARSE ERROR",
-			"CALIBRATION: PARSE MISSING KEY"};
+			"CALIBRATION: PARSE MISSING KEY", "AIN: HISTORY FULL", "AIN: SCAN INFEASIBLE"};
 	return strings[error];
 }
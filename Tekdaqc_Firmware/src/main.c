@@ -17,6 +17,8 @@
 #include "netconf.h"
 #include "stm32f4xx_it.h"
 #include "TelnetServer.h"
+#include "DataServer.h"
+#include "Tekdaqc_UdpStream.h"
 #include "Tekdaqc_Locator.h"
 #include "Tekdaqc_CommandInterpreter.h"
 #include "Tekdaqc_CalibrationTable.h"
@@ -24,9 +26,13 @@
 #include "Tekdaqc_RTC.h"
 #include "CommandState.h"
 #include "ADS1256_SPI_Controller.h"
+#include "ADS1256_SPI_DMA.h"
 #include "Tekdaqc_Error.h"
 #include "Tekdaqc_Version.h"
 #include "ADS1256_Driver.h"
+#include "Tekdaqc_Timestamp.h"
+#include "Analog_Trigger.h"
+#include "Output_Backpressure.h"
 #include <stdio.h>
 #include <inttypes.h>
 
@@ -118,7 +124,8 @@ int main(void) {
 
 	Init_Locator();
 
-	if (InitializeTelnetServer() == TELNET_OK) {
+	if ((InitializeTelnetServer() == TELNET_OK) && (InitializeDataServer() == DATA_SERVER_OK)) {
+		UdpStream_Init();
 		CreateCommandInterpreter();
 		Tekdaqc_Initialized(true);
 
@@ -167,10 +174,16 @@ static void program_loop(void) {
 		}
 		//lfao - write to telnet the analog samples data...
 		WriteToTelnet_Analog();
+		/* Watch the trigger inputs and write out any captured window */
+		AnalogTrigger_Service();
 		//lfao - read digital inputs
 		ReadDigitalInputs();
 		//lfao - write to telnet the digital inputs data...
 		WriteToTelnet_Digital();
+		/* Send any part filled UDP datagram which has waited long enough */
+		UdpStream_Service();
+		/* Report shed data and release held acquisition once the connection catches up */
+		OutputBackpressure_Service();
 	}
 
 	/* Check to see if any faults have occurred */
@@ -204,6 +217,8 @@ static void Tekdaqc_Init(void) {
 	InitializeShortDelayTimer();
 	//lfao- initialize the timer for channel switching...
 	InitializeChannelSwitchTimer();
+	/* Initialize the DMA engine for reading ADS1256 conversions */
+	ADS1256_DMA_Init();
 
 	/* Initialize the FLASH disk */
 	FlashDiskInit();
@@ -224,6 +239,9 @@ static void Tekdaqc_Init(void) {
 	/* Initialize the digital outputs */
 	DigitalOutputsInit();
 
+	/* Select the default output backpressure policy */
+	OutputBackpressure_Init();
+
 	/* Set the write functions */
 	SetAnalogInputWriteFunction(&TelnetWriteString);
 	SetDigitalInputWriteFunction(&TelnetWriteString);
@@ -247,6 +265,9 @@ static void Tekdaqc_Init(void) {
 	// Initialize the watchdog timer
 	Watchdog_Init();
 #endif
+
+	/* Start the sample time base, after the watchdog is done borrowing its timer */
+	Timestamp_Init();
 }
 
 #ifdef  USE_FULL_ASSERT
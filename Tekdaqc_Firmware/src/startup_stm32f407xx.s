@@ -62,6 +62,16 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* start address for the initialization values of the .ccmram section. defined in linker script */
+.word  _siccmram
+/* start address for the .ccmram section. defined in linker script */
+.word  _sccmram
+/* end address for the .ccmram section. defined in linker script */
+.word  _eccmram
+/* start address for the .ccmbss section. defined in linker script */
+.word  _sccmbss
+/* end address for the .ccmbss section. defined in linker script */
+.word  _eccmbss
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
 /**
@@ -107,6 +117,34 @@ LoopFillZerobss:
   cmp  r2, r3
   bcc  FillZerobss
 
+/* Copy the ccmram segment initializers from flash to CCM */
+  movs  r1, #0
+  b  LoopCopyCcmInit
+
+CopyCcmInit:
+  ldr  r3, =_siccmram
+  ldr  r3, [r3, r1]
+  str  r3, [r0, r1]
+  adds  r1, r1, #4
+
+LoopCopyCcmInit:
+  ldr  r0, =_sccmram
+  ldr  r3, =_eccmram
+  adds  r2, r0, r1
+  cmp  r2, r3
+  bcc  CopyCcmInit
+  ldr  r2, =_sccmbss
+  b  LoopFillZeroCcmbss
+/* Zero fill the ccmbss segment. */
+FillZeroCcmbss:
+  movs  r3, #0
+  str  r3, [r2], #4
+
+LoopFillZeroCcmbss:
+  ldr  r3, = _eccmbss
+  cmp  r2, r3
+  bcc  FillZeroCcmbss
+
 /* Call the clock system intitialization function.*/
   bl  SystemInit   
 /* Call static constructors */
@@ -39,13 +39,11 @@
 #include "netconf.h"
 #include "Tekdaqc_CAN.h"
 #include "Analog_Input.h"
+#include "ADS1256_SPI_DMA.h"
+#include "Tekdaqc_Timestamp.h"
 #include <stdio.h>
 #include <inttypes.h>
 
-//lfao-these variables are used by the DRDY interrupt handler for it to know which channel is sampling and
-//the number of samples to take...
-extern volatile int viCurrentChannel;
-extern volatile int viSamplesToTake;
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
@@ -217,7 +215,6 @@ void EXTI15_10_IRQHandler(void) {
 void EXTI15_10_IRQHandler(void)
 {
 	uint8_t ads1256data[3];
-	Analog_Samples_t newAnalogSample;
 
 	if (EXTI_GetITStatus(EXTI_Line10) != RESET)
 	{
@@ -227,6 +224,21 @@ void EXTI15_10_IRQHandler(void)
 		// Clear interrupt pending bit
 		EXTI_ClearITPendingBit(EXTI_Line10);
 
+		if (ADS1256_GetReadMode() == ADS1256_READ_DMA)
+		{
+			/* The sample is delivered to AnalogSampleReady() when the read completes */
+			ADS1256_DMA_StartRead();
+			return;
+		}
+
+		if (ADS1256_GetContinuousReadState() != ADS1256_CONTINUOUS_OFF)
+		{
+			/* RDATAC mode, no command or t6 delay is needed */
+			ADS1256_ReadDataContinuous(ads1256data);
+			AnalogSampleReady((uint32_t)(ads1256data[0]<<16 | ads1256data[1]<<8 | ads1256data[2]));
+			return;
+		}
+
 		/****Get ADS1256 reading routine******/
 		ADS1256_CS_LOW(); /* Enable SPI communication */
 		ADS1256_SendByte(ADS1256_RDATA); /* Send RDATA command byte */
@@ -238,27 +250,38 @@ void EXTI15_10_IRQHandler(void)
 		ADS1256_CS_HIGH(); /* Latch SPI communication */
 		ShortDelayUS(2);
 		//Delay_us((uint64_t) (4U * ADS1256_CLK_PERIOD_US)); /*  timing characteristic t11 */
-		newAnalogSample.iChannel = viCurrentChannel;
-		newAnalogSample.iReading = (uint32_t)(ads1256data[0]<<16 | ads1256data[1]<<8 | ads1256data[2]);
-		newAnalogSample.ui64TimeStamp = GetLocalTime();
-		WriteSampleToBuffer(&newAnalogSample);
-		//lfao - infinite sampling, do nothing, just let it run, else disable this interrupt...
-		if(viSamplesToTake!=-1)
-		{
-			viSamplesToTake--;
-			if(viSamplesToTake==0)
-			{
-				ADS1256_EXTI_Disable();
-			}
-		}
+		AnalogSampleReady((uint32_t)(ads1256data[0]<<16 | ads1256data[1]<<8 | ads1256data[2]));
 		/*************************************************/
 
 	}
 }
 
+/**
+ * @brief  This function handles the ADS1256 SPI receive DMA stream interrupt request.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Stream3_IRQHandler(void)
+{
+	ADS1256_DMA_RX_IRQHandler();
+}
 
+/**
+ * @brief  This function handles the ADS1256 DMA read engine timer interrupt request.
+ * @param  None
+ * @retval None
+ */
+void TIM7_IRQHandler(void)
+{
+	ADS1256_DMA_Timer_IRQHandler();
+}
 
 void TIM5_IRQHandler(void) {
+	if (TIM_GetITStatus(TIM5, TIM_IT_Update) != RESET) {
+		// Clear the update pending bit before counting the wrap
+		TIM_ClearITPendingBit(TIM5, TIM_IT_Update);
+		Timestamp_Overflow();
+	}
 	if (TIM_GetITStatus(TIM5, TIM_IT_CC4) != RESET) {
 		// Get the Input Capture value
 		tmpCC4[LSICaptureNumber++] = TIM_GetCapture4(TIM5);
@@ -57,6 +57,12 @@ extern "C" {
 */
 #define ADS1256_DUMMY_BYTE ((uint8_t) 0x00)
 
+/**
+* @def ADS1256_REGISTER_IMAGE_SIZE
+* @brief The number of registers in a register image, STATUS through FSC2.
+*/
+#define ADS1256_REGISTER_IMAGE_SIZE ((uint8_t) 11U)
+
 /** @defgroup status_register STATUS Register
   * @{
   */
@@ -534,6 +540,28 @@ typedef enum {
 #define IS_ADS1256_REGISTER_COMMAND(CMD) (((CMD) == ADS1256_RREG)|| \
   ((CMD) == ADS1256_WREG))
 
+/**
+* @brief ADS1256 continuous read state enumeration.
+* Defines the states of the ADS1256 Read Data Continuous (RDATAC) mode.
+*/
+typedef enum {
+  ADS1256_CONTINUOUS_OFF, /**< Each conversion is read with an RDATA command. */
+  ADS1256_CONTINUOUS_PENDING, /**< The next conversion read will issue RDATAC instead of RDATA. */
+  ADS1256_CONTINUOUS_ON /**< The ADS1256 is in RDATAC mode. Conversions are read without a command. */
+} ADS1256_Continuous_t;
+
+/**
+* @brief Register write statistics.
+* Counts the WREG bursts sent by ADS1256_Commit() against the SPI traffic the same register set calls would have
+* produced if each had been written straight through with its own WREG command.
+*/
+typedef struct {
+  uint32_t commits; /**< The number of WREG bursts sent. */
+  uint32_t bytesRequested; /**< The SPI bytes the set calls would have sent, including command bytes. */
+  uint32_t bytesWritten; /**< The SPI bytes actually sent, including command bytes. */
+  int32_t bytesSaved; /**< bytesRequested less bytesWritten. */
+} ADS1256_WriteStats_t;
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* INITIALIZATION METHODS */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -551,6 +579,21 @@ void ADS1256_EXTI_Disable(void);
 void ADS1256_EXTI_Enable(void);
 void InitializeShortDelayTimer(void);
 void InitializeChannelSwitchTimer(void);
+
+/**
+ * @brief Arms the channel switch timer to run the channel switch handler once after a delay.
+ */
+void ArmChannelSwitchTimer(uint32_t delay);
+
+/**
+ * @brief Runs the channel switch handler as soon as possible.
+ */
+void TriggerChannelSwitch(void);
+
+/**
+ * @brief Cancels any armed delay of the channel switch timer.
+ */
+void CancelChannelSwitchTimer(void);
 void ShortDelayUS(uint32_t Delay);
 /*--------------------------------------------------------------------------------------------------------*/
 /* STRING METHODS */
@@ -672,6 +715,26 @@ void ADS1256_Wakeup(void);
  */
 void ADS1256_Standby(void);
 
+/**
+ * @brief Enable or disable Read Data Continuous (RDATAC) mode.
+ */
+void ADS1256_SetContinuousRead(bool enable);
+
+/**
+ * @brief Retrieve the state of Read Data Continuous (RDATAC) mode.
+ */
+ADS1256_Continuous_t ADS1256_GetContinuousReadState(void);
+
+/**
+ * @brief Record that RDATAC has been sent by a read engine other than this driver.
+ */
+void ADS1256_ContinuousReadStarted(void);
+
+/**
+ * @brief Read the 3-byte data while Read Data Continuous mode is enabled.
+ */
+void ADS1256_ReadDataContinuous(uint8_t* data);
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* CALIBRATION METHODS */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -734,6 +797,11 @@ float ADS1256_GetSystemGainCalTime(void);
  */
 float ADS1256_GetSettlingTime(void);
 
+/**
+ * @brief Retrieves the settling time of the ADC for a data rate.
+ */
+uint32_t ADS1256_GetSettlingTimeForRate(ADS1256_SPS_t sps);
+
 /**
  * @brief Selects remote register auto-fetch behavior.
  */
@@ -907,6 +975,40 @@ uint32_t ADS1256_GetGainCalSetting(void);
  */
 void ADS1256_SetGainCalSetting(uint8_t* value);
 
+/*--------------------------------------------------------------------------------------------------------*/
+/* REGISTER IMAGE METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Builds a register image for a complete sampling configuration.
+ */
+void ADS1256_BuildRegisterImage(uint8_t* image, ADS1256_AIN_t pos, ADS1256_AIN_t neg, ADS1256_BUFFER_t buffer,
+		ADS1256_PGA_t gain, ADS1256_SPS_t sps, uint32_t offset_cal, uint32_t gain_cal);
+
+/**
+ * @brief Writes a register image to the ADC in a single burst.
+ */
+bool ADS1256_LoadRegisterImage(const uint8_t* image, bool force);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* REGISTER COMMIT METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Writes any changed registers to the ADC in a single burst.
+ */
+bool ADS1256_Commit(void);
+
+/**
+ * @brief Retrieves the register write statistics.
+ */
+void ADS1256_GetWriteStats(ADS1256_WriteStats_t* stats);
+
+/**
+ * @brief Clears the register write statistics.
+ */
+void ADS1256_ResetWriteStats(void);
+
 /**
  * @}
  */
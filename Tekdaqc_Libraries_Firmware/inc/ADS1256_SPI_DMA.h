@@ -0,0 +1,138 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file ADS1256_SPI_DMA.h
+ * @brief Header file for the ADS1256 DMA read engine.
+ *
+ * Reads conversion results from the ADS1256 using SPI DMA transfers chained off of the DRDY interrupt and a one
+ * shot timer, so that the CPU is not held in the DRDY interrupt for the duration of the read.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ADS1256_SPI_DMA_H_
+#define ADS1256_SPI_DMA_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "Tekdaqc_Debug.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup ads1256_driver ADS1256 Driver
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief ADS1256 data read mode enumeration.
+ * Defines the methods available for reading a conversion result out of the ADS1256 when DRDY is asserted.
+ */
+typedef enum {
+	ADS1256_READ_POLLED, /**< The conversion is read inside the DRDY interrupt with blocking SPI transfers. */
+	ADS1256_READ_DMA /**< The conversion is read with SPI DMA transfers, completing in the DMA interrupt. */
+} ADS1256_ReadMode_t;
+
+/**
+ * @brief Callback invoked when a DMA read of a conversion result has completed.
+ * The parameter is the raw, right justified 24 bit reading.
+ */
+typedef void (*ADS1256_DMA_Callback_t)(uint32_t reading);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INITIALIZATION METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Initialize the DMA streams and timer used by the DMA read engine.
+ */
+void ADS1256_DMA_Init(void);
+
+/**
+ * @brief Sets the function to call with each completed reading.
+ */
+void ADS1256_DMA_SetCompleteCallback(ADS1256_DMA_Callback_t callback);
+
+/**
+ * @brief Selects how conversion results are read from the ADS1256.
+ */
+void ADS1256_SetReadMode(ADS1256_ReadMode_t mode);
+
+/**
+ * @brief Retrieves the method used to read conversion results from the ADS1256.
+ */
+ADS1256_ReadMode_t ADS1256_GetReadMode(void);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* AQUISITION METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Begins a DMA read of the current conversion result.
+ */
+bool ADS1256_DMA_StartRead(void);
+
+/**
+ * @brief Indicates if a DMA read is currently in progress.
+ */
+bool ADS1256_DMA_IsBusy(void);
+
+/**
+ * @brief Retrieves the number of DRDY events which were missed because a read was still in progress.
+ */
+uint32_t ADS1256_DMA_GetOverrunCount(void);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INTERRUPT HANDLERS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Services the SPI receive DMA stream interrupt.
+ */
+void ADS1256_DMA_RX_IRQHandler(void);
+
+/**
+ * @brief Services the read engine's one shot timer interrupt.
+ */
+void ADS1256_DMA_Timer_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ADS1256_SPI_DMA_H_ */
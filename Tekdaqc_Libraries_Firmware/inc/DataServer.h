@@ -0,0 +1,137 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file DataServer.h
+ * @brief Header file for the binary sample data server.
+ *
+ * Contains public definitions and data types for a TCP server which carries sampled data only. The stream is made
+ * of the frames described in Tekdaqc_DataFrame.h, with no telnet option processing or escaping, and has its own
+ * transmit queue so command replies on the telnet connection never wait behind it.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DATA_SERVER_H_
+#define DATA_SERVER_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "Tekdaqc_Debug.h"
+#include <boolean.h>
+#include "lwip/tcp.h"
+#include "Tekdaqc_TxQueue.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup data_server Data Server
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def DATA_SERVER_TX_NUM_BLOCKS
+ * @brief The number of blocks in the data server transmit queue. Sized to match the send buffer, 8 blocks of TCP_MSS
+ * being exactly TCP_SND_BUF, so a client with a full window has every block unacknowledged.
+ */
+#define DATA_SERVER_TX_NUM_BLOCKS 8U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Data server status enumeration.
+ * The possible success/error causes for the data server's operation.
+ */
+typedef enum {
+	DATA_SERVER_OK, /**< Everything is normal with the data server. */
+	DATA_SERVER_ERR_BIND, /**< There was an error binding a socket to a port for the data server. */
+	DATA_SERVER_ERR_PCBCREATE /**< There was an error creating a PCB structure for the data server. */
+} DataServerStatus_t;
+
+/**
+ * @brief Data structure to hold the state of the data server.
+ */
+typedef struct {
+	struct tcp_pcb* pcb; /**< A pointer to the data session PCB, NULL if no client is connected. */
+	TxQueue_t transmit; /**< The queue of data to be transmitted to the data client. */
+} DataServer_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Creates the TCP port for the data server and starts listening on it.
+ */
+DataServerStatus_t InitializeDataServer(void);
+
+/**
+ * @brief Closes the data connection, if any.
+ */
+void DataServerClose(void);
+
+/**
+ * @brief Indicates if a client is connected to the data server.
+ */
+bool DataServerIsConnected(void);
+
+/**
+ * @brief Writes a block of binary data to the data connection.
+ */
+void DataServerWriteBuffer(const uint8_t* data, uint32_t length);
+
+/**
+ * @brief Retrieves the number of bytes which can be written without waiting for the client.
+ */
+uint32_t DataServerGetWriteSpace(void);
+
+/**
+ * @brief Waits for room to write the specified number of bytes.
+ */
+bool DataServerWaitWriteSpace(uint32_t length, uint32_t timeout);
+
+/**
+ * @brief Retrieves the transmit queue of the data connection, for its statistics.
+ */
+const TxQueue_t* DataServerGetTransmitQueue(void);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DATA_SERVER_H_ */
@@ -123,6 +123,12 @@ extern "C" {
  */
 #define TELNET_PORT 9801U
 
+/**
+ * @def DATA_PORT
+ * @brief The port to use for the binary sample data server.
+ */
+#define DATA_PORT 9802U
+
 /**
  * @}
  */
@@ -360,6 +366,8 @@ typedef enum {
 #define ADS1256_DRDY_PIN					(GPIO_Pin_10)
 #define ADS1256_DRDY_GPIO_PORT				(GPIOA)
 #define ADS1256_DRDY_GPIO_CLK				(RCC_AHB1Periph_GPIOA)
+#define ADS1256_DRDY_SOURCE					(GPIO_PinSource10)
+#define ADS1256_DRDY_AF						(GPIO_AF_TIM1)
 
 #define ADS1256_SYNC_PIN					(GPIO_Pin_12)
 #define ADS1256_SYNC_GPIO_PORT				(GPIOA)
@@ -369,6 +377,43 @@ typedef enum {
 #define ADS1256_RESET_GPIO_PORT				(GPIOH)
 #define ADS1256_RESET_GPIO_CLK				(RCC_AHB1Periph_GPIOH)
 
+/* ADS1256 SPI DMA read engine */
+#define ADS1256_SPI_DMA_CLK					(RCC_AHB1Periph_DMA1)
+#define ADS1256_SPI_DMA_CHANNEL				(DMA_Channel_0)
+
+#define ADS1256_SPI_RX_DMA_STREAM			(DMA1_Stream3)
+#define ADS1256_SPI_RX_DMA_FLAGS			(DMA_FLAG_TCIF3 | DMA_FLAG_HTIF3 | DMA_FLAG_TEIF3 | DMA_FLAG_DMEIF3 | DMA_FLAG_FEIF3)
+#define ADS1256_SPI_RX_DMA_TC_IT			(DMA_IT_TCIF3)
+#define ADS1256_SPI_RX_DMA_IRQn				(DMA1_Stream3_IRQn)
+
+#define ADS1256_SPI_TX_DMA_STREAM			(DMA1_Stream4)
+#define ADS1256_SPI_TX_DMA_FLAGS			(DMA_FLAG_TCIF4 | DMA_FLAG_HTIF4 | DMA_FLAG_TEIF4 | DMA_FLAG_DMEIF4 | DMA_FLAG_FEIF4)
+
+#define ADS1256_DMA_TIMER					(TIM7)
+#define ADS1256_DMA_TIMER_CLK				(RCC_APB1Periph_TIM7)
+#define ADS1256_DMA_TIMER_IRQn				(TIM7_IRQn)
+
+/* DRDY timestamping. The capture timer is the one PA10 can reach, the time base is a free 32 bit timer */
+#define DRDY_CAPTURE_TIMER					(TIM1)
+#define DRDY_CAPTURE_TIMER_CLK				(RCC_APB2Periph_TIM1)
+#define DRDY_CAPTURE_CHANNEL				(TIM_Channel_3)
+
+#define TIMESTAMP_TIMER						(TIM5)
+#define TIMESTAMP_TIMER_CLK					(RCC_APB1Periph_TIM5)
+#define TIMESTAMP_TIMER_IRQn				(TIM5_IRQn)
+
+/**
+ * @def ADS1256_DMA_T6_DELAY_US
+ * @brief Delay between the RDATA command and the first data clock (timing characteristic t6, 50 tCLKIN), rounded up.
+ */
+#define ADS1256_DMA_T6_DELAY_US				7U
+
+/**
+ * @def ADS1256_DMA_T10_DELAY_US
+ * @brief Delay between the last data clock and releasing chip select (timing characteristic t10, 8 tCLKIN), rounded up.
+ */
+#define ADS1256_DMA_T10_DELAY_US			2U
+
 #define EXT_ANALOG_IN_MUX_PINS				(GPIO_Pin_15 | GPIO_Pin_14 | GPIO_Pin_13 | GPIO_Pin_12 | GPIO_Pin_11)
 #define EXT_ANALOG_IN_MUX_PORT				(GPIOD)
 #define EXT_ANALOG_IN_GPIO_CLK				(RCC_AHB1Periph_GPIOD)
@@ -38,6 +38,16 @@ extern "C" {
 #include "ADS1256_Driver.h"
 #include <boolean.h>
 
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def GAIN_CORRECTION_CACHE_STEP
+ * @brief The default change in board temperature, in degrees C, which invalidates the cached gain corrections.
+ */
+#define GAIN_CORRECTION_CACHE_STEP		(0.25f)
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* PUBLIC METHODS */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -82,6 +92,31 @@ uint32_t Tekdaqc_GetGainCalibration(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1
  */
 float Tekdaqc_GetGainCorrectionFactor(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1256_BUFFER_t buffer, float temperature);
 
+/**
+ * @brief Retrieves a cached Q1.31 gain calibration correction for the specified parameters.
+ */
+int32_t Tekdaqc_GetCachedGainCorrection(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1256_BUFFER_t buffer);
+
+/**
+ * @brief Provides a new board temperature to the gain correction cache.
+ */
+void Tekdaqc_UpdateGainCorrectionTemperature(float temperature);
+
+/**
+ * @brief Sets the change in board temperature which invalidates the gain correction cache.
+ */
+void Tekdaqc_SetGainCorrectionStep(float step);
+
+/**
+ * @brief Retrieves the change in board temperature which invalidates the gain correction cache.
+ */
+float Tekdaqc_GetGainCorrectionStep(void);
+
+/**
+ * @brief Discards every cached gain correction.
+ */
+void Tekdaqc_InvalidateGainCorrectionCache(void);
+
 /**
  * @brief Retrieves an offset calibration value for the specified parameters.
  */
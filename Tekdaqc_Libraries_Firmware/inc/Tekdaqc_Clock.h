@@ -0,0 +1,176 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_Clock.h
+ * @brief Header file for the Tekdaqc's monotonic clock.
+ *
+ * Contains public definitions and data types for the local time clock, which is kept by the Cortex-M4 DWT cycle
+ * counter, extended to 64 bits and disciplined against a slower reference such as the RTC.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_CLOCK_H_
+#define TEKDAQC_CLOCK_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_clock Tekdaqc Clock
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def CLOCK_CYCLES_PER_US
+ * @brief The number of core clock cycles per microsecond.
+ */
+#define CLOCK_CYCLES_PER_US				168U
+
+/**
+ * @def CLOCK_SCALE_SHIFT
+ * @brief The number of fractional bits in the microseconds per cycle scale.
+ */
+#define CLOCK_SCALE_SHIFT				36U
+
+/**
+ * @def CLOCK_NOMINAL_SCALE
+ * @brief The microseconds per cycle scale of an untrimmed clock.
+ */
+#define CLOCK_NOMINAL_SCALE				((uint32_t) (((((uint64_t) 1U) << CLOCK_SCALE_SHIFT) + (CLOCK_CYCLES_PER_US / 2U)) / CLOCK_CYCLES_PER_US))
+
+/**
+ * @def CLOCK_ANCHOR_STEP
+ * @brief The number of cycles the anchor is moved forward by at a time, which bounds the products in the conversion to
+ * 64 bits.
+ */
+#define CLOCK_ANCHOR_STEP				(((uint64_t) 1U) << 28U)
+
+/**
+ * @def CLOCK_DISCIPLINE_INTERVAL
+ * @brief The time between comparisons against the reference, in microseconds.
+ */
+#define CLOCK_DISCIPLINE_INTERVAL		10000000U
+
+/**
+ * @def CLOCK_STEP_THRESHOLD
+ * @brief The largest error against the reference which is slewed out rather than stepped, in microseconds.
+ */
+#define CLOCK_STEP_THRESHOLD			100000
+
+/**
+ * @def CLOCK_MAX_TRIM
+ * @brief The largest rate correction applied to the clock, in parts per billion.
+ */
+#define CLOCK_MAX_TRIM					500000
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Clock time base.
+ * Everything needed to turn a reading of the 32 bit cycle counter into local time. Time is counted from an anchor,
+ * which is walked forward as the counter runs so that the arithmetic stays within 64 bits.
+ */
+typedef struct {
+	uint32_t cycleHigh; /**< The number of times the cycle counter has wrapped. */
+	uint32_t lastCycles; /**< The cycle counter at the last update. */
+	uint64_t anchorCycles; /**< The extended cycle count at the anchor. */
+	uint64_t anchorTime; /**< The local time at the anchor, in microseconds. */
+	uint64_t anchorFraction; /**< The fractional microseconds at the anchor, in CLOCK_SCALE_SHIFT bits. */
+	uint32_t scale; /**< The microseconds per cycle, in CLOCK_SCALE_SHIFT fractional bits. */
+	int32_t frequency; /**< The learned rate error of the cycle counter against the reference, in parts per billion. */
+} Clock_Timebase_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Initializes a time base to a time at a cycle count.
+ */
+void Clock_TimebaseInit(Clock_Timebase_t* base, uint32_t cycles, uint64_t time);
+
+/**
+ * @brief Extends a cycle counter reading to 64 bits.
+ */
+uint64_t Clock_TimebaseExtend(const Clock_Timebase_t* base, uint32_t cycles);
+
+/**
+ * @brief Records a cycle counter reading, counting wraps and moving the anchor forward.
+ */
+uint64_t Clock_TimebaseAdvance(Clock_Timebase_t* base, uint32_t cycles);
+
+/**
+ * @brief Converts an extended cycle count into local time.
+ */
+uint64_t Clock_TimebaseToTime(const Clock_Timebase_t* base, uint64_t cycles);
+
+/**
+ * @brief Corrects a time base against a reference time.
+ */
+void Clock_TimebaseDiscipline(Clock_Timebase_t* base, uint64_t cycles, uint64_t reference);
+
+/**
+ * @brief Starts the cycle counter and sets the clock.
+ */
+void Clock_Init(uint64_t time);
+
+/**
+ * @brief Keeps the clock's extension current. Called periodically.
+ */
+bool Clock_Update(void);
+
+/**
+ * @brief Corrects the clock against a reference time.
+ */
+void Clock_Discipline(uint64_t reference);
+
+/**
+ * @brief Retrieves the current local time.
+ */
+uint64_t Clock_GetTime(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_CLOCK_H_ */
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_DataFrame.h
+ * @brief Header file for the Tekdaqc binary data frame encoder.
+ *
+ * Contains public definitions and data types for encoding samples into the binary streaming format. Every frame
+ * has the layout below, with all multi-byte fields little endian:
+ *
+ * | Offset | Size | Field                                  |
+ * |--------|------|----------------------------------------|
+ * | 0      | 1    | Sync byte, DATA_FRAME_SYNC             |
+ * | 1      | 1    | Frame type, DataFrame_Type_t           |
+ * | 2      | 2    | Payload length in bytes                |
+ * | 4      | n    | Payload                                |
+ * | 4 + n  | 2    | CRC-16/CCITT of bytes 0 to 3 + n       |
+ *
+ * Sample payloads are a 1 byte physical channel, a 7 byte timestamp in microseconds since the UNIX epoch and then
+ * the value, which is 3 bytes for DATA_FRAME_ANALOG_24, 4 bytes for DATA_FRAME_ANALOG_32 and 1 byte for
+ * DATA_FRAME_DIGITAL.
+ *
+ * A DATA_FRAME_ANALOG_BLOCK payload carries several samples of one channel. It is a 1 byte physical channel, a 1 byte
+ * sample count, a 1 byte set of DATA_FRAME_BLOCK_* flags and the 7 byte timestamp of the first sample. The timing of
+ * the remaining samples follows: a single period if DATA_FRAME_BLOCK_FIXED_RATE is set, otherwise one delta from the
+ * previous sample per remaining sample. These are 4 bytes each if DATA_FRAME_BLOCK_WIDE_DELTAS is set and 2 bytes
+ * otherwise. The values come last, 4 bytes each if DATA_FRAME_BLOCK_WIDE_VALUES is set and 3 bytes otherwise.
+ *
+ * A DATA_FRAME_ANALOG_STATISTICS payload summarizes a window of samples of one channel. It is a 1 byte physical
+ * channel, the 7 byte timestamps of the first and last samples, a 4 byte sample count, the 4 byte minimum and maximum
+ * values and then the mean, RMS and standard deviation as 4 byte IEEE-754 single precision floats.
+ *
+ * A DATA_FRAME_ANALOG_ALARM payload reports a channel moving between range states. It is a 1 byte physical channel,
+ * the 7 byte timestamp of the sample which caused the transition, the 1 byte new state (0 below range, 1 in range,
+ * 2 above range) and the 4 byte sample value.
+ *
+ * A DATA_FRAME_SHED payload reports data which was not written because the connection could not keep up. It is the
+ * 7 byte timestamp of the report, the 1 byte output backpressure policy which shed the data and the 4 byte number of
+ * records shed since the previous report.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_DATAFRAME_H_
+#define TEKDAQC_DATAFRAME_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_data_frame Tekdaqc Data Frame
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def DATA_FRAME_SYNC
+ * @brief The first byte of every frame. It can not occur in the ASCII messages sharing the connection.
+ */
+#define DATA_FRAME_SYNC					((uint8_t) 0xA5U)
+
+/**
+ * @def DATA_FRAME_HEADER_SIZE
+ * @brief The number of bytes preceding the payload of a frame.
+ */
+#define DATA_FRAME_HEADER_SIZE			4U
+
+/**
+ * @def DATA_FRAME_CRC_SIZE
+ * @brief The number of bytes following the payload of a frame.
+ */
+#define DATA_FRAME_CRC_SIZE				2U
+
+/**
+ * @def DATA_FRAME_TIMESTAMP_SIZE
+ * @brief The number of bytes in a packed timestamp. 56 bits of microseconds lasts until the year 2284.
+ */
+#define DATA_FRAME_TIMESTAMP_SIZE		7U
+
+/**
+ * @def DATA_FRAME_MAX_SAMPLE_SIZE
+ * @brief The largest possible single sample frame, in bytes.
+ */
+#define DATA_FRAME_MAX_SAMPLE_SIZE		(DATA_FRAME_HEADER_SIZE + 1U + DATA_FRAME_TIMESTAMP_SIZE + 4U + DATA_FRAME_CRC_SIZE)
+
+/**
+ * @def DATA_FRAME_MAX_BLOCK_SAMPLES
+ * @brief The largest number of samples which can be carried by a single block frame.
+ */
+#define DATA_FRAME_MAX_BLOCK_SAMPLES	32U
+
+/**
+ * @def DATA_FRAME_MAX_BLOCK_SIZE(COUNT)
+ * @brief The largest possible block frame carrying COUNT samples, in bytes.
+ */
+#define DATA_FRAME_MAX_BLOCK_SIZE(COUNT)	(DATA_FRAME_HEADER_SIZE + 3U + DATA_FRAME_TIMESTAMP_SIZE + (8U * (COUNT)) \
+											+ DATA_FRAME_CRC_SIZE)
+
+/**
+ * @def DATA_FRAME_STATISTICS_SIZE
+ * @brief The size of a statistics frame, in bytes.
+ */
+#define DATA_FRAME_STATISTICS_SIZE		(DATA_FRAME_HEADER_SIZE + 1U + (2U * DATA_FRAME_TIMESTAMP_SIZE) + (6U * 4U) \
+											+ DATA_FRAME_CRC_SIZE)
+
+/**
+ * @def DATA_FRAME_ALARM_SIZE
+ * @brief The size of an alarm frame, in bytes.
+ */
+#define DATA_FRAME_ALARM_SIZE			(DATA_FRAME_HEADER_SIZE + 1U + DATA_FRAME_TIMESTAMP_SIZE + 1U + 4U \
+											+ DATA_FRAME_CRC_SIZE)
+
+/**
+ * @def DATA_FRAME_SHED_SIZE
+ * @brief The size of a shed data frame, in bytes.
+ */
+#define DATA_FRAME_SHED_SIZE			(DATA_FRAME_HEADER_SIZE + DATA_FRAME_TIMESTAMP_SIZE + 1U + 4U + DATA_FRAME_CRC_SIZE)
+
+/**
+ * @def DATA_FRAME_BLOCK_FIXED_RATE
+ * @brief Block flag set when the samples are evenly spaced and a single period replaces the deltas.
+ */
+#define DATA_FRAME_BLOCK_FIXED_RATE		((uint8_t) 0x01U)
+
+/**
+ * @def DATA_FRAME_BLOCK_WIDE_DELTAS
+ * @brief Block flag set when the timing fields are 4 bytes instead of 2.
+ */
+#define DATA_FRAME_BLOCK_WIDE_DELTAS	((uint8_t) 0x02U)
+
+/**
+ * @def DATA_FRAME_BLOCK_WIDE_VALUES
+ * @brief Block flag set when the values are 4 bytes instead of 3.
+ */
+#define DATA_FRAME_BLOCK_WIDE_VALUES	((uint8_t) 0x04U)
+
+/**
+ * @def DATA_FRAME_CRC_INIT
+ * @brief The initial value of the frame CRC.
+ */
+#define DATA_FRAME_CRC_INIT				((uint16_t) 0xFFFFU)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Data frame type enumeration.
+ * Defines the payload carried by a frame.
+ */
+typedef enum {
+	DATA_FRAME_ANALOG_24 = 0x01, /**< An analog sample whose value fits in 24 bits. */
+	DATA_FRAME_ANALOG_32 = 0x02, /**< An analog sample whose value needs 32 bits. */
+	DATA_FRAME_DIGITAL = 0x03, /**< A digital input sample. */
+	DATA_FRAME_ANALOG_BLOCK = 0x04, /**< A block of analog samples from a single channel. */
+	DATA_FRAME_ANALOG_STATISTICS = 0x05, /**< Statistics over a window of analog samples from a single channel. */
+	DATA_FRAME_ANALOG_ALARM = 0x06, /**< An analog channel changing range state. */
+	DATA_FRAME_SHED = 0x07 /**< Data which was not written because the connection could not keep up. */
+} DataFrame_Type_t;
+
+/**
+ * @brief Statistics over a window of samples from a single channel.
+ */
+typedef struct {
+	uint64_t start; /**< The time of the first sample in the window, in microseconds since the UNIX epoch. */
+	uint64_t end; /**< The time of the last sample in the window, in microseconds since the UNIX epoch. */
+	uint32_t count; /**< The number of samples in the window. */
+	int32_t min; /**< The smallest sample value. */
+	int32_t max; /**< The largest sample value. */
+	float mean; /**< The mean of the sample values. */
+	float rms; /**< The root mean square of the sample values. */
+	float stddev; /**< The sample standard deviation of the sample values. */
+} DataFrame_Statistics_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Updates a frame CRC with the provided bytes.
+ */
+uint16_t DataFrame_CRC16(const uint8_t* data, uint32_t length, uint16_t crc);
+
+/**
+ * @brief Encodes an analog sample frame.
+ */
+uint32_t DataFrame_EncodeAnalog(uint8_t* frame, uint8_t channel, uint64_t timestamp, int32_t value);
+
+/**
+ * @brief Encodes a digital sample frame.
+ */
+uint32_t DataFrame_EncodeDigital(uint8_t* frame, uint8_t channel, uint64_t timestamp, uint8_t level);
+
+/**
+ * @brief Encodes a block of analog samples from a single channel.
+ */
+uint32_t DataFrame_EncodeAnalogBlock(uint8_t* frame, uint8_t channel, const uint64_t* timestamps, const int32_t* values,
+		uint8_t count);
+
+/**
+ * @brief Encodes a statistics frame for a window of analog samples.
+ */
+uint32_t DataFrame_EncodeAnalogStatistics(uint8_t* frame, uint8_t channel, const DataFrame_Statistics_t* statistics);
+
+/**
+ * @brief Encodes an alarm frame for an analog channel changing range state.
+ */
+uint32_t DataFrame_EncodeAnalogAlarm(uint8_t* frame, uint8_t channel, uint64_t timestamp, uint8_t state, int32_t value);
+
+/**
+ * @brief Encodes a frame reporting data which was shed.
+ */
+uint32_t DataFrame_EncodeShed(uint8_t* frame, uint64_t timestamp, uint8_t policy, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_DATAFRAME_H_ */
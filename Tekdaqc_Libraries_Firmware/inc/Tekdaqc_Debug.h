@@ -71,6 +71,27 @@ extern "C" {
  */
 //#define ANALOGINPUT_DEBUG
 
+/**
+ * @internal
+ * @def ANALOG_BATCH_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the analog sample batching stage.
+ */
+//#define ANALOG_BATCH_DEBUG
+
+/**
+ * @internal
+ * @def ANALOG_SCAN_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the compiled analog scan list.
+ */
+//#define ANALOG_SCAN_DEBUG
+
+/**
+ * @internal
+ * @def CLOCK_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the local time clock.
+ */
+//#define CLOCK_DEBUG
+
 /**
  * @internal
  * @def ADC_STATE_MACHINE_DEBUG
@@ -134,6 +155,55 @@ extern "C" {
  */
 //#define INPUT_MULTIPLEXER_DEBUG
 
+/**
+ * @internal
+ * @def COLD_JUNCTION_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the cold junction sampling policy.
+ */
+//#define COLD_JUNCTION_DEBUG
+
+/**
+ * @internal
+ * @def ANALOG_TRIGGER_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the analog trigger engine.
+ */
+//#define ANALOG_TRIGGER_DEBUG
+
+/**
+ * @internal
+ * @def ANALOG_HISTORY_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the analog input history arena.
+ */
+//#define ANALOG_HISTORY_DEBUG
+
+/**
+ * @internal
+ * @def ANALOG_STATISTICS_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the analog input statistics engine.
+ */
+//#define ANALOG_STATISTICS_DEBUG
+
+/**
+ * @internal
+ * @def ANALOG_ALARM_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the analog input range alarms.
+ */
+//#define ANALOG_ALARM_DEBUG
+
+/**
+ * @internal
+ * @def ANALOG_DEADBAND_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the analog input deadband filter.
+ */
+//#define ANALOG_DEADBAND_DEBUG
+
+/**
+ * @internal
+ * @def OUTPUT_BACKPRESSURE_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the sampled data output backpressure policies.
+ */
+//#define OUTPUT_BACKPRESSURE_DEBUG
+
 /**
  * @internal
  * @def TELNET_DEBUG
@@ -141,6 +211,20 @@ extern "C" {
  */
 /* #define TELNET_DEBUG */
 
+/**
+ * @internal
+ * @def DATA_SERVER_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the binary sample data server.
+ */
+/* #define DATA_SERVER_DEBUG */
+
+/**
+ * @internal
+ * @def UDP_STREAM_DEBUG
+ * @brief Used to turn on debugging `printf` statements for the UDP sample stream.
+ */
+/* #define UDP_STREAM_DEBUG */
+
 /**
  * @internal
  * @def TELNET_CHAR_DEBUG
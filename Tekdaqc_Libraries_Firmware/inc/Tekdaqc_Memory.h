@@ -0,0 +1,77 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_Memory.h
+ * @brief Header file for the Tekdaqc's memory placement.
+ *
+ * Contains the attributes used to place variables in the 64 KB core coupled memory (CCM). CCM is only reachable by
+ * the CPU, so nothing accessed by a DMA stream or the Ethernet MAC may be placed there. The linker reports how full the
+ * CCM and SRAM are at the end of every build.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_MEMORY_H_
+#define TEKDAQC_MEMORY_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_memory Tekdaqc Memory
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def CCM_BSS
+ * @brief Places an uninitialized variable in CCM. It is zeroed by the startup code, like .bss.
+ */
+#define CCM_BSS		__attribute__((section(".ccmbss")))
+
+/**
+ * @def CCM_DATA
+ * @brief Places an initialized variable in CCM. Its value is copied from flash by the startup code, like .data.
+ */
+#define CCM_DATA	__attribute__((section(".ccmram")))
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_MEMORY_H_ */
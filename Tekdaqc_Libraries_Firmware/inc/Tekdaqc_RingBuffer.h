@@ -0,0 +1,136 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_RingBuffer.h
+ * @brief Header file for the single producer, single consumer ring buffer.
+ *
+ * Contains public definitions and data types for a lock free ring buffer of fixed size elements, suitable for
+ * passing samples from an interrupt to the main loop.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_RINGBUFFER_H_
+#define TEKDAQC_RINGBUFFER_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_ring_buffer Tekdaqc Ring Buffer
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def IS_RING_BUFFER_CAPACITY(CAPACITY)
+ * @brief Checks that the specified capacity is a non-zero power of two.
+ */
+#define IS_RING_BUFFER_CAPACITY(CAPACITY) (((CAPACITY) != 0U) && (((CAPACITY) & ((CAPACITY) - 1U)) == 0U))
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Single producer, single consumer ring buffer.
+ * The head index is only written by the producer and the tail index only by the consumer. Both indices run freely
+ * and are masked on access, so the capacity must be a power of two and every slot is usable.
+ */
+typedef struct {
+	uint8_t* data; /**< The storage for the elements. */
+	uint32_t elementSize; /**< The size of a single element in bytes. */
+	uint32_t mask; /**< The capacity minus one. */
+	volatile uint32_t head; /**< The number of elements ever written. Published by the producer. */
+	volatile uint32_t tail; /**< The number of elements ever read. Published by the consumer. */
+	volatile uint32_t drops; /**< The number of elements rejected because the buffer was full. */
+	volatile uint32_t highWater; /**< The largest number of elements held at once. */
+} RingBuffer_t;
+
+/**
+ * @brief Ring buffer statistics.
+ * A snapshot of a ring buffer's counters.
+ */
+typedef struct {
+	uint32_t capacity; /**< The number of elements the buffer can hold. */
+	uint32_t count; /**< The number of elements currently held. */
+	uint32_t total; /**< The number of elements accepted since the last reset. */
+	uint32_t drops; /**< The number of elements rejected since the last reset. */
+	uint32_t highWater; /**< The largest number of elements held at once since the last reset. */
+} RingBuffer_Statistics_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Initializes a ring buffer over the provided storage.
+ */
+void RingBuffer_Init(RingBuffer_t* ring, void* storage, uint32_t elementSize, uint32_t capacity);
+
+/**
+ * @brief Discards all elements and clears the counters of a ring buffer.
+ */
+void RingBuffer_Reset(RingBuffer_t* ring);
+
+/**
+ * @brief Copies an element into the ring buffer. Producer side only.
+ */
+bool RingBuffer_Write(RingBuffer_t* ring, const void* element);
+
+/**
+ * @brief Copies the oldest element out of the ring buffer. Consumer side only.
+ */
+bool RingBuffer_Read(RingBuffer_t* ring, void* element);
+
+/**
+ * @brief Retrieves the number of elements currently held in the ring buffer.
+ */
+uint32_t RingBuffer_Count(const RingBuffer_t* ring);
+
+/**
+ * @brief Retrieves a snapshot of the ring buffer's counters.
+ */
+void RingBuffer_GetStatistics(const RingBuffer_t* ring, RingBuffer_Statistics_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_RINGBUFFER_H_ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_SampleCorrection.h
+ * @brief Header file for the fixed point sample correction pipeline.
+ *
+ * Contains public definitions and data types for correcting ADC readings with integer arithmetic only. A reading is
+ * sign extended, gain corrected, offset and optionally scaled in a single pass, saturating at each step.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_SAMPLECORRECTION_H_
+#define TEKDAQC_SAMPLECORRECTION_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_sample_correction Tekdaqc Sample Correction
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def SAMPLE_CORRECTION_UNITY_GAIN
+ * @brief The Q1.31 gain correction which leaves a reading unchanged.
+ */
+#define SAMPLE_CORRECTION_UNITY_GAIN	((int32_t) 0)
+
+/**
+ * @def SAMPLE_CORRECTION_UNITY_SCALE
+ * @brief The Q16.16 user scale which leaves a reading unchanged.
+ */
+#define SAMPLE_CORRECTION_UNITY_SCALE	((int32_t) 0x00010000)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Sample correction parameters.
+ * A Q1.31 value can not hold a factor of 1.0 or more, so the gain correction is kept as a Q1.31 difference from
+ * unity. This covers factors from 0.0 up to (but not including) 2.0 at a resolution of 2^-31.
+ */
+typedef struct {
+	int32_t gain; /**< Gain correction in Q1.31. The applied factor is 1 + gain / 2^31. */
+	int32_t offset; /**< Offset in ADC counts, added after the gain correction. */
+	int32_t scale; /**< User scale in Q16.16, applied last. */
+} SampleCorrection_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Initializes a set of correction parameters to leave readings unchanged.
+ */
+void SampleCorrection_Init(SampleCorrection_t* correction);
+
+/**
+ * @brief Converts a floating point gain correction factor into its Q1.31 representation.
+ */
+int32_t SampleCorrection_GainFromFactor(float factor);
+
+/**
+ * @brief Converts a floating point user scale into its Q16.16 representation.
+ */
+int32_t SampleCorrection_ScaleFromFloat(float scale);
+
+/**
+ * @brief Sign extends a raw 24 bit ADS1256 reading.
+ */
+int32_t SampleCorrection_SignExtend(uint32_t raw);
+
+/**
+ * @brief Corrects a single sign extended reading.
+ */
+int32_t SampleCorrection_Apply(const SampleCorrection_t* correction, int32_t code);
+
+/**
+ * @brief Sign extends and corrects a block of raw 24 bit readings.
+ */
+void SampleCorrection_ApplyRawBlock(const SampleCorrection_t* correction, const uint32_t* raw, int32_t* corrected,
+		uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_SAMPLECORRECTION_H_ */
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_Timestamp.h
+ * @brief Header file for the hardware sample timestamps.
+ *
+ * Contains public definitions for timestamping ADS1256 conversions from a free running 64 bit time base, with the
+ * DRDY edge latched by a timer input capture rather than read in software.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_TIMESTAMP_H_
+#define TEKDAQC_TIMESTAMP_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_timestamp Tekdaqc Timestamp
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def TIMESTAMP_TICKS_PER_US
+ * @brief The number of time base ticks per microsecond. The DRDY capture timer is prescaled to the same rate.
+ */
+#define TIMESTAMP_TICKS_PER_US			84U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Starts the time base and the DRDY input capture.
+ */
+void Timestamp_Init(void);
+
+/**
+ * @brief Called by the time base timer interrupt handler when the counter wraps.
+ */
+void Timestamp_Overflow(void);
+
+/**
+ * @brief Retrieves the current value of the 64 bit time base.
+ */
+uint64_t Timestamp_GetTicks(void);
+
+/**
+ * @brief Retrieves the time base value at the last DRDY falling edge.
+ */
+uint64_t Timestamp_GetDataReadyTicks(void);
+
+/**
+ * @brief Aligns the time base with the local time.
+ */
+void Timestamp_Synchronize(void);
+
+/**
+ * @brief Converts a time base value into local time.
+ */
+uint64_t Timestamp_ToLocalTime(uint64_t ticks);
+
+/**
+ * @brief Retrieves the local time of the last DRDY falling edge.
+ */
+uint64_t Timestamp_GetDataReadyTime(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_TIMESTAMP_H_ */
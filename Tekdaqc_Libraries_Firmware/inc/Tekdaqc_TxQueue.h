@@ -0,0 +1,158 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_TxQueue.h
+ * @brief Header file for the TCP transmit queue.
+ *
+ * Contains public definitions and data types for a queue of fixed size blocks which are written in place and handed
+ * to lwIP by reference. A block is only reused once every byte in it has been acknowledged by the remote host, so
+ * no copy of the data is ever made before it reaches the Ethernet driver.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_TXQUEUE_H_
+#define TEKDAQC_TXQUEUE_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+#include "lwip/tcp.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_tx_queue Tekdaqc Transmit Queue
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def TX_QUEUE_BLOCK_SIZE
+ * @brief The number of bytes in a transmit block. One block fills a full sized TCP segment.
+ */
+#define TX_QUEUE_BLOCK_SIZE		TCP_MSS
+
+/**
+ * @def IS_TX_QUEUE_CAPACITY(CAPACITY)
+ * @brief Checks that the specified number of blocks is a power of two of at least two.
+ */
+#define IS_TX_QUEUE_CAPACITY(CAPACITY) (((CAPACITY) >= 2U) && (((CAPACITY) & ((CAPACITY) - 1U)) == 0U))
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief A block of data to transmit.
+ */
+typedef struct {
+	uint8_t data[TX_QUEUE_BLOCK_SIZE]; /**< The data. */
+	uint32_t length; /**< The number of bytes written into the block. */
+} TxQueue_Block_t;
+
+/**
+ * @brief Transmit queue.
+ * The block indices run freely and are masked on access. Blocks from head up to and including fill are in use:
+ * those before send have been handed to lwIP in full, send has been handed up to sendOffset and fill is the block
+ * being written.
+ */
+typedef struct {
+	TxQueue_Block_t* blocks; /**< The storage for the blocks. */
+	uint32_t mask; /**< The number of blocks minus one. */
+	uint32_t head; /**< The oldest block with data which has not been acknowledged. */
+	uint32_t send; /**< The oldest block with data which has not been handed to lwIP. */
+	uint32_t fill; /**< The block being written. */
+	uint32_t sendOffset; /**< The number of bytes of the send block which have been handed to lwIP. */
+	uint32_t acked; /**< The number of bytes of the head block which have been acknowledged. */
+	uint32_t drops; /**< The number of bytes discarded because every block was in use. */
+	uint32_t highWater; /**< The largest number of blocks in use at once. */
+} TxQueue_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Initializes a transmit queue over the provided blocks.
+ */
+void TxQueue_Init(TxQueue_t* queue, TxQueue_Block_t* blocks, uint32_t count);
+
+/**
+ * @brief Discards all data and clears the counters of a transmit queue.
+ */
+void TxQueue_Reset(TxQueue_t* queue);
+
+/**
+ * @brief Retrieves contiguous space to write into the transmit queue.
+ */
+uint8_t* TxQueue_Reserve(TxQueue_t* queue, uint32_t minimum, uint32_t* space);
+
+/**
+ * @brief Adds bytes written into reserved space to the transmit queue.
+ */
+void TxQueue_Commit(TxQueue_t* queue, uint32_t length);
+
+/**
+ * @brief Copies data into the transmit queue.
+ */
+uint32_t TxQueue_Write(TxQueue_t* queue, const uint8_t* data, uint32_t length);
+
+/**
+ * @brief Hands queued data to lwIP without copying it.
+ */
+uint32_t TxQueue_Flush(TxQueue_t* queue, struct tcp_pcb* pcb, bool partial);
+
+/**
+ * @brief Releases the blocks whose data has been acknowledged.
+ */
+void TxQueue_Acknowledge(TxQueue_t* queue, uint32_t length);
+
+/**
+ * @brief Retrieves the number of blocks in use.
+ */
+uint32_t TxQueue_Count(const TxQueue_t* queue);
+
+/**
+ * @brief Retrieves the number of bytes which can be written without waiting.
+ */
+uint32_t TxQueue_Available(const TxQueue_t* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_TXQUEUE_H_ */
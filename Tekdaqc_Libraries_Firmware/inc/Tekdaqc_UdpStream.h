@@ -0,0 +1,160 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_UdpStream.h
+ * @brief Header file for the UDP sample stream.
+ *
+ * Contains public definitions and data types for streaming binary frames to a unicast address or multicast group
+ * over UDP, so any number of receivers can take the same data. Every datagram has the layout below, with all
+ * multi-byte fields little endian:
+ *
+ * | Offset | Size | Field                                                |
+ * |--------|------|------------------------------------------------------|
+ * | 0      | 4    | Sequence number, one more than the previous datagram |
+ * | 4      | 2    | Number of frames                                     |
+ * | 6      | n    | Whole frames, see Tekdaqc_DataFrame.h                |
+ *
+ * A frame never spans two datagrams, so each datagram can be parsed on its own and a receiver detects a lost one by
+ * a gap in the sequence numbers. The sequence starts from zero each time the stream is enabled.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEKDAQC_UDPSTREAM_H_
+#define TEKDAQC_UDPSTREAM_H_
+
+/* Define to provide proper behavior with C++ compilers ----------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "stm32f4xx.h"
+#include "boolean.h"
+#include "lwip/ip_addr.h"
+
+/** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
+ * @{
+ */
+
+/** @addtogroup tekdaqc_udp_stream Tekdaqc UDP Stream
+ * @{
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED CONSTANTS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @def UDP_STREAM_DATAGRAM_SIZE
+ * @brief The largest datagram payload, in bytes. A full datagram fills one Ethernet frame without fragmentation.
+ */
+#define UDP_STREAM_DATAGRAM_SIZE	(1500U - 20U - 8U)
+
+/**
+ * @def UDP_STREAM_HEADER_SIZE
+ * @brief The number of bytes preceding the frames of a datagram.
+ */
+#define UDP_STREAM_HEADER_SIZE		6U
+
+/**
+ * @def UDP_STREAM_FLUSH_INTERVAL
+ * @brief The longest a frame waits for a datagram to fill before it is sent anyway, in microseconds.
+ */
+#define UDP_STREAM_FLUSH_INTERVAL	10000U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief UDP stream configuration.
+ */
+typedef struct {
+	bool enabled; /**< If sampled data is streamed over UDP. */
+	ip_addr_t address; /**< The unicast address or multicast group to send to. */
+	uint16_t port; /**< The port to send to. */
+} UdpStream_Config_t;
+
+/**
+ * @brief UDP stream counters, kept since the stream was last enabled.
+ */
+typedef struct {
+	uint32_t sequence; /**< The sequence number of the next datagram. */
+	uint32_t frames; /**< The number of frames sent. */
+	uint32_t drops; /**< The number of datagrams lwIP could not send. They still take a sequence number. */
+} UdpStream_Statistics_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Creates the UDP port of the stream, which starts disabled.
+ */
+void UdpStream_Init(void);
+
+/**
+ * @brief Sets the UDP stream configuration.
+ */
+bool UdpStream_Configure(const UdpStream_Config_t* config);
+
+/**
+ * @brief Retrieves the UDP stream configuration.
+ */
+void UdpStream_GetConfig(UdpStream_Config_t* config);
+
+/**
+ * @brief Retrieves the UDP stream counters.
+ */
+void UdpStream_GetStatistics(UdpStream_Statistics_t* statistics);
+
+/**
+ * @brief Indicates if sampled data is streamed over UDP.
+ */
+bool UdpStream_IsEnabled(void);
+
+/**
+ * @brief Adds a frame to the datagram being built.
+ */
+void UdpStream_Write(const uint8_t* frame, uint32_t length);
+
+/**
+ * @brief Sends the datagram being built, if it holds any frames.
+ */
+void UdpStream_Flush(void);
+
+/**
+ * @brief Sends the datagram being built once its oldest frame has waited long enough.
+ */
+void UdpStream_Service(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* TEKDAQC_UDPSTREAM_H_ */
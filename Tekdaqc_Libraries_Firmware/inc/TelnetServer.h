@@ -38,6 +38,7 @@ extern "C" {
 #include "Tekdaqc_Debug.h"
 #include <boolean.h>
 #include "lwip/tcp.h"
+#include "Tekdaqc_TxQueue.h"
 
 /** @addtogroup tekdaqc_firmware_libraries Tekdaqc Firmware Libraries
  * @{
@@ -57,6 +58,13 @@ extern "C" {
  */
 #define TELNET_BUFFER_LENGTH 2056
 
+/**
+ * @def TELNET_TX_NUM_BLOCKS
+ * @brief The number of blocks in the Telnet transmit queue. This is TCP_SND_BUF / TCP_MSS, so the queue holds no more
+ * than lwIP will take; once the send buffer is full every block is in flight and writes wait for an acknowledgement.
+ */
+#define TELNET_TX_NUM_BLOCKS 8U
+
 /**
  * @def NOT_CONNECTED
  * @brief The Telnet server is not connected to a client.
@@ -150,6 +158,15 @@ typedef enum {
 	TELNET_ERR_PCBCREATE /**< There was an error creating a PCB structure for the telnet server. */
 } TelnetStatus_t;
 
+/**
+ * @brief Telnet data format enumeration.
+ * The formats in which sampled data can be written to the telnet connection.
+ */
+typedef enum {
+	TELNET_FORMAT_ASCII, /**< Samples are written as human readable text. This is the default for every connection. */
+	TELNET_FORMAT_BINARY /**< Samples are written as binary frames, see Tekdaqc_DataFrame.h. */
+} TelnetDataFormat_t;
+
 /**
  * @brief Data structure to hold the state of the Telnet server.
  * Contains all of the necessary state variables to impliment the Telnet server. Direct manipulation of these
@@ -161,8 +178,7 @@ typedef struct {
 	TelnetState_t state; /**< The current state of the telnet option parser. */
 	volatile unsigned long outstanding; /**< A count of the number of bytes that have been transmitted but have not yet been ACKed. */
 	unsigned long close; /**< A value that is non-zero when the telnet connection should be closed down. */
-	unsigned char buffer[TELNET_BUFFER_LENGTH]; /**< A buffer used to construct a packet of data to be transmitted to the telnet client. */
-	volatile unsigned long length; /**< The number of bytes of valid data in the telnet packet buffer. */
+	TxQueue_t transmit; /**< The queue of data to be transmitted to the telnet client. */
 	unsigned char recvBuffer[TELNET_BUFFER_LENGTH]; /**< A buffer used to receive data from the telnet connection. */
 	volatile unsigned long recvWrite; /**< The offset into g_pucTelnetRecvBuffer of the next location to be written in the buffer.
 	 The buffer is full if this value is one less than g_ulTelnetRecvRead (modulo the buffer size).*/
@@ -171,6 +187,9 @@ typedef struct {
 	struct tcp_pcb* pcb; /**< A pointer to the telnet session PCB data structure. */
 	unsigned char previous; /**< The character most recently received via the telnet interface.  This is used to convert CR/LF sequences
 	 into a simple CR sequence. */
+	TelnetDataFormat_t format; /**< The format sampled data is written in for this connection. */
+	bool congested; /**< Set when a write has timed out. Writes are then dropped rather than waited for until the client
+	 has acknowledged all but the block being written. */
 } TelnetServer_t;
 
 /**
@@ -181,7 +200,7 @@ TelnetStatus_t InitializeTelnetServer(void);
 /**
  * @brief This function is called when the the TCP connection should be closed.
  */
-void TelnetClose(void);
+err_t TelnetClose(void);
 
 /**
  * @brief Indicates if the Telnet server is occupied or not.
@@ -214,6 +233,36 @@ void TelnetWrite(const char character);
  */
 void TelnetWriteString(char* string);
 
+/**
+ * @brief Writes a block of binary data to the telnet interface.
+ */
+void TelnetWriteBuffer(const uint8_t* data, uint32_t length);
+
+/**
+ * @brief Formats a string directly into the telnet transmit queue.
+ */
+void TelnetWriteFormatted(const char* format, ...);
+
+/**
+ * @brief Retrieves the number of bytes which can be written without waiting for the client.
+ */
+uint32_t TelnetGetWriteSpace(void);
+
+/**
+ * @brief Waits for room to write the specified number of bytes.
+ */
+bool TelnetWaitWriteSpace(uint32_t length, uint32_t timeout);
+
+/**
+ * @brief Sets the format sampled data is written in for the current connection.
+ */
+void TelnetSetDataFormat(TelnetDataFormat_t format);
+
+/**
+ * @brief Retrieves the format sampled data is written in for the current connection.
+ */
+TelnetDataFormat_t TelnetGetDataFormat(void);
+
 /**
  * @brief Handle a WILL request for a telnet option.
  */
@@ -66,7 +66,7 @@ extern "C" {
 
 	/* MEM_SIZE: the size of the heap memory. If the application will send
 	 a lot of data that needs to be copied, this should be set high. */
-#define MEM_SIZE                (10*1024)
+#define MEM_SIZE                (16*1024)
 
 	/* MEMP_NUM_PBUF: the number of memp struct pbufs. If the application
 	 sends a lot of data out of ROM (or other static memory), this
@@ -82,15 +82,16 @@ extern "C" {
 	 connections. */
 #define MEMP_NUM_TCP_PCB_LISTEN 6
 	/* MEMP_NUM_TCP_SEG: the number of simultaneously queued TCP
-	 segments. */
-#define MEMP_NUM_TCP_SEG        12
+	 segments. The telnet and data connections can each queue up to
+	 TCP_SND_QUEUELEN. */
+#define MEMP_NUM_TCP_SEG        40
 	/* MEMP_NUM_SYS_TIMEOUT: the number of simulateously active
 	 timeouts. */
 #define MEMP_NUM_SYS_TIMEOUT    10
 
 	/* ---------- Pbuf options ---------- */
 	/* PBUF_POOL_SIZE: the number of buffers in the pbuf pool. */
-#define PBUF_POOL_SIZE          10
+#define PBUF_POOL_SIZE          16
 
 	/* PBUF_POOL_BUFSIZE: the size of each pbuf in the pbuf pool. */
 #define PBUF_POOL_BUFSIZE       500
@@ -107,7 +108,7 @@ extern "C" {
 #define TCP_MSS                 (1500 - 40)/* TCP_MSS = (Ethernet MTU - IP header size - TCP header size) */
 
 	/* TCP sender buffer space (bytes). */
-#define TCP_SND_BUF             (4*TCP_MSS)
+#define TCP_SND_BUF             (8*TCP_MSS)
 
 	/*  TCP_SND_QUEUELEN: TCP sender buffer space (pbufs). This must be at least
 	 as much as (2 * TCP_SND_BUF/TCP_MSS) for things to work. */
@@ -86,6 +86,28 @@
  */
 #define ADS1256_REGISTERS_TOSTRING_HEADER "[ADS1256] Register Contents:\n\r"
 
+/**
+ * @internal
+ * @def CHANNEL_SWITCH_TIMER_PRESCALER
+ * @brief Prescaler for the channel switch timer, giving 1 count per CHANNEL_SWITCH_TIMER_TICK_US from the 84 MHz
+ * APB1 timer clock.
+ */
+#define CHANNEL_SWITCH_TIMER_PRESCALER 839U
+
+/**
+ * @internal
+ * @def CHANNEL_SWITCH_TIMER_TICK_US
+ * @brief The period of one channel switch timer count in microseconds.
+ */
+#define CHANNEL_SWITCH_TIMER_TICK_US 10U
+
+/**
+ * @internal
+ * @def CHANNEL_SWITCH_TIMER_MAX_COUNT
+ * @brief The longest delay the 16 bit channel switch timer can be armed for, in counts.
+ */
+#define CHANNEL_SWITCH_TIMER_MAX_COUNT 0xFFFFU
+
 extern void InitAnalogSamplesBuffer(void);
 
 
@@ -128,12 +150,21 @@ static ADS1256_GPIO_STATUS_t GPIO_STATUS[] = { ADS1256_GPIO_LOW,
 /* Flag to indicate if command or pin should be used for SYNC of ADC. */
 static bool SYNC_USE_COMMAND = false;
 
+/* The state of the ADC's Read Data Continuous mode. Changed from the DRDY interrupt. */
+static volatile ADS1256_Continuous_t CONTINUOUS_STATE = ADS1256_CONTINUOUS_OFF;
+
 /* The last retrieved measurement from the ADC. */
 static uint32_t ADS1256_Measurement = 0U;
 
 /* The last retrieved state of the ADC register. */
 static uint8_t ADS1256_Registers[11]; /* A local copy of all the ADC registers. Note that the indexing here only works because the addresses start at 0 and count up. */
 
+/* One bit per register which has been set locally but not yet written to the ADC. */
+static uint16_t ADS1256_DirtyRegisters = 0U;
+
+/* Register write statistics. */
+static ADS1256_WriteStats_t ADS1256_Stats = { 0U, 0U, 0U, 0 };
+
 /* Flag for if we should always read the register from the ADS1256 for most up to date values. */
 static bool ADS1256_AlwaysReadReg = false;
 
@@ -182,7 +213,7 @@ static uint8_t ADS1256_GetRegisterBits(ADS1256_Register_t reg, uint8_t index, ui
 
 /**
  * @internal
- * @brief Sets the specified bits in a register (both local and remote).
+ * @brief Sets the specified bits in a register locally, marking it for the next commit.
  */
 static void ADS1256_SetRegisterBits(ADS1256_Register_t reg, uint8_t index, uint8_t count, uint8_t value);
 
@@ -194,13 +225,13 @@ static uint8_t ADS1256_GetRegister(ADS1256_Register_t reg);
 
 /**
  * @internal
- * @brief Sets the contents of a register (both local and remote).
+ * @brief Sets the contents of a register locally, marking it for the next commit.
  */
 static void ADS1256_SetRegister(ADS1256_Register_t reg, uint8_t value);
 
 /**
  * @internal
- * @brief Sets the contents of one or more registers (both local and remote).
+ * @brief Sets the contents of one or more registers locally, marking them for the next commit.
  */
 static void ADS1256_SetRegisters(ADS1256_Register_t reg, uint8_t count, uint8_t* values);
 
@@ -289,7 +320,7 @@ void InitializeShortDelayTimer(void)
     TIM_Cmd(TIM2, ENABLE);
 }
 //lfao-new timer used for the channel switching...
-//currently configured to trigger an interrupt every 3ms...
+//one shot timer which runs the channel switch handler once each time it is armed or triggered...
 void InitializeChannelSwitchTimer(void)
 {
 
@@ -303,17 +334,69 @@ void InitializeChannelSwitchTimer(void)
     RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM4, ENABLE);
 
     TIM_TimeBaseInitTypeDef ChnSwitchTimer;
-    ChnSwitchTimer.TIM_Prescaler = 41999;
+    ChnSwitchTimer.TIM_Prescaler = CHANNEL_SWITCH_TIMER_PRESCALER;
     ChnSwitchTimer.TIM_CounterMode = TIM_CounterMode_Up;
-    ChnSwitchTimer.TIM_Period = 5;
+    ChnSwitchTimer.TIM_Period = CHANNEL_SWITCH_TIMER_MAX_COUNT;
     ChnSwitchTimer.TIM_ClockDivision = TIM_CKD_DIV1;
     ChnSwitchTimer.TIM_RepetitionCounter = 0;
     TIM_TimeBaseInit(TIM4, &ChnSwitchTimer);
-
+    TIM_SelectOnePulseMode(TIM4, TIM_OPMode_Single);
+    /* TIM_TimeBaseInit() generates an update event to load the prescaler, don't let it reach the NVIC */
+    TIM_ClearITPendingBit(TIM4, TIM_IT_Update);
 
     TIM_ITConfig(TIM4, TIM_IT_Update, ENABLE);
+}
+
+/**
+ * Arms the channel switch timer to run the channel switch handler once after the specified delay. Any delay already
+ * armed is replaced. The delay is rounded up to the timer resolution and limited to what the timer can count.
+ *
+ * @param delay uint32_t The delay in microseconds. A delay of 0 runs the handler as soon as possible.
+ * @retval none
+ */
+void ArmChannelSwitchTimer(uint32_t delay)
+{
+    uint32_t counts = (delay + CHANNEL_SWITCH_TIMER_TICK_US - 1U) / CHANNEL_SWITCH_TIMER_TICK_US;
+    if (counts == 0U) {
+        TriggerChannelSwitch();
+        return;
+    }
+    if (counts < 2U) {
+        /* An auto reload of 0 stops the counter, so the shortest delay is two counts */
+        counts = 2U;
+    } else if (counts > CHANNEL_SWITCH_TIMER_MAX_COUNT) {
+        counts = CHANNEL_SWITCH_TIMER_MAX_COUNT;
+    }
+    TIM_Cmd(TIM4, DISABLE);
+    TIM_SetAutoreload(TIM4, counts - 1U);
+    TIM_SetCounter(TIM4, 0U);
     TIM_Cmd(TIM4, ENABLE);
 }
+
+/**
+ * Cancels any armed delay and runs the channel switch handler as soon as possible, from the timer's interrupt. This
+ * is safe to call from interrupts of the same or higher priority.
+ *
+ * @param none
+ * @retval none
+ */
+void TriggerChannelSwitch(void)
+{
+    TIM_Cmd(TIM4, DISABLE);
+    TIM_GenerateEvent(TIM4, TIM_EventSource_Update);
+}
+
+/**
+ * Cancels any armed delay of the channel switch timer without running the handler.
+ *
+ * @param none
+ * @retval none
+ */
+void CancelChannelSwitchTimer(void)
+{
+    TIM_Cmd(TIM4, DISABLE);
+    TIM_ClearITPendingBit(TIM4, TIM_IT_Update);
+}
 volatile int totalDelay = 0;
 void ShortDelayUS(uint32_t Delay)
 {
@@ -338,11 +421,12 @@ void ADS1256_StatePins_Init(void) {
 	RCC_AHB1PeriphClockCmd(ADS1256_DRDY_GPIO_CLK, ENABLE);
 	RCC_APB2PeriphClockCmd(RCC_APB2Periph_SYSCFG, ENABLE);
 
-	/* Configure the GPIO pin */
+	/* Configure the GPIO pin. It is left on the capture timer for the sample timestamps, the EXTI still sees it. */
 	GPIO_InitStructure.GPIO_Pin = ADS1256_DRDY_PIN;
-	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
 	GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
 	GPIO_Init(ADS1256_DRDY_GPIO_PORT, &GPIO_InitStructure);
+	GPIO_PinAFConfig(ADS1256_DRDY_GPIO_PORT, ADS1256_DRDY_SOURCE, ADS1256_DRDY_AF);
 
 	/* Connect EXTI Line to INT Pin */
 	SYSCFG_EXTILineConfig(EXTI_PortSourceGPIOA, EXTI_PinSource10);
@@ -880,6 +964,7 @@ bool ADS1256_IsDataReady(bool useCommand) {
 void ADS1256_Sync(bool useCommand) {
 	/* TODO: This method should be smart enough to determine if the SYNC pin has been enabled and default to SPI if not. */
 	SYNC_USE_COMMAND = useCommand;
+	ADS1256_Commit(); /* The conversion following the SYNC must use the new settings */
 	if (useCommand) {
 		ADS1256_Send_Command(ADS1256_SYNC); /* Send SYNC command byte */
 		/* TODO: Write SYNC pin high */
@@ -916,6 +1001,76 @@ void ADS1256_Standby(void) {
 	SYNC_USE_COMMAND = true;
 }
 
+/**
+ * Enables or disables Read Data Continuous (RDATAC) mode. Enabling does not communicate with the ADC, instead the
+ * next conversion read issues RDATAC in place of RDATA, since the command must follow a falling edge of DRDY.
+ * Subsequent conversions are then read without any command or t6 delay. Disabling issues SDATAC if the ADC is in
+ * RDATAC mode, waiting for DRDY to be asserted as required. The DRDY interrupt must be disabled before disabling
+ * this mode. While RDATAC mode is on, the ADC ignores register commands.
+ *
+ * @param enable bool True to enter RDATAC mode on the next read, false to leave it.
+ * @retval none
+ */
+void ADS1256_SetContinuousRead(bool enable) {
+	if (enable == true) {
+		if (CONTINUOUS_STATE == ADS1256_CONTINUOUS_OFF) {
+			CONTINUOUS_STATE = ADS1256_CONTINUOUS_PENDING;
+		}
+	} else {
+		if (CONTINUOUS_STATE == ADS1256_CONTINUOUS_ON) {
+			/* SDATAC must be sent while DRDY is low */
+			ADS1256_WaitUntilDataReady(false);
+			ADS1256_Send_Command(ADS1256_SDATAC); /* Send SDATAC command byte */
+#ifdef ADS1256_DEBUG
+			printf("[ADS1256] Left continuous read mode.\n\r");
+#endif
+		}
+		CONTINUOUS_STATE = ADS1256_CONTINUOUS_OFF;
+	}
+}
+
+/**
+ * Retrieves the state of Read Data Continuous (RDATAC) mode.
+ *
+ * @param none
+ * @retval ADS1256_Continuous_t The current continuous read state.
+ */
+ADS1256_Continuous_t ADS1256_GetContinuousReadState(void) {
+	return CONTINUOUS_STATE;
+}
+
+/**
+ * Records that a read engine other than this driver, such as the DMA read engine, has sent the RDATAC command for a
+ * pending continuous read.
+ *
+ * @param none
+ * @retval none
+ */
+void ADS1256_ContinuousReadStarted(void) {
+	if (CONTINUOUS_STATE == ADS1256_CONTINUOUS_PENDING) {
+		CONTINUOUS_STATE = ADS1256_CONTINUOUS_ON;
+	}
+}
+
+/**
+ * Read the 3 raw data bytes from the ADC while Read Data Continuous mode is enabled. If the mode is pending, the
+ * RDATAC command is sent ahead of the data. Must be called after DRDY is asserted.
+ *
+ * @param data uint8_t* Pointer to the 3 byte destination.
+ * @retval none
+ */
+void ADS1256_ReadDataContinuous(uint8_t* data) {
+	ADS1256_CS_LOW(); /* Enable SPI communication */
+	if (CONTINUOUS_STATE == ADS1256_CONTINUOUS_PENDING) {
+		ADS1256_SendByte(ADS1256_RDATAC); /* Send RDATAC command byte */
+		ShortDelayUS(11); /*  timing characteristic t6 */
+		CONTINUOUS_STATE = ADS1256_CONTINUOUS_ON;
+	}
+	ADS1256_ReceiveBytes(data, 3U);
+	ShortDelayUS(3); /* timing characteristic t10 */
+	ADS1256_CS_HIGH(); /* Latch SPI communication */
+}
+
 
 
 /*--------------------------------------------------------------------------------------------------------*/
@@ -1313,44 +1468,55 @@ float ADS1256_GetSystemGainCalTime(void) {
  */
 float ADS1256_GetSettlingTime(void) {
 	ADS1256_GetDataRate(); /* Update the register if we need to */
-	switch (SPS) {
+	return (float) ADS1256_GetSettlingTimeForRate(SPS) / 1000.0f;
+}
+
+/**
+ * Retrieves the settling time of the ADC for a data rate, without touching the ADC. Determined by timing
+ * characteristics t18.
+ *
+ * @param sps ADS1256_SPS_t The data rate.
+ * @retval uint32_t The settling time of the ADC in microseconds.
+ */
+uint32_t ADS1256_GetSettlingTimeForRate(ADS1256_SPS_t sps) {
+	switch (sps) {
 	case ADS1256_SPS_30000:
-		return 0.21f;
+		return 210U;
 	case ADS1256_SPS_15000:
-		return 0.25f;
+		return 250U;
 	case ADS1256_SPS_7500:
-		return 0.31f;
+		return 310U;
 	case ADS1256_SPS_3750:
-		return 0.44f;
+		return 440U;
 	case ADS1256_SPS_2000:
-		return 0.68f;
+		return 680U;
 	case ADS1256_SPS_1000:
-		return 1.18f;
+		return 1180U;
 	case ADS1256_SPS_500:
-		return 2.18f;
+		return 2180U;
 	case ADS1256_SPS_100:
-		return 10.18f;
+		return 10180U;
 	case ADS1256_SPS_60:
-		return 16.84f;
+		return 16840U;
 	case ADS1256_SPS_50:
-		return 20.18f;
+		return 20180U;
 	case ADS1256_SPS_30:
-		return 33.51f;
+		return 33510U;
 	case ADS1256_SPS_25:
-		return 40.18f;
+		return 40180U;
 	case ADS1256_SPS_15:
-		return 66.84f;
+		return 66840U;
 	case ADS1256_SPS_10:
-		return 100.18f;
+		return 100180U;
 	case ADS1256_SPS_5:
-		return 200.18f;
+		return 200180U;
 	case ADS1256_SPS_2_5:
-		return 400.18f;
+		return 400180U;
 	default:
 #ifdef ADS1256_DEBUG
-		printf("[ADS1256] Failed to look up settling time for 0x%02X!\n\r", SPS);
+		printf("[ADS1256] Failed to look up settling time for 0x%02X!\n\r", sps);
 #endif
-		return 0;
+		return 0U;
 	}
 }
 
@@ -1802,6 +1968,133 @@ void ADS1256_SetGainCalSetting(uint8_t* value) {
 
 
 
+/*--------------------------------------------------------------------------------------------------------*/
+/* REGISTER IMAGE METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Builds a register image holding a complete sampling configuration, so that it can later be applied with a single
+ * call to ADS1256_LoadRegisterImage(). Settings which are not part of the configuration, such as the data order and
+ * clock out rate, are taken from the local copy of the registers.
+ *
+ * @param image uint8_t* Pointer to ADS1256_REGISTER_IMAGE_SIZE bytes to build the image in.
+ * @param pos ADS1256_AIN_t The high side analog input channel.
+ * @param neg ADS1256_AIN_t The low side analog input channel.
+ * @param buffer ADS1256_BUFFER_t The input buffer setting.
+ * @param gain ADS1256_PGA_t The PGA gain setting.
+ * @param sps ADS1256_SPS_t The data (sample) rate setting.
+ * @param offset_cal uint32_t The offset calibration value, exactly as it is stored by the ADC.
+ * @param gain_cal uint32_t The gain calibration value, exactly as it is stored by the ADC.
+ * @retval none
+ */
+void ADS1256_BuildRegisterImage(uint8_t* image, ADS1256_AIN_t pos, ADS1256_AIN_t neg, ADS1256_BUFFER_t buffer,
+		ADS1256_PGA_t gain, ADS1256_SPS_t sps, uint32_t offset_cal, uint32_t gain_cal) {
+	assert_param(IS_ADS1256_AIN_SETTING(pos));
+	assert_param(IS_ADS1256_AIN_SETTING(neg));
+	assert_param(IS_ADS1256_PGA_SETTING(gain));
+	memcpy(image, ADS1256_Registers, ADS1256_REGISTER_IMAGE_SIZE);
+	image[ADS1256_STATUS] = (uint8_t) ((image[ADS1256_STATUS] & ~(0x01U << ADS1256_BUFFEN_BIT))
+			| ((buffer & 0x01U) << ADS1256_BUFFEN_BIT));
+	image[ADS1256_MUX] = (uint8_t) ((pos << 4U) | neg);
+	image[ADS1256_ADCON] = (uint8_t) ((image[ADS1256_ADCON] & ~(0x07U << ADS1256_PGA_BIT))
+			| ((gain & 0x07U) << ADS1256_PGA_BIT));
+	image[ADS1256_DRATE] = (uint8_t) sps;
+	image[ADS1256_OFC0] = (uint8_t) (offset_cal & 0xFFU);
+	image[ADS1256_OFC1] = (uint8_t) ((offset_cal >> 8U) & 0xFFU);
+	image[ADS1256_OFC2] = (uint8_t) ((offset_cal >> 16U) & 0xFFU);
+	image[ADS1256_FSC0] = (uint8_t) (gain_cal & 0xFFU);
+	image[ADS1256_FSC1] = (uint8_t) ((gain_cal >> 8U) & 0xFFU);
+	image[ADS1256_FSC2] = (uint8_t) ((gain_cal >> 16U) & 0xFFU);
+}
+
+/**
+ * Applies a register image built by ADS1256_BuildRegisterImage(). The image is staged in the local registers and
+ * committed, so only the span between the first and last registers which changed is written, as a single WREG burst.
+ * The IO register is never changed by an image.
+ *
+ * @param image const uint8_t* Pointer to the ADS1256_REGISTER_IMAGE_SIZE byte image to apply.
+ * @param force bool If true, the whole image is written regardless of the local copy. This should be used when the
+ * 		remote registers may have changed without the local copy being updated, such as after a calibration.
+ * @retval bool TRUE if any registers were written.
+ */
+bool ADS1256_LoadRegisterImage(const uint8_t* image, bool force) {
+	uint8_t staged[ADS1256_REGISTER_IMAGE_SIZE];
+	memcpy(staged, image, ADS1256_REGISTER_IMAGE_SIZE);
+	staged[ADS1256_IO] = ADS1256_Registers[ADS1256_IO];
+	ADS1256_SetRegisters(ADS1256_STATUS, ADS1256_REGISTER_IMAGE_SIZE, staged);
+	if (force == true) {
+		ADS1256_DirtyRegisters |= (uint16_t) ((0x01U << ADS1256_REGISTER_IMAGE_SIZE) - 1U);
+	}
+	/* Keep the cached settings in step with the registers */
+	BUFFER = (ADS1256_BUFFER_t) ((ADS1256_Registers[ADS1256_STATUS] >> ADS1256_BUFFEN_BIT) & 0x01U);
+	AIN_POS = (ADS1256_AIN_t) (ADS1256_Registers[ADS1256_MUX] >> 4U);
+	AIN_NEG = (ADS1256_AIN_t) (ADS1256_Registers[ADS1256_MUX] & 0x0FU);
+	PGA = (ADS1256_PGA_t) ((ADS1256_Registers[ADS1256_ADCON] >> ADS1256_PGA_BIT) & 0x07U);
+	SPS = (ADS1256_SPS_t) ADS1256_Registers[ADS1256_DRATE];
+	return ADS1256_Commit();
+}
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* REGISTER COMMIT METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Writes the registers which have been changed locally since the last commit. The registers are contiguous, so
+ * everything from the lowest to the highest changed register goes out in one WREG burst with chip select held low,
+ * including any unchanged registers in between. This is called automatically before any command or register read,
+ * so the set functions may be called freely without each one costing an SPI transaction.
+ *
+ * @param none
+ * @retval bool TRUE if any registers were written.
+ */
+bool ADS1256_Commit(void) {
+	if (ADS1256_DirtyRegisters == 0U) {
+		return FALSE;
+	}
+	uint8_t first = 0U;
+	uint8_t last = ADS1256_NREGS - 1U;
+	while ((ADS1256_DirtyRegisters & (0x01U << first)) == 0U) {
+		++first;
+	}
+	while ((ADS1256_DirtyRegisters & (0x01U << last)) == 0U) {
+		--last;
+	}
+	ADS1256_DirtyRegisters = 0U;
+	ADS1256_WriteRegisters(first, (uint8_t) (last - first + 1U));
+	++ADS1256_Stats.commits;
+	ADS1256_Stats.bytesWritten += 2U + (last - first + 1U);
+	return TRUE;
+}
+
+/**
+ * Retrieves the register write statistics, which compare the traffic of the committed bursts with that of writing
+ * every register set call straight through.
+ *
+ * @param stats ADS1256_WriteStats_t* The structure to fill in.
+ * @retval none
+ */
+void ADS1256_GetWriteStats(ADS1256_WriteStats_t* stats) {
+	*stats = ADS1256_Stats;
+	stats->bytesSaved = (int32_t) (stats->bytesRequested - stats->bytesWritten);
+}
+
+/**
+ * Clears the register write statistics.
+ *
+ * @param none
+ * @retval none
+ */
+void ADS1256_ResetWriteStats(void) {
+	ADS1256_Stats.commits = 0U;
+	ADS1256_Stats.bytesRequested = 0U;
+	ADS1256_Stats.bytesWritten = 0U;
+	ADS1256_Stats.bytesSaved = 0;
+}
+
+
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* COMMAND METHODS */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -1827,6 +2120,7 @@ static void ADS1256_Reg_Command(ADS1256_Command_t cmd, ADS1256_Register_t reg, u
  * @retval none
  */
 static void ADS1256_Send_Command(ADS1256_Command_t cmd) {
+	ADS1256_Commit(); /* Commands such as SYNC and SELFCAL act on the registers, so they must be up to date */
 	ADS1256_CS_LOW();
 	ADS1256_SendByte(cmd);
 	Delay_us(8 * ADS1256_CLK_PERIOD_US); /* timing characteristic t10 */
@@ -1861,7 +2155,7 @@ static uint8_t ADS1256_GetRegisterBits(ADS1256_Register_t reg, uint8_t index, ui
 }
 
 /**
- * Set the specified bits of a local register. This will automatically push the changes to the remote register.
+ * Set the specified bits of a local register. The change is pushed to the remote register by the next commit.
  *
  * @param reg ADS1256_Register_t The register to set the bits of.
  * @param index uint8_t The starting bit to retrieve.
@@ -1880,6 +2174,7 @@ static void ADS1256_SetRegisterBits(ADS1256_Register_t reg, uint8_t index, uint8
 	uint8_t byte = ADS1256_GetRegister(reg);
 	/* If the value to be set is identical to the existing one, no action. */
 	if (ADS1256_GetRegisterBits(reg, index, count) == value) {
+		ADS1256_Stats.bytesRequested += 3U; /* A straight through write would still have been sent */
 		return;
 	}
 	uint8_t mask = 0x00;
@@ -1903,7 +2198,7 @@ static uint8_t ADS1256_GetRegister(ADS1256_Register_t reg) {
 }
 
 /**
- * Set the contents of a register, both local and remote.
+ * Set the contents of a local register. The change is pushed to the remote register by the next commit.
  *
  * @param reg ADS1256_Register_t The register to set the value of.
  * @param value uint8_t The value to apply to the register.
@@ -1914,7 +2209,8 @@ static void ADS1256_SetRegister(ADS1256_Register_t reg, uint8_t value) {
 }
 
 /**
- * Set the contents of multiple registers, both local and remote.
+ * Set the contents of multiple local registers. Only registers whose value changes are marked dirty, and the changes
+ * are pushed to the remote registers by the next commit.
  *
  * @param reg ADS1256_Register_t The register to start the writing at.
  * @param count uint8_t The number of registers to write.
@@ -1923,9 +2219,12 @@ static void ADS1256_SetRegister(ADS1256_Register_t reg, uint8_t value) {
  */
 static void ADS1256_SetRegisters(ADS1256_Register_t reg, uint8_t count, uint8_t* values) {
 	for (uint_fast8_t i = 0; i < count; ++i) {
-		ADS1256_Registers[reg + i] = values[i];
+		if (ADS1256_Registers[reg + i] != values[i]) {
+			ADS1256_Registers[reg + i] = values[i];
+			ADS1256_DirtyRegisters |= (uint16_t) (0x01U << (reg + i));
+		}
 	}
-	ADS1256_WriteRegisters(reg, count);
+	ADS1256_Stats.bytesRequested += 2U + count; /* WREG command, count and the values */
 }
 
 /**
@@ -1946,6 +2245,7 @@ static void ADS1256_ReadRegister(ADS1256_Register_t reg) {
  * @retval none
  */
 static void ADS1256_ReadRegisters(ADS1256_Register_t reg, uint8_t count) {
+	ADS1256_Commit(); /* Don't let the read replace local changes which have not been written yet */
 	ADS1256_CS_LOW();
 	DisableBoardInterrupts();
 	ADS1256_Reg_Command(ADS1256_RREG, reg, count);
@@ -0,0 +1,415 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file ADS1256_SPI_DMA.c
+ * @brief Source file for the ADS1256 DMA read engine.
+ *
+ * Reads conversion results from the ADS1256 without blocking in an interrupt. A read is performed as a chain of
+ * short steps, each started from the interrupt of the previous one:
+ *
+ * 1. DRDY falls: chip select is asserted and the RDATA command byte is clocked out by DMA.
+ * 2. The command byte completes: the one shot timer is armed for timing characteristic t6.
+ * 3. The timer expires: the three data bytes are clocked in by DMA.
+ * 4. The data bytes complete: the one shot timer is armed for timing characteristic t10.
+ * 5. The timer expires: chip select is released and the completion callback is called with the reading.
+ *
+ * The SPI peripheral is shared with the blocking methods of ADS1256_SPI_Controller.c, so the SPI DMA requests are
+ * only enabled while a transfer is in flight and the caller must not issue blocking transfers while
+ * ADS1256_DMA_IsBusy() returns true.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "ADS1256_SPI_DMA.h"
+#include "ADS1256_Driver.h"
+#include "Tekdaqc_Config.h"
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def ADS1256_DMA_DATA_BYTES
+ * @brief The number of bytes in a conversion result.
+ */
+#define ADS1256_DMA_DATA_BYTES 3U
+
+/**
+ * @internal
+ * @def ADS1256_DMA_TIMER_PRESCALER
+ * @brief Prescaler for the one shot timer, giving 1 count per microsecond from the 84 MHz APB1 timer clock.
+ */
+#define ADS1256_DMA_TIMER_PRESCALER 83U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE TYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief DMA read engine state enumeration.
+ * Defines the steps of a single DMA read.
+ */
+typedef enum {
+	ADS1256_DMA_IDLE, /**< No read is in progress. */
+	ADS1256_DMA_COMMAND, /**< The RDATA command byte is being transferred. */
+	ADS1256_DMA_T6_WAIT, /**< Waiting for t6 to elapse before reading the data. */
+	ADS1256_DMA_DATA, /**< The data bytes are being transferred. */
+	ADS1256_DMA_T10_WAIT /**< Waiting for t10 to elapse before releasing chip select. */
+} ADS1256_DMA_State_t;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The current step of the read in progress. */
+static volatile ADS1256_DMA_State_t DMA_State = ADS1256_DMA_IDLE;
+
+/* The method used to read conversion results. */
+static volatile ADS1256_ReadMode_t ReadMode = ADS1256_READ_POLLED;
+
+/* The function to call with each completed reading. */
+static ADS1256_DMA_Callback_t CompleteCallback = NULL;
+
+/* The number of DRDY events missed because a read was in progress. */
+static volatile uint32_t OverrunCount = 0U;
+
+/* Transmit buffer for the command step. */
+static const uint8_t CommandTxBuffer[1] = { ADS1256_RDATA };
+
+/* Transmit buffer for the command step when entering continuous read mode. */
+static const uint8_t ContinuousTxBuffer[1] = { ADS1256_RDATAC };
+
+/* Transmit buffer for the data step. */
+static const uint8_t DataTxBuffer[ADS1256_DMA_DATA_BYTES] = { ADS1256_DUMMY_BYTE, ADS1256_DUMMY_BYTE,
+		ADS1256_DUMMY_BYTE };
+
+/* Receive buffer for both steps. */
+static volatile uint8_t RxBuffer[ADS1256_DMA_DATA_BYTES];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Configures a DMA stream for transfers between the ADS1256 SPI data register and memory.
+ */
+static void ADS1256_DMA_StreamInit(DMA_Stream_TypeDef* stream, uint32_t direction);
+
+/**
+ * @internal
+ * @brief Starts a full duplex DMA transfer on the ADS1256 SPI peripheral.
+ */
+static void ADS1256_DMA_Transfer(const uint8_t* tx, uint8_t count);
+
+/**
+ * @internal
+ * @brief Arms the one shot timer.
+ */
+static void ADS1256_DMA_StartTimer(uint16_t us);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Configures a DMA stream for byte transfers between the ADS1256 SPI data register and memory. The memory address
+ * and transfer count are set for each transfer.
+ *
+ * @param stream DMA_Stream_TypeDef* The stream to configure.
+ * @param direction uint32_t The transfer direction, one of DMA_DIR_PeripheralToMemory or DMA_DIR_MemoryToPeripheral.
+ * @retval none
+ */
+static void ADS1256_DMA_StreamInit(DMA_Stream_TypeDef* stream, uint32_t direction) {
+	DMA_InitTypeDef DMA_InitStructure;
+
+	DMA_DeInit(stream);
+	DMA_InitStructure.DMA_Channel = ADS1256_SPI_DMA_CHANNEL;
+	DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t) &(ADS1256_SPI->DR);
+	DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t) RxBuffer;
+	DMA_InitStructure.DMA_DIR = direction;
+	DMA_InitStructure.DMA_BufferSize = ADS1256_DMA_DATA_BYTES;
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+	DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+	DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_1QuarterFull;
+	DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+	DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+	DMA_Init(stream, &DMA_InitStructure);
+}
+
+/**
+ * Starts a full duplex DMA transfer on the ADS1256 SPI peripheral. The received bytes are always placed in the
+ * receive buffer. Completion is signaled by the receive stream's transfer complete interrupt.
+ *
+ * @param tx const uint8_t* Pointer to the bytes to transmit.
+ * @param count uint8_t The number of bytes to transfer. Must not exceed ADS1256_DMA_DATA_BYTES.
+ * @retval none
+ */
+static void ADS1256_DMA_Transfer(const uint8_t* tx, uint8_t count) {
+	/* Clear any stale flags from the previous transfer */
+	DMA_ClearFlag(ADS1256_SPI_RX_DMA_STREAM, ADS1256_SPI_RX_DMA_FLAGS);
+	DMA_ClearFlag(ADS1256_SPI_TX_DMA_STREAM, ADS1256_SPI_TX_DMA_FLAGS);
+
+	/* Point the streams at the buffers for this step */
+	DMA_MemoryTargetConfig(ADS1256_SPI_RX_DMA_STREAM, (uint32_t) RxBuffer, DMA_Memory_0);
+	DMA_MemoryTargetConfig(ADS1256_SPI_TX_DMA_STREAM, (uint32_t) tx, DMA_Memory_0);
+	DMA_SetCurrDataCounter(ADS1256_SPI_RX_DMA_STREAM, count);
+	DMA_SetCurrDataCounter(ADS1256_SPI_TX_DMA_STREAM, count);
+
+	/* Drain the receive register so the first request is for our first byte */
+	(void) SPI_I2S_ReceiveData(ADS1256_SPI);
+
+	/* Receive stream first so no byte can be missed */
+	DMA_Cmd(ADS1256_SPI_RX_DMA_STREAM, ENABLE);
+	DMA_Cmd(ADS1256_SPI_TX_DMA_STREAM, ENABLE);
+	SPI_I2S_DMACmd(ADS1256_SPI, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+}
+
+/**
+ * Arms the one shot timer. The timer interrupt will fire once the requested time has elapsed.
+ *
+ * @param us uint16_t The delay in microseconds. Must be at least 1.
+ * @retval none
+ */
+static void ADS1256_DMA_StartTimer(uint16_t us) {
+	TIM_SetAutoreload(ADS1256_DMA_TIMER, (uint32_t) (us - 1U));
+	TIM_SetCounter(ADS1256_DMA_TIMER, 0U);
+	TIM_Cmd(ADS1256_DMA_TIMER, ENABLE);
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INITIALIZATION METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Initializes the DMA streams, one shot timer and interrupts used by the DMA read engine. The read mode is set to
+ * ADS1256_READ_DMA. This does not touch the SPI peripheral itself, which is configured by ADS1256_SPI_Init().
+ *
+ * @param none
+ * @retval none
+ */
+void ADS1256_DMA_Init(void) {
+#ifdef ADS1256_SPI_DEBUG
+	printf("[ADS1256] Initializing the DMA read engine.\n\r");
+#endif
+	NVIC_InitTypeDef NVIC_InitStructure;
+	TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+
+	/* Configure the DMA streams */
+	RCC_AHB1PeriphClockCmd(ADS1256_SPI_DMA_CLK, ENABLE);
+	ADS1256_DMA_StreamInit(ADS1256_SPI_RX_DMA_STREAM, DMA_DIR_PeripheralToMemory);
+	ADS1256_DMA_StreamInit(ADS1256_SPI_TX_DMA_STREAM, DMA_DIR_MemoryToPeripheral);
+	DMA_ITConfig(ADS1256_SPI_RX_DMA_STREAM, DMA_IT_TC, ENABLE);
+
+	/* Configure the one shot timer */
+	RCC_APB1PeriphClockCmd(ADS1256_DMA_TIMER_CLK, ENABLE);
+	TIM_TimeBaseStructure.TIM_Prescaler = ADS1256_DMA_TIMER_PRESCALER;
+	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+	TIM_TimeBaseStructure.TIM_Period = ADS1256_DMA_T6_DELAY_US;
+	TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+	TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+	TIM_TimeBaseInit(ADS1256_DMA_TIMER, &TIM_TimeBaseStructure);
+	TIM_SelectOnePulseMode(ADS1256_DMA_TIMER, TIM_OPMode_Single);
+	/* TIM_TimeBaseInit() generates an update event to load the prescaler, don't let it reach the NVIC */
+	TIM_ClearITPendingBit(ADS1256_DMA_TIMER, TIM_IT_Update);
+	TIM_ITConfig(ADS1256_DMA_TIMER, TIM_IT_Update, ENABLE);
+
+	/* Enable the interrupts at the same priority as DRDY so the steps can't preempt each other */
+	NVIC_InitStructure.NVIC_IRQChannel = ADS1256_SPI_RX_DMA_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+	NVIC_InitStructure.NVIC_IRQChannel = ADS1256_DMA_TIMER_IRQn;
+	NVIC_Init(&NVIC_InitStructure);
+
+	DMA_State = ADS1256_DMA_IDLE;
+	OverrunCount = 0U;
+	ReadMode = ADS1256_READ_DMA;
+}
+
+/**
+ * Sets the function to call with each completed reading. The callback is called from interrupt context.
+ *
+ * @param callback ADS1256_DMA_Callback_t The function to call, or NULL to discard readings.
+ * @retval none
+ */
+void ADS1256_DMA_SetCompleteCallback(ADS1256_DMA_Callback_t callback) {
+	CompleteCallback = callback;
+}
+
+/**
+ * Selects how conversion results are read from the ADS1256 when DRDY is asserted. ADS1256_READ_DMA requires that
+ * ADS1256_DMA_Init() has been called.
+ *
+ * @param mode ADS1256_ReadMode_t The read mode to use.
+ * @retval none
+ */
+void ADS1256_SetReadMode(ADS1256_ReadMode_t mode) {
+	ReadMode = mode;
+}
+
+/**
+ * Retrieves the method used to read conversion results from the ADS1256.
+ *
+ * @param none
+ * @retval ADS1256_ReadMode_t The current read mode.
+ */
+ADS1256_ReadMode_t ADS1256_GetReadMode(void) {
+	return ReadMode;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* AQUISITION METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Begins a DMA read of the current conversion result. This is intended to be called from the DRDY interrupt and
+ * returns immediately. If a read is already in progress, the DRDY event is counted as an overrun and ignored.
+ * When the ADC is in Read Data Continuous mode the command step and t6 delay are skipped.
+ *
+ * @param none
+ * @retval bool TRUE if the read was started.
+ */
+bool ADS1256_DMA_StartRead(void) {
+	if (DMA_State != ADS1256_DMA_IDLE) {
+		++OverrunCount;
+		return FALSE;
+	}
+	ADS1256_CS_LOW(); /* Enable SPI communication */
+	switch (ADS1256_GetContinuousReadState()) {
+	case ADS1256_CONTINUOUS_ON:
+		DMA_State = ADS1256_DMA_DATA;
+		ADS1256_DMA_Transfer(DataTxBuffer, ADS1256_DMA_DATA_BYTES);
+		break;
+	case ADS1256_CONTINUOUS_PENDING:
+		DMA_State = ADS1256_DMA_COMMAND;
+		ADS1256_ContinuousReadStarted();
+		ADS1256_DMA_Transfer(ContinuousTxBuffer, sizeof(ContinuousTxBuffer));
+		break;
+	case ADS1256_CONTINUOUS_OFF:
+	default:
+		DMA_State = ADS1256_DMA_COMMAND;
+		ADS1256_DMA_Transfer(CommandTxBuffer, sizeof(CommandTxBuffer));
+		break;
+	}
+	return TRUE;
+}
+
+/**
+ * Indicates if a DMA read is currently in progress. While this is true, the SPI peripheral belongs to the read
+ * engine.
+ *
+ * @param none
+ * @retval bool TRUE if a read is in progress.
+ */
+bool ADS1256_DMA_IsBusy(void) {
+	return (DMA_State != ADS1256_DMA_IDLE);
+}
+
+/**
+ * Retrieves the number of DRDY events which were missed because a read was still in progress.
+ *
+ * @param none
+ * @retval uint32_t The overrun count.
+ */
+uint32_t ADS1256_DMA_GetOverrunCount(void) {
+	return OverrunCount;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INTERRUPT HANDLERS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Services the SPI receive DMA stream interrupt. The receive stream completes after the transmit stream, so this
+ * marks the end of each SPI transfer.
+ *
+ * @param none
+ * @retval none
+ */
+void ADS1256_DMA_RX_IRQHandler(void) {
+	if (DMA_GetITStatus(ADS1256_SPI_RX_DMA_STREAM, ADS1256_SPI_RX_DMA_TC_IT) != RESET) {
+		DMA_ClearITPendingBit(ADS1256_SPI_RX_DMA_STREAM, ADS1256_SPI_RX_DMA_TC_IT);
+		/* Return the SPI to the blocking methods between transfers */
+		SPI_I2S_DMACmd(ADS1256_SPI, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+		switch (DMA_State) {
+		case ADS1256_DMA_COMMAND:
+			DMA_State = ADS1256_DMA_T6_WAIT;
+			ADS1256_DMA_StartTimer(ADS1256_DMA_T6_DELAY_US);
+			break;
+		case ADS1256_DMA_DATA:
+			DMA_State = ADS1256_DMA_T10_WAIT;
+			ADS1256_DMA_StartTimer(ADS1256_DMA_T10_DELAY_US);
+			break;
+		case ADS1256_DMA_IDLE:
+		case ADS1256_DMA_T6_WAIT:
+		case ADS1256_DMA_T10_WAIT:
+		default:
+#ifdef ADS1256_SPI_DEBUG
+			printf("[ADS1256] Unexpected DMA completion in state %i.\n\r", DMA_State);
+#endif
+			break;
+		}
+	}
+}
+
+/**
+ * Services the read engine's one shot timer interrupt.
+ *
+ * @param none
+ * @retval none
+ */
+void ADS1256_DMA_Timer_IRQHandler(void) {
+	if (TIM_GetITStatus(ADS1256_DMA_TIMER, TIM_IT_Update) != RESET) {
+		TIM_ClearITPendingBit(ADS1256_DMA_TIMER, TIM_IT_Update);
+		switch (DMA_State) {
+		case ADS1256_DMA_T6_WAIT:
+			DMA_State = ADS1256_DMA_DATA;
+			ADS1256_DMA_Transfer(DataTxBuffer, ADS1256_DMA_DATA_BYTES);
+			break;
+		case ADS1256_DMA_T10_WAIT: {
+			uint32_t reading = (uint32_t) ((RxBuffer[0] << 16U) | (RxBuffer[1] << 8U) | RxBuffer[2]);
+			ADS1256_CS_HIGH(); /* Latch SPI communication */
+			DMA_State = ADS1256_DMA_IDLE;
+			if (CompleteCallback != NULL) {
+				CompleteCallback(reading);
+			}
+			break;
+		}
+		case ADS1256_DMA_IDLE:
+		case ADS1256_DMA_COMMAND:
+		case ADS1256_DMA_DATA:
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file DataServer.c
+ * @brief Implements a TCP server which carries sampled data only.
+ *
+ * While a client is connected to DATA_PORT, sampled data is written to it as raw binary frames instead of to the
+ * telnet connection, which is then left for commands and status messages. Only a single connection is allowed at a
+ * time; any further connection is aborted. Anything the client sends is discarded.
+ *
+ * Frames are copied into a transmit queue of MSS sized blocks which lwIP sends from by reference, see
+ * Tekdaqc_TxQueue.c. Full blocks are handed over straight away. The block being written is handed over as soon as
+ * nothing is waiting to be acknowledged and otherwise once the client acknowledges, so a lone frame goes out without
+ * delay while a busy stream is sent in full sized segments.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "DataServer.h"
+#include "Tekdaqc_Config.h"
+#include "Tekdaqc_Timers.h"
+#include "Tekdaqc_Memory.h"
+#include "lwip/memp.h"
+#include "lwip/tcp.h"
+#include "netconf.h"
+#include "stm32f4x7_eth.h"
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Pointer to the listening TCP port of the data server.
+ */
+static struct tcp_pcb* data_pcb;
+
+/**
+ * @internal
+ * @brief The state of the data server.
+ */
+static DataServer_t data_server CCM_BSS;
+
+/**
+ * @internal
+ * @brief The blocks of the transmit queue. lwIP holds references to them until they are acknowledged, so they are
+ * kept out of CCM for the same reason as those of the telnet server.
+ */
+static TxQueue_Block_t transmitBlocks[DATA_SERVER_TX_NUM_BLOCKS];
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Called when the lwIP TCP/IP stack has an incoming connection request on the data port.
+ */
+static err_t DataServerAccept(void *arg, struct tcp_pcb *pcb, err_t err);
+
+/**
+ * @brief Called when the lwIP TCP/IP stack has received data on the data connection.
+ */
+static err_t DataServerReceive(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err);
+
+/**
+ * @brief Called when the lwIP TCP/IP stack has received an acknowledge for data that has been transmitted.
+ */
+static err_t DataServerSent(void *arg, struct tcp_pcb *pcb, u16_t len);
+
+/**
+ * @brief Called periodically by the lwIP TCP/IP stack while the data connection is open.
+ */
+static err_t DataServerPoll(void *arg, struct tcp_pcb *pcb);
+
+/**
+ * @brief Called when the lwIP TCP/IP stack has detected an error.
+ */
+static void DataServerError(void *arg, err_t err);
+
+/**
+ * @brief Hands the queued data to lwIP.
+ */
+static void DataServerFlush(bool partial);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * Called when the lwIP TCP/IP stack has an incoming connection request on the data port.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param pcb tcp_pcb* struct The PCB structure this callback is for.
+ * @param err lwIP err_t with the current error status.
+ * @retval err lwIP err_t with the result of the this function.
+ */
+static err_t DataServerAccept(void *arg, struct tcp_pcb *pcb, err_t err) {
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(err);
+	if (data_server.pcb != NULL) {
+#ifdef DATA_SERVER_DEBUG
+		printf("[Data Server] A connection was attempted while an active connection is open.\n\r");
+#endif
+		tcp_abort(pcb);
+		return ERR_ABRT;
+	}
+	tcp_setprio(pcb, TCP_PRIO_MIN);
+	tcp_accepted(pcb);
+	TxQueue_Reset(&data_server.transmit);
+	data_server.pcb = pcb;
+	pcb->so_options |= SOF_KEEPALIVE;
+	pcb->keep_idle = 300000UL; // 5 Minutes
+	pcb->keep_intvl = 1000UL; // 1 Second
+	pcb->keep_cnt = 9; // 9 Consecutive failures terminate
+	tcp_arg(pcb, &data_server);
+	tcp_recv(pcb, DataServerReceive);
+	tcp_err(pcb, DataServerError);
+	tcp_poll(pcb, DataServerPoll, 1);
+	tcp_sent(pcb, DataServerSent);
+#ifdef DATA_SERVER_DEBUG
+	printf("[Data Server] An incoming connection was accepted.\n\r");
+#endif
+	return ERR_OK;
+}
+
+/**
+ * @internal
+ * Called when the lwIP TCP/IP stack has received data on the data connection. The data is discarded; a NULL packet
+ * means the client has closed the connection, so it is aborted.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param pcb tcp_pcb* struct The PCB structure this callback is for.
+ * @param p pbuf* struct The data buffer from the lwIP stack.
+ * @param err lwIP err_t with the current error status.
+ * @retval err lwIP err_t with the result of the this function.
+ */
+static err_t DataServerReceive(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err) {
+	LWIP_UNUSED_ARG(arg);
+	if ((err == ERR_OK) && (p != NULL)) {
+		tcp_recved(pcb, p->tot_len);
+		pbuf_free(p);
+	} else if ((err == ERR_OK) && (p == NULL)) {
+		DataServerClose();
+		return ERR_ABRT;
+	}
+	return ERR_OK;
+}
+
+/**
+ * @internal
+ * Called when the lwIP TCP/IP stack has received an acknowledge for data that has been transmitted.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param pcb tcp_pcb* struct The PCB structure this callback is for.
+ * @param len u16_t The number of bytes which were acknowledged.
+ * @retval err lwIP err_t with the result of the this function.
+ */
+static err_t DataServerSent(void *arg, struct tcp_pcb *pcb, u16_t len) {
+	LWIP_UNUSED_ARG(pcb);
+	if (arg != NULL) {
+		/* Release the acknowledged blocks and send whatever was waiting for room in the send buffer. */
+		TxQueue_Acknowledge(&((DataServer_t*) arg)->transmit, len);
+		DataServerFlush(TRUE);
+	}
+	return ERR_OK;
+}
+
+/**
+ * @internal
+ * Called periodically by the lwIP TCP/IP stack while the data connection is open. Sends everything queued, in case
+ * an earlier attempt found the send buffer full.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param pcb tcp_pcb* struct The PCB structure this callback is for.
+ * @retval err lwIP err_t with the result of the this function.
+ */
+static err_t DataServerPoll(void *arg, struct tcp_pcb *pcb) {
+	if (arg == NULL) {
+		tcp_abort(pcb);
+		return ERR_ABRT;
+	}
+	DataServerFlush(TRUE);
+	return ERR_OK;
+}
+
+/**
+ * @internal
+ * Called when a fatal error occurs on the data connection. lwIP has already freed the PCB, along with every
+ * reference to the transmit blocks.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param err lwIP err_t with the error.
+ * @retval none
+ */
+static void DataServerError(void *arg, err_t err) {
+	LWIP_UNUSED_ARG(err);
+#ifdef DATA_SERVER_DEBUG
+	printf("[Data Server] Data server error received: %i\n\r", err);
+#endif
+	if (arg != NULL) {
+		data_server.pcb = NULL;
+		TxQueue_Reset(&data_server.transmit);
+	}
+}
+
+/**
+ * @internal
+ * Hands the queued data to lwIP and starts its transmission.
+ *
+ * @param partial bool If the block being written should be sent as well as the full ones.
+ * @retval none
+ */
+static void DataServerFlush(bool partial) {
+	if (data_server.pcb != NULL) {
+		if (TxQueue_Flush(&data_server.transmit, data_server.pcb, partial) != 0U) {
+			tcp_output(data_server.pcb);
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Creates the TCP port for the data server and starts listening on DATA_PORT.
+ *
+ * @param none
+ * @retval DataServerStatus_t The status of the data server.
+ */
+DataServerStatus_t InitializeDataServer(void) {
+	data_server.pcb = NULL;
+	TxQueue_Init(&data_server.transmit, transmitBlocks, DATA_SERVER_TX_NUM_BLOCKS);
+	data_pcb = tcp_new();
+	if (data_pcb == NULL) {
+#ifdef DATA_SERVER_DEBUG
+		printf("[Data Server] Can not create new TCP port.\n\r");
+#endif
+		return DATA_SERVER_ERR_PCBCREATE;
+	}
+	if (tcp_bind(data_pcb, IP_ADDR_ANY, DATA_PORT) != ERR_OK) {
+		memp_free(MEMP_TCP_PCB, data_pcb);
+#ifdef DATA_SERVER_DEBUG
+		printf("[Data Server] Can not bind pcb\n\r");
+#endif
+		return DATA_SERVER_ERR_BIND;
+	}
+	data_pcb = tcp_listen(data_pcb);
+	tcp_accept(data_pcb, DataServerAccept);
+#ifdef DATA_SERVER_DEBUG
+	printf("[Data Server] Now listening for incoming connections on port %i\n\r", DATA_PORT);
+#endif
+	return DATA_SERVER_OK;
+}
+
+/**
+ * Closes the data connection, if any. Sampled data is written to the telnet connection again afterwards.
+ *
+ * The connection is aborted rather than closed: a closing PCB would go on retransmitting from the transmit blocks,
+ * which the next connection reuses. Whatever was not yet acknowledged is lost, which is acceptable for sampled data.
+ * When called from an lwIP callback of the connection, the callback must return ERR_ABRT.
+ *
+ * @param none
+ * @retval none
+ */
+void DataServerClose(void) {
+	struct tcp_pcb* pcb = data_server.pcb;
+	if (pcb != NULL) {
+#ifdef DATA_SERVER_DEBUG
+		printf("[Data Server] Closing data connection.\n\r");
+#endif
+		tcp_arg(pcb, NULL);
+		tcp_sent(pcb, NULL);
+		tcp_recv(pcb, NULL);
+		tcp_err(pcb, NULL);
+		tcp_poll(pcb, NULL, 0);
+		data_server.pcb = NULL;
+		tcp_abort(pcb);
+		TxQueue_Reset(&data_server.transmit);
+	}
+}
+
+/**
+ * Indicates if a client is connected to the data server.
+ *
+ * @param none
+ * @retval bool TRUE if sampled data should be written to the data connection.
+ */
+bool DataServerIsConnected(void) {
+	return (data_server.pcb != NULL) ? TRUE : FALSE;
+}
+
+/**
+ * Writes a block of binary data to the data connection, unchanged. If the client does not make room for all of it
+ * straight away, none of it is written and it is counted as dropped; waiting is up to the caller, see
+ * DataServerWaitWriteSpace().
+ *
+ * @param data const uint8_t* Pointer to the data to write.
+ * @param length uint32_t The number of bytes to write.
+ * @retval none
+ */
+void DataServerWriteBuffer(const uint8_t* data, uint32_t length) {
+	if (data_server.pcb != NULL) {
+		if (TxQueue_Available(&data_server.transmit) < length) {
+			data_server.transmit.drops += length;
+			return;
+		}
+		TxQueue_Write(&data_server.transmit, data, length);
+		/* With nothing waiting to be acknowledged no segment will arrive to send the partial block */
+		DataServerFlush((tcp_sndbuf(data_server.pcb) == TCP_SND_BUF) ? TRUE : FALSE);
+	}
+}
+
+/**
+ * Retrieves the number of bytes which can be written to the data connection without waiting for the client.
+ *
+ * @param none
+ * @retval uint32_t The number of bytes.
+ */
+uint32_t DataServerGetWriteSpace(void) {
+	return (data_server.pcb != NULL) ? TxQueue_Available(&data_server.transmit) : 0U;
+}
+
+/**
+ * Waits for the client to acknowledge enough data that the specified number of bytes can be written. Received
+ * packets and the lwIP timers are serviced while waiting, so this must not be called from an lwIP callback.
+ *
+ * @param length uint32_t The number of bytes to make room for.
+ * @param timeout uint32_t The longest time to wait, in microseconds.
+ * @retval bool TRUE if there is room, FALSE if the time ran out or the connection was lost.
+ */
+bool DataServerWaitWriteSpace(uint32_t length, uint32_t timeout) {
+	uint64_t start = GetLocalTime();
+	while (TxQueue_Available(&data_server.transmit) < length) {
+		if ((data_server.pcb == NULL) || ((GetLocalTime() - start) >= timeout)) {
+#ifdef DATA_SERVER_DEBUG
+			printf("[Data Server] Data transmit queue is full!\n\r");
+#endif
+			return FALSE;
+		}
+		DataServerFlush(TRUE);
+		if (ETH_CheckFrameReceived()) {
+			LwIP_Pkt_Handle();
+		}
+		/* Handle periodic timers for LwIP */
+		LwIP_Periodic_Handle(GetLocalTime());
+	}
+	return TRUE;
+}
+
+/**
+ * Retrieves the transmit queue of the data connection, so its drop and high water counters can be reported.
+ *
+ * @param none
+ * @retval const TxQueue_t* Pointer to the queue.
+ */
+const TxQueue_t* DataServerGetTransmitQueue(void) {
+	return &data_server.transmit;
+}
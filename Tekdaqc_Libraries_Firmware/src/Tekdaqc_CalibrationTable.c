@@ -39,6 +39,7 @@
 #include "Tekdaqc_BSP.h"
 #include "TelnetServer.h"
 #include "Tekdaqc_Config.h"
+#include "Tekdaqc_SampleCorrection.h"
 #include <string.h>
 #include <stdio.h>
 #include <inttypes.h>
@@ -82,6 +83,25 @@ static uint32_t calColdJunctionGain = 0xFFFFFFFFU;
 /* The current analog input voltage scale being used. Defaulting to 400V range since the boards will be configured that way */
 static ANALOG_INPUT_SCALE_t CURRENT_ANALOG_SCALE = ANALOG_SCALE_400V;
 
+/* Cached Q1.31 gain corrections, valid while the matching generation equals gainCorrectionGeneration */
+static int32_t gainCorrectionCache[NUM_INPUT_RANGES][NUM_SAMPLE_RATES][NUM_PGA_SETTINGS][NUM_BUFFER_SETTINGS];
+
+/* The generation each cached gain correction was computed in */
+static uint16_t gainCorrectionCacheGeneration[NUM_INPUT_RANGES][NUM_SAMPLE_RATES][NUM_PGA_SETTINGS][NUM_BUFFER_SETTINGS];
+
+/* The current generation of the gain correction cache. Never zero, so a cleared entry is always stale */
+static uint16_t gainCorrectionGeneration = 1U;
+
+/* The board temperature the cached gain corrections are computed for. Seeded from the calibration table until the
+ first board temperature is measured */
+static float gainCorrectionTemperature = 0.0f;
+
+/* If gainCorrectionTemperature has been measured rather than seeded */
+static bool gainCorrectionMeasured = FALSE;
+
+/* The change in board temperature which invalidates the gain correction cache */
+static float gainCorrectionStep = GAIN_CORRECTION_CACHE_STEP;
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION PROTOTYPES */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -298,6 +318,10 @@ bool Tekdaqc_CalibrationInit(void) {
 			break;
 		}
 	}
+	/* Until the board temperature is measured, correct for the middle of the calibrated range */
+	if (*((uint32_t*) ((void *) calibrationTemps)) != CAL_INVALID_TEMP) {
+		gainCorrectionTemperature = (calibrationTemps[0] + calibrationTemps[maxValidTempIdx]) / 2.0f;
+	}
 	calColdJunctionOffset = (*(__IO uint32_t*) COLD_JUNCTION_OFFSET_ADDR);
 	calColdJunctionGain = (*(__IO uint32_t*) COLD_JUNCTION_GAIN_ADDR);
 	isCalibrationValid = ((*(__IO uint8_t*) CAL_VALID_ADDR_LO_ADDR) == CALIBRATION_VALID_LO_BYTE)
@@ -487,6 +511,89 @@ float Tekdaqc_GetGainCorrectionFactor(ADS1256_SPS_t rate, ADS1256_PGA_t gain, AD
 	return (InterpolateValue(data_low, data_high, factor));
 }
 
+/**
+ * Retrieves the gain calibration correction for the specified sampling parameters at the most recent board
+ * temperature given to Tekdaqc_UpdateGainCorrectionTemperature(), in the Q1.31 form used by SampleCorrection_t. The
+ * correction is computed from the calibration table the first time a combination is requested and after each
+ * invalidation, and served from RAM otherwise.
+ *
+ * @param rate ADS1256_SPS_t The sample rate to lookup for.
+ * @param gain ADS1256_PGA_t The gain to lookup for.
+ * @param buffer ADS1256_BUFFER_t The buffer setting to lookup for.
+ * @retval int32_t The Q1.31 gain correction.
+ */
+int32_t Tekdaqc_GetCachedGainCorrection(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1256_BUFFER_t buffer) {
+	uint8_t rate_index = 0U;
+	uint8_t gain_index = 0U;
+	uint8_t buffer_index = 0U;
+	uint8_t scale_index = 0U;
+	ComputeTableIndices(&rate_index, &gain_index, &buffer_index, &scale_index, rate, gain, buffer,
+			CURRENT_ANALOG_SCALE);
+	if (gainCorrectionCacheGeneration[scale_index][rate_index][gain_index][buffer_index] != gainCorrectionGeneration) {
+		gainCorrectionCache[scale_index][rate_index][gain_index][buffer_index] = SampleCorrection_GainFromFactor(
+				Tekdaqc_GetGainCorrectionFactor(rate, gain, buffer, gainCorrectionTemperature));
+		gainCorrectionCacheGeneration[scale_index][rate_index][gain_index][buffer_index] = gainCorrectionGeneration;
+	}
+	return gainCorrectionCache[scale_index][rate_index][gain_index][buffer_index];
+}
+
+/**
+ * Provides a new board temperature to the gain correction cache. The first measurement always replaces the seeded
+ * temperature. After that the cache is only invalidated once the temperature has moved by more than the configured
+ * step from the one the cached factors were computed for.
+ *
+ * @param temperature float The board temperature in degrees C.
+ * @retval none
+ */
+void Tekdaqc_UpdateGainCorrectionTemperature(float temperature) {
+	if ((gainCorrectionMeasured == FALSE) || (fabsf(temperature - gainCorrectionTemperature) > gainCorrectionStep)) {
+#ifdef CALIBRATION_TABLE_DEBUG
+		printf("[Calibration Table] Gain correction cache moving from %f to %f Deg C.\n\r", gainCorrectionTemperature,
+				temperature);
+#endif
+		gainCorrectionTemperature = temperature;
+		gainCorrectionMeasured = TRUE;
+		Tekdaqc_InvalidateGainCorrectionCache();
+	}
+}
+
+/**
+ * Sets the change in board temperature which invalidates the gain correction cache. A step of zero recomputes the
+ * factors on every temperature change.
+ *
+ * @param step float The temperature step in degrees C.
+ * @retval none
+ */
+void Tekdaqc_SetGainCorrectionStep(float step) {
+	gainCorrectionStep = (step < 0.0f) ? 0.0f : step;
+}
+
+/**
+ * Retrieves the change in board temperature which invalidates the gain correction cache.
+ *
+ * @param none
+ * @retval float The temperature step in degrees C.
+ */
+float Tekdaqc_GetGainCorrectionStep(void) {
+	return gainCorrectionStep;
+}
+
+/**
+ * Discards every cached gain correction so that each is recomputed on its next use. Must be called whenever
+ * the calibration table or its validity changes.
+ *
+ * @param none
+ * @retval none
+ */
+void Tekdaqc_InvalidateGainCorrectionCache(void) {
+	++gainCorrectionGeneration;
+	if (gainCorrectionGeneration == 0U) {
+		/* Wrapped, so old entries could match again. Clear them all and skip the reserved generation */
+		memset(gainCorrectionCacheGeneration, 0, sizeof(gainCorrectionCacheGeneration));
+		gainCorrectionGeneration = 1U;
+	}
+}
+
 /**
  * Retrieve the offset calibration value for the specified sampling parameters.
  *
@@ -564,6 +671,7 @@ FLASH_Status Tekdaqc_SetCalibrationMode(void) {
 		return status;
 	}
 
+	Tekdaqc_InvalidateGainCorrectionCache();
 	CalibrationModeEnabled = true;
 	return status;
 }
@@ -586,6 +694,7 @@ void Tekdaqc_EndCalibrationMode(void) {
 	 to protect the FLASH memory against possible unwanted operation) */
 	FLASH_Lock();
 
+	Tekdaqc_InvalidateGainCorrectionCache();
 	CalibrationModeEnabled = false;
 }
 
@@ -663,8 +772,10 @@ FLASH_Status Tekdaqc_SetCalibrationTemperature(float temp, uint8_t temp_idx) {
 	/* Convert the floating point value into a byte equivilant uint32_t */
 	uint32_t* value = (uint32_t*) ((void*) &temp);
 	FLASH_Status status = FLASH_ProgramWord(address, *value);
-	if (status == FLASH_COMPLETE)
+	if (status == FLASH_COMPLETE) {
 		calibrationTemps[temp_idx] = temp;
+		Tekdaqc_InvalidateGainCorrectionCache();
+	}
 #ifdef CALIBRATION_TABLE_DEBUG
 	printf("[Calibration Table] Flash Status: %i\n\r", status);
 #endif
@@ -691,6 +802,7 @@ FLASH_Status Tekdaqc_SetCalibrationValid(void) {
 	if (status == FLASH_COMPLETE)
 		status = FLASH_ProgramByte(CAL_VALID_ADDR_HI_ADDR, CALIBRATION_VALID_HI_BYTE);
 	isCalibrationValid = (status == FLASH_COMPLETE) ? true : false;
+	Tekdaqc_InvalidateGainCorrectionCache();
 	return status;
 }
 
@@ -725,6 +837,7 @@ FLASH_Status Tekdaqc_SetGainCalibration(float cal, ADS1256_SPS_t rate, ADS1256_P
 	printf("[Calibration Table] Flash Status: %i - 0x%08" PRIX32 "\n\r", status, FLASH->SR);
 #endif
 	EnableBoardInterrupts();
+	Tekdaqc_InvalidateGainCorrectionCache();
 	return status;
 }
 
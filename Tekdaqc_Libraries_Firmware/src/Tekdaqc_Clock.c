@@ -0,0 +1,308 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_Clock.c
+ * @brief Monotonic local time clock kept by the DWT cycle counter.
+ *
+ * The clock is set once, then counts the core clock with the DWT cycle counter. The 32 bit counter wraps every 25.6
+ * seconds, so it is extended to 64 bits by recording each reading from the SYSTICK interrupt and counting the wraps.
+ * Reading the clock is a counter read, a multiply and a shift, with no peripheral access.
+ *
+ * Periodically the clock is compared against a reference such as the RTC. Small errors are slewed out by trimming the
+ * rate, so the clock never runs backwards, and the trim also learns the rate error of the crystal. Large errors, such
+ * as the reference being set, step the clock.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_Clock.h"
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#include <inttypes.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def CLOCK_FRACTION_MASK
+ * @brief Mask of the fractional microsecond bits.
+ */
+#define CLOCK_FRACTION_MASK			((((uint64_t) 1U) << CLOCK_SCALE_SHIFT) - 1U)
+
+/**
+ * @internal
+ * @def CLOCK_PPB
+ * @brief Parts per billion.
+ */
+#define CLOCK_PPB					1000000000
+
+/**
+ * @internal
+ * @def CLOCK_FREQUENCY_GAIN
+ * @brief The divider applied to each measured rate error before it is added to the learned rate error.
+ */
+#define CLOCK_FREQUENCY_GAIN		4
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The clock's time base */
+static Clock_Timebase_t clockBase;
+
+/* Odd while the time base is being changed */
+static volatile uint32_t clockSequence = 0U;
+
+/* The extended cycle count of the next comparison against the reference */
+static uint64_t nextDiscipline = 0U;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Limits a rate correction to CLOCK_MAX_TRIM.
+ */
+static int32_t Clock_ClampTrim(int64_t trim);
+
+/**
+ * @internal
+ * @brief Moves the anchor of a time base to a cycle count without changing the time.
+ */
+static void Clock_Rebase(Clock_Timebase_t* base, uint64_t cycles);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Limits a rate correction to CLOCK_MAX_TRIM either way.
+ *
+ * @param trim int64_t The rate correction in parts per billion.
+ * @retval int32_t The limited rate correction.
+ */
+static int32_t Clock_ClampTrim(int64_t trim) {
+	if (trim > CLOCK_MAX_TRIM) {
+		return CLOCK_MAX_TRIM;
+	} else if (trim < -CLOCK_MAX_TRIM) {
+		return -CLOCK_MAX_TRIM;
+	}
+	return (int32_t) trim;
+}
+
+/**
+ * Moves the anchor of a time base to a cycle count, carrying the time (including the fractional microseconds) along
+ * so that the time reported at that cycle count is unchanged.
+ *
+ * @param base Clock_Timebase_t* The time base.
+ * @param cycles uint64_t The extended cycle count to move the anchor to. Must be at or after the current anchor.
+ * @retval none
+ */
+static void Clock_Rebase(Clock_Timebase_t* base, uint64_t cycles) {
+	uint64_t delta = cycles - base->anchorCycles;
+	uint64_t total;
+	while (delta > 0U) {
+		uint32_t step = (delta > CLOCK_ANCHOR_STEP) ? (uint32_t) CLOCK_ANCHOR_STEP : (uint32_t) delta;
+		total = ((uint64_t) step * base->scale) + base->anchorFraction;
+		base->anchorTime += total >> CLOCK_SCALE_SHIFT;
+		base->anchorFraction = total & CLOCK_FRACTION_MASK;
+		base->anchorCycles += step;
+		delta -= step;
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Initializes a time base so that a cycle counter reading corresponds to a time, running at the nominal rate.
+ *
+ * @param base Clock_Timebase_t* The time base.
+ * @param cycles uint32_t The cycle counter reading.
+ * @param time uint64_t The local time at that reading, in microseconds.
+ * @retval none
+ */
+void Clock_TimebaseInit(Clock_Timebase_t* base, uint32_t cycles, uint64_t time) {
+	base->cycleHigh = 0U;
+	base->lastCycles = cycles;
+	base->anchorCycles = cycles;
+	base->anchorTime = time;
+	base->anchorFraction = 0U;
+	base->scale = CLOCK_NOMINAL_SCALE;
+	base->frequency = 0;
+}
+
+/**
+ * Extends a cycle counter reading to 64 bits. The reading must be taken less than one wrap (25.6 seconds) after the
+ * last call to Clock_TimebaseAdvance().
+ *
+ * @param base const Clock_Timebase_t* The time base.
+ * @param cycles uint32_t The cycle counter reading.
+ * @retval uint64_t The extended cycle count.
+ */
+uint64_t Clock_TimebaseExtend(const Clock_Timebase_t* base, uint32_t cycles) {
+	uint32_t high = base->cycleHigh;
+	if (cycles < base->lastCycles) {
+		++high;
+	}
+	return (((uint64_t) high) << 32U) | cycles;
+}
+
+/**
+ * Records a cycle counter reading, counting a wrap if there was one and moving the anchor forward once it falls a full
+ * step behind.
+ *
+ * @param base Clock_Timebase_t* The time base.
+ * @param cycles uint32_t The cycle counter reading.
+ * @retval uint64_t The extended cycle count.
+ */
+uint64_t Clock_TimebaseAdvance(Clock_Timebase_t* base, uint32_t cycles) {
+	uint64_t extended = Clock_TimebaseExtend(base, cycles);
+	base->cycleHigh = (uint32_t) (extended >> 32U);
+	base->lastCycles = cycles;
+	if ((extended - base->anchorCycles) >= CLOCK_ANCHOR_STEP) {
+		Clock_Rebase(base, extended);
+	}
+	return extended;
+}
+
+/**
+ * Converts an extended cycle count into local time. The count must be at or after the anchor and less than
+ * CLOCK_ANCHOR_STEP past it, which holds for any count taken since the last advance.
+ *
+ * @param base const Clock_Timebase_t* The time base.
+ * @param cycles uint64_t The extended cycle count.
+ * @retval uint64_t The local time in microseconds.
+ */
+uint64_t Clock_TimebaseToTime(const Clock_Timebase_t* base, uint64_t cycles) {
+	uint32_t delta = (uint32_t) (cycles - base->anchorCycles);
+	return base->anchorTime + ((((uint64_t) delta * base->scale) + base->anchorFraction) >> CLOCK_SCALE_SHIFT);
+}
+
+/**
+ * Corrects a time base against a reference time, taken at the given cycle count. An error of up to
+ * CLOCK_STEP_THRESHOLD is slewed out over the next CLOCK_DISCIPLINE_INTERVAL, with part of it kept as a learned rate
+ * error. Larger errors step the time to the reference.
+ *
+ * @param base Clock_Timebase_t* The time base.
+ * @param cycles uint64_t The extended cycle count the reference was taken at.
+ * @param reference uint64_t The reference time in microseconds.
+ * @retval none
+ */
+void Clock_TimebaseDiscipline(Clock_Timebase_t* base, uint64_t cycles, uint64_t reference) {
+	int64_t error;
+	int64_t rate;
+	int32_t trim;
+	Clock_Rebase(base, cycles);
+	error = (int64_t) (reference - base->anchorTime);
+	if ((error > CLOCK_STEP_THRESHOLD) || (error < -CLOCK_STEP_THRESHOLD)) {
+		base->anchorTime = reference;
+		base->anchorFraction = 0U;
+		trim = base->frequency;
+	} else {
+		rate = (error * CLOCK_PPB) / (int64_t) CLOCK_DISCIPLINE_INTERVAL;
+		base->frequency = Clock_ClampTrim(base->frequency + (rate / CLOCK_FREQUENCY_GAIN));
+		trim = Clock_ClampTrim(base->frequency + rate);
+	}
+	base->scale = (uint32_t) ((int64_t) CLOCK_NOMINAL_SCALE + (((int64_t) CLOCK_NOMINAL_SCALE * trim) / CLOCK_PPB));
+}
+
+/**
+ * Starts the DWT cycle counter and sets the clock.
+ *
+ * @param time uint64_t The local time to start from, in microseconds.
+ * @retval none
+ */
+void Clock_Init(uint64_t time) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0U;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	++clockSequence;
+	__DMB();
+	Clock_TimebaseInit(&clockBase, DWT->CYCCNT, time);
+	nextDiscipline = clockBase.anchorCycles + ((uint64_t) CLOCK_DISCIPLINE_INTERVAL * CLOCK_CYCLES_PER_US);
+	__DMB();
+	++clockSequence;
+}
+
+/**
+ * Keeps the clock's extension current. This must be called at least once per wrap of the cycle counter and is called
+ * from the SYSTICK interrupt.
+ *
+ * @param none
+ * @retval bool TRUE if it is time to call Clock_Discipline().
+ */
+bool Clock_Update(void) {
+	uint64_t cycles;
+	++clockSequence;
+	__DMB();
+	cycles = Clock_TimebaseAdvance(&clockBase, DWT->CYCCNT);
+	__DMB();
+	++clockSequence;
+	return (cycles >= nextDiscipline) ? TRUE : FALSE;
+}
+
+/**
+ * Corrects the clock against a reference time read just before the call. Must be called from the same context as
+ * Clock_Update().
+ *
+ * @param reference uint64_t The reference time in microseconds.
+ * @retval none
+ */
+void Clock_Discipline(uint64_t reference) {
+	uint64_t cycles;
+	++clockSequence;
+	__DMB();
+	cycles = Clock_TimebaseAdvance(&clockBase, DWT->CYCCNT);
+#ifdef CLOCK_DEBUG
+	printf("[Clock] Error against reference: %" PRIi64 " us.\n\r",
+			(int64_t) (reference - Clock_TimebaseToTime(&clockBase, cycles)));
+#endif
+	Clock_TimebaseDiscipline(&clockBase, cycles, reference);
+	nextDiscipline = cycles + ((uint64_t) CLOCK_DISCIPLINE_INTERVAL * CLOCK_CYCLES_PER_US);
+	__DMB();
+	++clockSequence;
+}
+
+/**
+ * Retrieves the current local time. Safe to call from any context.
+ *
+ * @param none
+ * @retval uint64_t The local time in microseconds.
+ */
+uint64_t Clock_GetTime(void) {
+	Clock_Timebase_t base;
+	uint32_t sequence;
+	uint32_t cycles;
+	do {
+		sequence = clockSequence;
+		__DMB();
+		base = clockBase;
+		cycles = DWT->CYCCNT;
+		__DMB();
+	} while (((sequence & 1U) != 0U) || (sequence != clockSequence));
+	return Clock_TimebaseToTime(&base, Clock_TimebaseExtend(&base, cycles));
+}
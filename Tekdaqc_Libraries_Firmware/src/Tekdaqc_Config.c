@@ -33,6 +33,7 @@
 #include "Tekdaqc_RTC.h"
 #include "TelnetServer.h"
 #include "Tekdaqc_CalibrationTable.h"
+#include "Tekdaqc_Memory.h"
 #include "eeprom.h"
 #include "stm32f4x7_eth_bsp.h"
 #include "stm32f4xx.h"
@@ -90,7 +91,7 @@ static GPIO_TypeDef* COM_RX_PORT[COMn] = { COM1_RX_GPIO_PORT, COM2_RX_GPIO_PORT
 /*--------------------------------------------------------------------------------------------------------*/
 
 /* Definition of the global TOSTRING_BUFFER */
-char TOSTRING_BUFFER[SIZE_TOSTRING_BUFFER];
+char TOSTRING_BUFFER[SIZE_TOSTRING_BUFFER] CCM_BSS;
 
 /* Definition of the Tekdaqc's serial number */
 unsigned char TEKDAQC_BOARD_SERIAL_NUM[BOARD_SERIAL_NUM_LENGTH + 1]; /* 32 chars plus NULL termination */
@@ -0,0 +1,355 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_DataFrame.c
+ * @brief Encodes samples into the Tekdaqc binary data frame format.
+ *
+ * See Tekdaqc_DataFrame.h for the frame layout.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_DataFrame.h"
+#include "boolean.h"
+#include <string.h>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def DATA_FRAME_24_BIT_MIN
+ * @brief The smallest value which can be sent in a 24 bit frame.
+ */
+#define DATA_FRAME_24_BIT_MIN (-8388608)
+
+/**
+ * @internal
+ * @def DATA_FRAME_24_BIT_MAX
+ * @brief The largest value which can be sent in a 24 bit frame.
+ */
+#define DATA_FRAME_24_BIT_MAX (8388607)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* Nibble lookup table for the CRC-16/CCITT polynomial 0x1021. */
+static const uint16_t CRC16_TABLE[16] = { 0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+		0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU };
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Writes the sync and type bytes of a frame.
+ */
+static uint32_t DataFrame_Begin(uint8_t* frame, DataFrame_Type_t type);
+
+/**
+ * @internal
+ * @brief Writes a packed timestamp into a frame.
+ */
+static uint32_t DataFrame_PutTimestamp(uint8_t* frame, uint64_t timestamp);
+
+/**
+ * @internal
+ * @brief Writes a little endian 32 bit word into a frame.
+ */
+static uint32_t DataFrame_PutWord(uint8_t* frame, uint32_t word);
+
+/**
+ * @internal
+ * @brief Writes the sync and type bytes and the common sample fields.
+ */
+static uint32_t DataFrame_BeginSample(uint8_t* frame, DataFrame_Type_t type, uint8_t channel, uint64_t timestamp);
+
+/**
+ * @internal
+ * @brief Fills in the payload length and appends the CRC.
+ */
+static uint32_t DataFrame_Finish(uint8_t* frame, uint32_t length);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Writes the sync and type bytes of a frame and skips over the payload length, which is filled in by
+ * DataFrame_Finish().
+ *
+ * @param frame uint8_t* The frame buffer.
+ * @param type DataFrame_Type_t The frame type.
+ * @retval uint32_t The number of bytes written.
+ */
+static uint32_t DataFrame_Begin(uint8_t* frame, DataFrame_Type_t type) {
+	frame[0] = DATA_FRAME_SYNC;
+	frame[1] = (uint8_t) type;
+	return DATA_FRAME_HEADER_SIZE;
+}
+
+/**
+ * Writes a packed timestamp into a frame.
+ *
+ * @param frame uint8_t* The destination in the frame buffer.
+ * @param timestamp uint64_t The time in microseconds since the UNIX epoch.
+ * @retval uint32_t The number of bytes written.
+ */
+static uint32_t DataFrame_PutTimestamp(uint8_t* frame, uint64_t timestamp) {
+	for (uint_fast8_t i = 0U; i < DATA_FRAME_TIMESTAMP_SIZE; ++i) {
+		frame[i] = (uint8_t) (timestamp >> (8U * i));
+	}
+	return DATA_FRAME_TIMESTAMP_SIZE;
+}
+
+/**
+ * Writes a little endian 32 bit word into a frame.
+ *
+ * @param frame uint8_t* The destination in the frame buffer.
+ * @param word uint32_t The word to write.
+ * @retval uint32_t The number of bytes written.
+ */
+static uint32_t DataFrame_PutWord(uint8_t* frame, uint32_t word) {
+	frame[0] = (uint8_t) word;
+	frame[1] = (uint8_t) (word >> 8U);
+	frame[2] = (uint8_t) (word >> 16U);
+	frame[3] = (uint8_t) (word >> 24U);
+	return 4U;
+}
+
+/**
+ * Writes the sync and type bytes of a frame, followed by the channel and packed timestamp which begin every sample
+ * payload.
+ *
+ * @param frame uint8_t* The frame buffer.
+ * @param type DataFrame_Type_t The frame type.
+ * @param channel uint8_t The physical channel the sample was taken from.
+ * @param timestamp uint64_t The time of the sample in microseconds since the UNIX epoch.
+ * @retval uint32_t The number of bytes written.
+ */
+static uint32_t DataFrame_BeginSample(uint8_t* frame, DataFrame_Type_t type, uint8_t channel, uint64_t timestamp) {
+	uint32_t idx = DataFrame_Begin(frame, type);
+	frame[idx++] = channel;
+	idx += DataFrame_PutTimestamp(frame + idx, timestamp);
+	return idx;
+}
+
+/**
+ * Fills in the payload length of a frame and appends the CRC over everything before it.
+ *
+ * @param frame uint8_t* The frame buffer.
+ * @param length uint32_t The number of bytes written to the frame so far, including the header.
+ * @retval uint32_t The total length of the frame.
+ */
+static uint32_t DataFrame_Finish(uint8_t* frame, uint32_t length) {
+	uint32_t payload = length - DATA_FRAME_HEADER_SIZE;
+	frame[2] = (uint8_t) payload;
+	frame[3] = (uint8_t) (payload >> 8U);
+	uint16_t crc = DataFrame_CRC16(frame, length, DATA_FRAME_CRC_INIT);
+	frame[length++] = (uint8_t) crc;
+	frame[length++] = (uint8_t) (crc >> 8U);
+	return length;
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Updates a CRC-16/CCITT (polynomial 0x1021, no reflection) with the provided bytes. Pass DATA_FRAME_CRC_INIT as
+ * the starting value, or the previous result to continue a CRC across several calls.
+ *
+ * @param data const uint8_t* The bytes to add to the CRC.
+ * @param length uint32_t The number of bytes.
+ * @param crc uint16_t The CRC so far.
+ * @retval uint16_t The updated CRC.
+ */
+uint16_t DataFrame_CRC16(const uint8_t* data, uint32_t length, uint16_t crc) {
+	while (length-- > 0U) {
+		crc = (uint16_t) ((crc << 4U) ^ CRC16_TABLE[(crc >> 12U) ^ (*data >> 4U)]);
+		crc = (uint16_t) ((crc << 4U) ^ CRC16_TABLE[(crc >> 12U) ^ (*data & 0x0FU)]);
+		++data;
+	}
+	return crc;
+}
+
+/**
+ * Encodes an analog sample frame. Values which fit in 24 bits are sent as a DATA_FRAME_ANALOG_24 frame, anything
+ * else as a DATA_FRAME_ANALOG_32 frame.
+ *
+ * @param frame uint8_t* The destination buffer, at least DATA_FRAME_MAX_SAMPLE_SIZE bytes.
+ * @param channel uint8_t The physical channel the sample was taken from.
+ * @param timestamp uint64_t The time of the sample in microseconds since the UNIX epoch.
+ * @param value int32_t The sample value.
+ * @retval uint32_t The length of the encoded frame.
+ */
+uint32_t DataFrame_EncodeAnalog(uint8_t* frame, uint8_t channel, uint64_t timestamp, int32_t value) {
+	bool wide = (value < DATA_FRAME_24_BIT_MIN) || (value > DATA_FRAME_24_BIT_MAX);
+	uint32_t idx = DataFrame_BeginSample(frame, (wide == true) ? DATA_FRAME_ANALOG_32 : DATA_FRAME_ANALOG_24, channel,
+			timestamp);
+	frame[idx++] = (uint8_t) value;
+	frame[idx++] = (uint8_t) (value >> 8U);
+	frame[idx++] = (uint8_t) (value >> 16U);
+	if (wide == true) {
+		frame[idx++] = (uint8_t) (value >> 24U);
+	}
+	return DataFrame_Finish(frame, idx);
+}
+
+/**
+ * Encodes a digital sample frame.
+ *
+ * @param frame uint8_t* The destination buffer, at least DATA_FRAME_MAX_SAMPLE_SIZE bytes.
+ * @param channel uint8_t The digital input the sample was taken from.
+ * @param timestamp uint64_t The time of the sample in microseconds since the UNIX epoch.
+ * @param level uint8_t The logic level read.
+ * @retval uint32_t The length of the encoded frame.
+ */
+uint32_t DataFrame_EncodeDigital(uint8_t* frame, uint8_t channel, uint64_t timestamp, uint8_t level) {
+	uint32_t idx = DataFrame_BeginSample(frame, DATA_FRAME_DIGITAL, channel, timestamp);
+	frame[idx++] = level;
+	return DataFrame_Finish(frame, idx);
+}
+
+/**
+ * Encodes a block of analog samples from a single channel. The timing and value fields are sized to the smallest
+ * width which holds every sample in the block, and the deltas are dropped entirely in favor of a single period when
+ * the samples are evenly spaced.
+ *
+ * @param frame uint8_t* The destination buffer, at least DATA_FRAME_MAX_BLOCK_SIZE(count) bytes.
+ * @param channel uint8_t The physical channel the samples were taken from.
+ * @param timestamps const uint64_t* The times of the samples in microseconds since the UNIX epoch. Must not decrease,
+ * and no two consecutive samples may be more than 2^32 - 1 microseconds apart.
+ * @param values const int32_t* The sample values.
+ * @param count uint8_t The number of samples, from 1 to DATA_FRAME_MAX_BLOCK_SAMPLES.
+ * @retval uint32_t The length of the encoded frame.
+ */
+uint32_t DataFrame_EncodeAnalogBlock(uint8_t* frame, uint8_t channel, const uint64_t* timestamps, const int32_t* values,
+		uint8_t count) {
+	uint8_t flags = 0U;
+	uint32_t period = 0U;
+	uint32_t delta;
+	if (count > 1U) {
+		flags |= DATA_FRAME_BLOCK_FIXED_RATE;
+		period = (uint32_t) (timestamps[1] - timestamps[0]);
+	}
+	for (uint_fast8_t i = 0U; i < count; ++i) {
+		if (i > 0U) {
+			delta = (uint32_t) (timestamps[i] - timestamps[i - 1U]);
+			if (delta != period) {
+				flags &= (uint8_t) ~DATA_FRAME_BLOCK_FIXED_RATE;
+			}
+			if (delta > 0xFFFFU) {
+				flags |= DATA_FRAME_BLOCK_WIDE_DELTAS;
+			}
+		}
+		if ((values[i] < DATA_FRAME_24_BIT_MIN) || (values[i] > DATA_FRAME_24_BIT_MAX)) {
+			flags |= DATA_FRAME_BLOCK_WIDE_VALUES;
+		}
+	}
+
+	uint32_t idx = DataFrame_Begin(frame, DATA_FRAME_ANALOG_BLOCK);
+	frame[idx++] = channel;
+	frame[idx++] = count;
+	frame[idx++] = flags;
+	idx += DataFrame_PutTimestamp(frame + idx, timestamps[0]);
+	uint_fast8_t deltas = ((flags & DATA_FRAME_BLOCK_FIXED_RATE) != 0U) ? 1U : (uint_fast8_t) (count - 1U);
+	for (uint_fast8_t i = 1U; i <= deltas; ++i) {
+		delta = (uint32_t) (timestamps[i] - timestamps[i - 1U]);
+		frame[idx++] = (uint8_t) delta;
+		frame[idx++] = (uint8_t) (delta >> 8U);
+		if ((flags & DATA_FRAME_BLOCK_WIDE_DELTAS) != 0U) {
+			frame[idx++] = (uint8_t) (delta >> 16U);
+			frame[idx++] = (uint8_t) (delta >> 24U);
+		}
+	}
+	for (uint_fast8_t i = 0U; i < count; ++i) {
+		frame[idx++] = (uint8_t) values[i];
+		frame[idx++] = (uint8_t) (values[i] >> 8U);
+		frame[idx++] = (uint8_t) (values[i] >> 16U);
+		if ((flags & DATA_FRAME_BLOCK_WIDE_VALUES) != 0U) {
+			frame[idx++] = (uint8_t) (values[i] >> 24U);
+		}
+	}
+	return DataFrame_Finish(frame, idx);
+}
+
+/**
+ * Encodes a statistics frame summarizing a window of analog samples from a single channel.
+ *
+ * @param frame uint8_t* The destination buffer, at least DATA_FRAME_STATISTICS_SIZE bytes.
+ * @param channel uint8_t The physical channel the samples were taken from.
+ * @param statistics const DataFrame_Statistics_t* The statistics of the window.
+ * @retval uint32_t The length of the encoded frame.
+ */
+uint32_t DataFrame_EncodeAnalogStatistics(uint8_t* frame, uint8_t channel, const DataFrame_Statistics_t* statistics) {
+	const float moments[3] = { statistics->mean, statistics->rms, statistics->stddev };
+	uint32_t word;
+	uint32_t idx = DataFrame_Begin(frame, DATA_FRAME_ANALOG_STATISTICS);
+	frame[idx++] = channel;
+	idx += DataFrame_PutTimestamp(frame + idx, statistics->start);
+	idx += DataFrame_PutTimestamp(frame + idx, statistics->end);
+	idx += DataFrame_PutWord(frame + idx, statistics->count);
+	idx += DataFrame_PutWord(frame + idx, (uint32_t) statistics->min);
+	idx += DataFrame_PutWord(frame + idx, (uint32_t) statistics->max);
+	for (uint_fast8_t i = 0U; i < 3U; ++i) {
+		/* Sent as the raw IEEE-754 bits */
+		memcpy(&word, &moments[i], sizeof(word));
+		idx += DataFrame_PutWord(frame + idx, word);
+	}
+	return DataFrame_Finish(frame, idx);
+}
+
+/**
+ * Encodes an alarm frame reporting an analog channel changing range state.
+ *
+ * @param frame uint8_t* The destination buffer, at least DATA_FRAME_ALARM_SIZE bytes.
+ * @param channel uint8_t The physical channel.
+ * @param timestamp uint64_t The time of the sample which caused the transition, in microseconds since the UNIX epoch.
+ * @param state uint8_t The new range state.
+ * @param value int32_t The sample value.
+ * @retval uint32_t The length of the encoded frame.
+ */
+uint32_t DataFrame_EncodeAnalogAlarm(uint8_t* frame, uint8_t channel, uint64_t timestamp, uint8_t state, int32_t value) {
+	uint32_t idx = DataFrame_BeginSample(frame, DATA_FRAME_ANALOG_ALARM, channel, timestamp);
+	frame[idx++] = state;
+	idx += DataFrame_PutWord(frame + idx, (uint32_t) value);
+	return DataFrame_Finish(frame, idx);
+}
+
+/**
+ * Encodes a frame reporting data which was not written because the connection could not keep up.
+ *
+ * @param frame uint8_t* The destination buffer, at least DATA_FRAME_SHED_SIZE bytes.
+ * @param timestamp uint64_t The time of the report, in microseconds since the UNIX epoch.
+ * @param policy uint8_t The output backpressure policy which shed the data.
+ * @param count uint32_t The number of records shed since the previous report.
+ * @retval uint32_t The length of the encoded frame.
+ */
+uint32_t DataFrame_EncodeShed(uint8_t* frame, uint64_t timestamp, uint8_t policy, uint32_t count) {
+	uint32_t idx = DataFrame_Begin(frame, DATA_FRAME_SHED);
+	idx += DataFrame_PutTimestamp(frame + idx, timestamp);
+	frame[idx++] = policy;
+	idx += DataFrame_PutWord(frame + idx, count);
+	return DataFrame_Finish(frame, idx);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_RingBuffer.c
+ * @brief Single producer, single consumer ring buffer.
+ *
+ * A lock free ring buffer of fixed size elements. One context (typically an interrupt) writes and one context
+ * (typically the main loop) reads. Each side only ever stores to its own index, and a data memory barrier orders
+ * the element copy against the index store, so a reader never sees an index before the element it covers.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_RingBuffer.h"
+#include "Tekdaqc_Config.h"
+#include <string.h>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Initializes a ring buffer over the provided storage. The buffer starts empty with cleared counters.
+ *
+ * @param ring RingBuffer_t* Pointer to the ring buffer to initialize.
+ * @param storage void* Pointer to storage for at least capacity elements.
+ * @param elementSize uint32_t The size of a single element in bytes.
+ * @param capacity uint32_t The number of elements the buffer can hold. Must be a power of two.
+ * @retval none
+ */
+void RingBuffer_Init(RingBuffer_t* ring, void* storage, uint32_t elementSize, uint32_t capacity) {
+	assert_param(IS_RING_BUFFER_CAPACITY(capacity));
+	ring->data = (uint8_t*) storage;
+	ring->elementSize = elementSize;
+	ring->mask = capacity - 1U;
+	RingBuffer_Reset(ring);
+}
+
+/**
+ * Discards all elements and clears the counters of a ring buffer. Neither the producer nor the consumer may be
+ * active while this is called.
+ *
+ * @param ring RingBuffer_t* Pointer to the ring buffer to reset.
+ * @retval none
+ */
+void RingBuffer_Reset(RingBuffer_t* ring) {
+	ring->head = 0U;
+	ring->tail = 0U;
+	ring->drops = 0U;
+	ring->highWater = 0U;
+}
+
+/**
+ * Copies an element into the ring buffer. If the buffer is full the element is discarded and counted as a drop.
+ * Must only be called from the producer context.
+ *
+ * @param ring RingBuffer_t* Pointer to the ring buffer to write to.
+ * @param element const void* Pointer to the element to copy in.
+ * @retval bool TRUE if the element was stored, FALSE if it was dropped.
+ */
+bool RingBuffer_Write(RingBuffer_t* ring, const void* element) {
+	uint32_t head = ring->head;
+	uint32_t tail = ring->tail; /* Acquire the consumer's index */
+	__DMB(); /* The slot may not be overwritten until the consumer is done reading it */
+	uint32_t used = head - tail;
+	if (used > ring->mask) {
+		++ring->drops;
+		return FALSE;
+	}
+	memcpy(ring->data + ((head & ring->mask) * ring->elementSize), element, ring->elementSize);
+	__DMB(); /* Release the element before publishing it */
+	ring->head = head + 1U;
+	if (used + 1U > ring->highWater) {
+		ring->highWater = used + 1U;
+	}
+	return TRUE;
+}
+
+/**
+ * Copies the oldest element out of the ring buffer. Must only be called from the consumer context.
+ *
+ * @param ring RingBuffer_t* Pointer to the ring buffer to read from.
+ * @param element void* Pointer to the destination for the element.
+ * @retval bool TRUE if an element was read, FALSE if the buffer was empty.
+ */
+bool RingBuffer_Read(RingBuffer_t* ring, void* element) {
+	uint32_t tail = ring->tail;
+	uint32_t head = ring->head; /* Acquire the producer's index */
+	__DMB(); /* The element may not be read before the index which published it */
+	if (head == tail) {
+		return FALSE;
+	}
+	memcpy(element, ring->data + ((tail & ring->mask) * ring->elementSize), ring->elementSize);
+	__DMB(); /* Release the slot back to the producer */
+	ring->tail = tail + 1U;
+	return TRUE;
+}
+
+/**
+ * Retrieves the number of elements currently held in the ring buffer. The value is exact from either the producer
+ * or consumer context, and a snapshot from anywhere else.
+ *
+ * @param ring const RingBuffer_t* Pointer to the ring buffer.
+ * @retval uint32_t The number of elements held.
+ */
+uint32_t RingBuffer_Count(const RingBuffer_t* ring) {
+	uint32_t tail = ring->tail;
+	return (ring->head - tail);
+}
+
+/**
+ * Retrieves a snapshot of the ring buffer's counters.
+ *
+ * @param ring const RingBuffer_t* Pointer to the ring buffer.
+ * @param stats RingBuffer_Statistics_t* Pointer to the structure to fill.
+ * @retval none
+ */
+void RingBuffer_GetStatistics(const RingBuffer_t* ring, RingBuffer_Statistics_t* stats) {
+	stats->capacity = ring->mask + 1U;
+	stats->total = ring->head; /* The head only ever counts accepted elements */
+	stats->count = RingBuffer_Count(ring);
+	stats->drops = ring->drops;
+	stats->highWater = ring->highWater;
+}
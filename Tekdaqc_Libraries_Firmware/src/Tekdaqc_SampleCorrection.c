@@ -0,0 +1,215 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_SampleCorrection.c
+ * @brief Fixed point sample correction pipeline.
+ *
+ * Applies the gain correction, offset and user scale to ADC readings without touching the FPU. Every product is
+ * formed in 64 bits and rounded half away from zero, matching roundf() on the floating point path, then saturated to
+ * the int32_t range.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_SampleCorrection.h"
+#include <math.h>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def SAMPLE_CORRECTION_RAW_MASK
+ * @brief The bits of a raw reading which hold the 24 bit conversion result.
+ */
+#define SAMPLE_CORRECTION_RAW_MASK		((uint32_t) 0x00FFFFFFU)
+
+/**
+ * @internal
+ * @def SAMPLE_CORRECTION_GAIN_SHIFT
+ * @brief The number of fractional bits in the gain correction.
+ */
+#define SAMPLE_CORRECTION_GAIN_SHIFT	31U
+
+/**
+ * @internal
+ * @def SAMPLE_CORRECTION_SCALE_SHIFT
+ * @brief The number of fractional bits in the user scale.
+ */
+#define SAMPLE_CORRECTION_SCALE_SHIFT	16U
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION PROTOTYPES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @brief Saturates a 64 bit value to the int32_t range.
+ */
+static inline int32_t SampleCorrection_Saturate(int64_t value);
+
+/**
+ * @internal
+ * @brief Shifts a 64 bit product right, rounding half away from zero.
+ */
+static inline int64_t SampleCorrection_RoundShift(int64_t value, uint32_t shift);
+
+/**
+ * @internal
+ * @brief Runs a sign extended reading through the pipeline.
+ */
+static inline int32_t SampleCorrection_Correct(const SampleCorrection_t* correction, int32_t code);
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Saturates a 64 bit value to the int32_t range.
+ *
+ * @param value int64_t The value to saturate.
+ * @retval int32_t The saturated value.
+ */
+static inline int32_t SampleCorrection_Saturate(int64_t value) {
+	if (value > INT32_MAX) {
+		return INT32_MAX;
+	} else if (value < INT32_MIN) {
+		return INT32_MIN;
+	}
+	return (int32_t) value;
+}
+
+/**
+ * Shifts a 64 bit product right, rounding half away from zero so that results match roundf().
+ *
+ * @param value int64_t The product to shift.
+ * @param shift uint32_t The number of fractional bits to remove.
+ * @retval int64_t The rounded quotient.
+ */
+static inline int64_t SampleCorrection_RoundShift(int64_t value, uint32_t shift) {
+	int64_t half = ((int64_t) 1) << (shift - 1U);
+	if (value < 0) {
+		return -((-value + half) >> shift);
+	}
+	return (value + half) >> shift;
+}
+
+/**
+ * Runs a sign extended reading through the gain correction, offset and user scale.
+ *
+ * @param correction const SampleCorrection_t* The correction parameters.
+ * @param code int32_t The sign extended reading.
+ * @retval int32_t The corrected reading.
+ */
+static inline int32_t SampleCorrection_Correct(const SampleCorrection_t* correction, int32_t code) {
+	/* Round the whole product rather than just the correction so ties break the same way as roundf(). Even a full
+	 * scale int32_t code times a factor just under 2.0 stays within 64 bits. */
+	int64_t value = (int64_t) code * ((((int64_t) 1) << SAMPLE_CORRECTION_GAIN_SHIFT) + correction->gain);
+	value = SampleCorrection_RoundShift(value, SAMPLE_CORRECTION_GAIN_SHIFT);
+	value = (int64_t) SampleCorrection_Saturate(value) + correction->offset;
+	value = SampleCorrection_Saturate(value);
+	if (correction->scale != SAMPLE_CORRECTION_UNITY_SCALE) {
+		value = SampleCorrection_RoundShift(value * correction->scale, SAMPLE_CORRECTION_SCALE_SHIFT);
+	}
+	return SampleCorrection_Saturate(value);
+}
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Initializes a set of correction parameters to unity gain, no offset and unity scale.
+ *
+ * @param correction SampleCorrection_t* The parameters to initialize.
+ * @retval none
+ */
+void SampleCorrection_Init(SampleCorrection_t* correction) {
+	correction->gain = SAMPLE_CORRECTION_UNITY_GAIN;
+	correction->offset = 0;
+	correction->scale = SAMPLE_CORRECTION_UNITY_SCALE;
+}
+
+/**
+ * Converts a floating point gain correction factor into its Q1.31 representation. Factors outside of [0.0, 2.0)
+ * saturate to the nearest end of the range.
+ *
+ * @param factor float The gain correction factor.
+ * @retval int32_t The Q1.31 gain correction.
+ */
+int32_t SampleCorrection_GainFromFactor(float factor) {
+	double delta = ((double) factor - 1.0) * 2147483648.0;
+	return SampleCorrection_Saturate((int64_t) round(delta));
+}
+
+/**
+ * Converts a floating point user scale into its Q16.16 representation, saturating values which do not fit.
+ *
+ * @param scale float The user scale.
+ * @retval int32_t The Q16.16 user scale.
+ */
+int32_t SampleCorrection_ScaleFromFloat(float scale) {
+	double value = (double) scale * 65536.0;
+	if (value >= 2147483647.0) {
+		return INT32_MAX;
+	} else if (value <= -2147483648.0) {
+		return INT32_MIN;
+	}
+	return (int32_t) round(value);
+}
+
+/**
+ * Sign extends a raw 24 bit two's complement ADS1256 reading to 32 bits. Any bits above the reading are ignored.
+ *
+ * @param raw uint32_t The raw reading.
+ * @retval int32_t The signed reading.
+ */
+int32_t SampleCorrection_SignExtend(uint32_t raw) {
+	return ((int32_t) ((raw & SAMPLE_CORRECTION_RAW_MASK) << 8U)) >> 8U;
+}
+
+/**
+ * Corrects a single sign extended reading.
+ *
+ * @param correction const SampleCorrection_t* The correction parameters.
+ * @param code int32_t The sign extended reading.
+ * @retval int32_t The corrected reading.
+ */
+int32_t SampleCorrection_Apply(const SampleCorrection_t* correction, int32_t code) {
+	return SampleCorrection_Correct(correction, code);
+}
+
+/**
+ * Sign extends and corrects a block of raw 24 bit readings which share the same correction parameters. The source
+ * and destination may be the same buffer.
+ *
+ * @param correction const SampleCorrection_t* The correction parameters.
+ * @param raw const uint32_t* The raw readings.
+ * @param corrected int32_t* The destination for the corrected readings.
+ * @param count uint32_t The number of readings.
+ * @retval none
+ */
+void SampleCorrection_ApplyRawBlock(const SampleCorrection_t* correction, const uint32_t* raw, int32_t* corrected,
+		uint32_t count) {
+	for (uint32_t i = 0U; i < count; ++i) {
+		corrected[i] = SampleCorrection_Correct(correction, SampleCorrection_SignExtend(raw[i]));
+	}
+}
@@ -27,6 +27,7 @@
 
 #include "Tekdaqc_Debug.h"
 #include "Tekdaqc_Timers.h"
+#include "Tekdaqc_Clock.h"
 #include "Tekdaqc_BSP.h"
 #include "ADS1256_Driver.h"
 #include <inttypes.h>
@@ -60,8 +61,6 @@
 /* PRIVATE VARIABLES */
 /*--------------------------------------------------------------------------------------------------------*/
 
-/* Keeps track of a local time reference incremented by the SYSTICK period */
-static volatile uint64_t LocalTime = 0;
 /* Used to keep track of the ending time for a delay */
 static volatile uint64_t count = 0;
 
@@ -69,6 +68,37 @@ static uint64_t MonthMicroOffsets[12] = {0U, 2678400000000U, 5097600000000U, 777
 		13046400000000U, 15638400000000U, 18316800000000U, 20995200000000U, 23587200000000U, 26265600000000U,
 		28857600000000U};
 
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE METHODS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#ifdef RTC_TIME
+/**
+ * Reads the current time from the RTC. This is slow, so it is only used to set and discipline the clock.
+ *
+ * @param none
+ * @retval uint64_t The RTC time in microseconds.
+ */
+static uint64_t GetRTCTime(void) {
+	RTC_TimeTypeDef RTC_TimeStructure;
+	RTC_DateTypeDef RTC_DateStructure;
+
+	/* Get the current Time and Date */
+	RTC_GetTime(RTC_Format_BIN, &RTC_TimeStructure);
+	RTC_GetDate(RTC_Format_BIN, &RTC_DateStructure);
+	uint32_t subseconds = RTC_GetSubSecond();
+
+	uint64_t time = EPOCH_OFFSET_MICRO + RTC_DateStructure.RTC_Year * MICROSEC_PER_YEAR
+			+ MonthMicroOffsets[RTC_DateStructure.RTC_Year] + RTC_DateStructure.RTC_Date * MICROSEC_PER_DAY
+			+ RTC_TimeStructure.RTC_Hours * MICROSEC_PER_HOUR + RTC_TimeStructure.RTC_Minutes * MICROSEC_PER_MIN
+			+ RTC_TimeStructure.RTC_Seconds * MICROSEC_PER_SEC
+			+ (1e6 * (RTC_SYNCH_PRESCALER - subseconds)) / (RTC_SYNCH_PRESCALER + 1);
+
+	//printf("Current Time: %08" PRIu64 " ms\n\r", time / 1000);
+	return time;
+}
+#endif
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* PUBLIC METHODS */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -85,6 +115,13 @@ void Timer_Config(void) {
 #endif
 	RCC_ClocksTypeDef RCC_Clocks;
 
+	/* Set the local time clock, before SYSTICK starts keeping it */
+#ifdef RTC_TIME
+	Clock_Init(GetRTCTime());
+#else
+	Clock_Init(0U);
+#endif
+
 	/* Configure Systick clock source as HCLK */
 	SysTick_CLKSourceConfig(SysTick_CLKSource_HCLK);
 
@@ -94,22 +131,20 @@ void Timer_Config(void) {
 
 	/* Set Systick interrupt priority to 0*/
 	NVIC_SetPriority(SysTick_IRQn, 0U);
-
-	LocalTime = 0U;
 }
 
 /**
- * Updates the system local time, incrementing by SYSTEMTICK_PERIOD.
+ * Keeps the local time clock current, and periodically corrects it against the RTC.
  *
  * @param  none
  * @retval none
  */
 void Time_Update(void) {
+	if (Clock_Update() == TRUE) {
 #ifdef RTC_TIME
-	LocalTime = GetLocalTime();
-#else
-	LocalTime += SYSTEMTICK_PERIOD;
+		Clock_Discipline(GetRTCTime());
 #endif
+	}
 }
 
 /**
@@ -119,26 +154,7 @@ void Time_Update(void) {
  * @retval uint64_t The current local time stamp in microseconds.
  */
 uint64_t GetLocalTime(void) {
-#ifdef RTC_TIME
-	RTC_TimeTypeDef RTC_TimeStructure;
-	RTC_DateTypeDef RTC_DateStructure;
-
-	/* Get the current Time and Date */
-	RTC_GetTime(RTC_Format_BIN, &RTC_TimeStructure);
-	RTC_GetDate(RTC_Format_BIN, &RTC_DateStructure);
-	uint32_t subseconds = RTC_GetSubSecond();
-
-	uint64_t time = EPOCH_OFFSET_MICRO + RTC_DateStructure.RTC_Year * MICROSEC_PER_YEAR
-			+ MonthMicroOffsets[RTC_DateStructure.RTC_Year] + RTC_DateStructure.RTC_Date * MICROSEC_PER_DAY
-			+ RTC_TimeStructure.RTC_Hours * MICROSEC_PER_HOUR + RTC_TimeStructure.RTC_Minutes * MICROSEC_PER_MIN
-			+ RTC_TimeStructure.RTC_Seconds * MICROSEC_PER_SEC
-			+ (1e6 * (RTC_SYNCH_PRESCALER - subseconds)) / (RTC_SYNCH_PRESCALER + 1);
-
-	//printf("Current Time: %08" PRIu64 " ms\n\r", time / 1000);
-	return time;
-#else
-	return LocalTime;
-#endif
+	return Clock_GetTime();
 }
 
 /**
@@ -185,8 +201,8 @@ void Delay_us(uint64_t us) {
 	}
 #else
 #if 0
-	count = us + LocalTime;
-	while (LocalTime < count) {
+	count = us + GetLocalTime();
+	while (GetLocalTime() < count) {
 		/* Do nothing */
 	}
 #endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_Timestamp.c
+ * @brief Hardware timestamps for ADS1256 conversions.
+ *
+ * TIMESTAMP_TIMER is a free running 32 bit counter at TIMESTAMP_TICKS_PER_US, extended to 64 bits by counting its
+ * wraps. The DRDY pin can only reach a 16 bit timer, so DRDY_CAPTURE_TIMER free runs at the same rate and latches its
+ * counter on every DRDY falling edge. The time of an edge is found by stepping back from the time base by however far
+ * the capture timer has moved on since, which only has to be read before the capture timer wraps (780 us).
+ *
+ * Time base values are turned into local time against an anchor taken by Timestamp_Synchronize(), so samples within a
+ * scan are spaced exactly by the crystal rather than by the granularity of GetLocalTime().
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_Timestamp.h"
+#include "Tekdaqc_Timers.h"
+#include "Tekdaqc_BSP.h"
+#include "boolean.h"
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE DEFINES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @internal
+ * @def TIMESTAMP_TIMER_PRESCALER
+ * @brief Prescaler for the time base, counting the 84 MHz APB1 timer clock directly.
+ */
+#define TIMESTAMP_TIMER_PRESCALER		0U
+
+/**
+ * @internal
+ * @def DRDY_CAPTURE_TIMER_PRESCALER
+ * @brief Prescaler for the DRDY capture timer, bringing the 168 MHz APB2 timer clock down to the time base rate.
+ */
+#define DRDY_CAPTURE_TIMER_PRESCALER	1U
+
+/**
+ * @internal
+ * @def TIMESTAMP_ANCHOR_STEP
+ * @brief The number of ticks the anchor is moved forward by at a time, a whole number of microseconds which keeps the
+ * conversion within 32 bit arithmetic.
+ */
+#define TIMESTAMP_ANCHOR_STEP			((uint64_t) TIMESTAMP_TICKS_PER_US * 10000000U)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The number of times the time base has wrapped */
+static volatile uint32_t timestampHigh = 0U;
+
+/* The time base value at the anchor */
+static uint64_t anchorTicks = 0U;
+
+/* The local time at the anchor, in microseconds */
+static uint64_t anchorTime = 0U;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Starts the time base and the DRDY input capture. The DRDY pin itself is routed to the capture timer when the ADS1256
+ * state pins are initialized. This must come after Watchdog_Init(), which borrows TIMESTAMP_TIMER to measure the LSI.
+ *
+ * @param none
+ * @retval none
+ */
+void Timestamp_Init(void) {
+#ifdef DEBUG
+	printf("[Timestamp] Initializing the sample time base.\n\r");
+#endif
+	NVIC_InitTypeDef NVIC_InitStructure;
+	TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+	TIM_ICInitTypeDef TIM_ICInitStructure;
+
+	RCC_APB1PeriphClockCmd(TIMESTAMP_TIMER_CLK, ENABLE);
+	RCC_APB2PeriphClockCmd(DRDY_CAPTURE_TIMER_CLK, ENABLE);
+	TIM_DeInit(TIMESTAMP_TIMER);
+	TIM_DeInit(DRDY_CAPTURE_TIMER);
+
+	TIM_TimeBaseStructure.TIM_Prescaler = TIMESTAMP_TIMER_PRESCALER;
+	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+	TIM_TimeBaseStructure.TIM_Period = 0xFFFFFFFFU;
+	TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+	TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+	TIM_TimeBaseInit(TIMESTAMP_TIMER, &TIM_TimeBaseStructure);
+	/* TIM_TimeBaseInit() generates an update event to load the prescaler, don't count it as a wrap */
+	TIM_ClearITPendingBit(TIMESTAMP_TIMER, TIM_IT_Update);
+	TIM_ITConfig(TIMESTAMP_TIMER, TIM_IT_Update, ENABLE);
+
+	TIM_TimeBaseStructure.TIM_Prescaler = DRDY_CAPTURE_TIMER_PRESCALER;
+	TIM_TimeBaseStructure.TIM_Period = 0xFFFFU;
+	TIM_TimeBaseInit(DRDY_CAPTURE_TIMER, &TIM_TimeBaseStructure);
+	TIM_ICInitStructure.TIM_Channel = DRDY_CAPTURE_CHANNEL;
+	TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Falling;
+	TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+	TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+	TIM_ICInitStructure.TIM_ICFilter = 0;
+	TIM_ICInit(DRDY_CAPTURE_TIMER, &TIM_ICInitStructure);
+
+	NVIC_InitStructure.NVIC_IRQChannel = TIMESTAMP_TIMER_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	timestampHigh = 0U;
+	TIM_Cmd(DRDY_CAPTURE_TIMER, ENABLE);
+	TIM_Cmd(TIMESTAMP_TIMER, ENABLE);
+	Timestamp_Synchronize();
+}
+
+/**
+ * Called by the time base timer interrupt handler when the counter wraps, about every 51 seconds.
+ *
+ * @param none
+ * @retval none
+ */
+void Timestamp_Overflow(void) {
+	++timestampHigh;
+}
+
+/**
+ * Retrieves the current value of the 64 bit time base. Safe to call from any context, including interrupts which hold
+ * off the wrap interrupt.
+ *
+ * @param none
+ * @retval uint64_t The time base value in ticks.
+ */
+uint64_t Timestamp_GetTicks(void) {
+	uint32_t high;
+	uint32_t low;
+	bool pending;
+	do {
+		high = timestampHigh;
+		low = TIMESTAMP_TIMER->CNT;
+		pending = ((TIMESTAMP_TIMER->SR & TIM_SR_UIF) != 0U);
+	} while (high != timestampHigh);
+	/* A wrap which the interrupt has not counted yet only applies if the counter was read after it */
+	if (pending && (low < 0x80000000U)) {
+		++high;
+	}
+	return (((uint64_t) high) << 32U) | low;
+}
+
+/**
+ * Retrieves the time base value at the last DRDY falling edge. This must be called within 780 us of the edge, before
+ * the capture timer wraps, which the conversion read always is.
+ *
+ * @param none
+ * @retval uint64_t The time base value in ticks.
+ */
+uint64_t Timestamp_GetDataReadyTicks(void) {
+	uint64_t now = Timestamp_GetTicks();
+	uint16_t since = (uint16_t) (DRDY_CAPTURE_TIMER->CNT - DRDY_CAPTURE_TIMER->CCR3);
+	return now - since;
+}
+
+/**
+ * Aligns the time base with the local time. Called before sampling starts so that any change to the local time, such
+ * as from the RTC being set, is picked up.
+ *
+ * @param none
+ * @retval none
+ */
+void Timestamp_Synchronize(void) {
+	anchorTime = GetLocalTime();
+	anchorTicks = Timestamp_GetTicks();
+}
+
+/**
+ * Converts a time base value into local time. Values before the anchor are reported as the anchor time.
+ *
+ * @param ticks uint64_t The time base value.
+ * @retval uint64_t The local time in microseconds.
+ */
+uint64_t Timestamp_ToLocalTime(uint64_t ticks) {
+	uint64_t delta;
+	if (ticks < anchorTicks) {
+		return anchorTime;
+	}
+	delta = ticks - anchorTicks;
+	/* Walk the anchor forward in whole microseconds so the division below stays 32 bit */
+	while (delta >= TIMESTAMP_ANCHOR_STEP) {
+		anchorTicks += TIMESTAMP_ANCHOR_STEP;
+		anchorTime += TIMESTAMP_ANCHOR_STEP / TIMESTAMP_TICKS_PER_US;
+		delta -= TIMESTAMP_ANCHOR_STEP;
+	}
+	return anchorTime + ((uint32_t) delta / TIMESTAMP_TICKS_PER_US);
+}
+
+/**
+ * Retrieves the local time of the last DRDY falling edge.
+ *
+ * @param none
+ * @retval uint64_t The local time in microseconds.
+ */
+uint64_t Timestamp_GetDataReadyTime(void) {
+	return Timestamp_ToLocalTime(Timestamp_GetDataReadyTicks());
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_TxQueue.c
+ * @brief TCP transmit queue.
+ *
+ * Data is written directly into fixed size blocks, either copied in or formatted in place. Blocks are handed to
+ * tcp_write() without the copy flag, so lwIP builds its segments from references to the blocks and the data is only
+ * copied once, by the Ethernet driver. lwIP may retransmit from a block at any time until it is acknowledged, so the
+ * bytes already handed over are never modified and a block is only reused after TxQueue_Acknowledge() has accounted
+ * for all of it. The amount of data in flight is therefore bounded by TCP_SND_BUF rather than by any copy.
+ *
+ * The queue is not locked. It must only be used from the main loop, which is also where lwIP runs.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_TxQueue.h"
+#include "Tekdaqc_Config.h"
+#include <string.h>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Initializes a transmit queue over the provided blocks. The queue starts empty with cleared counters.
+ *
+ * @param queue TxQueue_t* Pointer to the queue to initialize.
+ * @param blocks TxQueue_Block_t* Pointer to the storage for the blocks.
+ * @param count uint32_t The number of blocks. Must be a power of two of at least two.
+ * @retval none
+ */
+void TxQueue_Init(TxQueue_t* queue, TxQueue_Block_t* blocks, uint32_t count) {
+	assert_param(IS_TX_QUEUE_CAPACITY(count));
+	queue->blocks = blocks;
+	queue->mask = count - 1U;
+	TxQueue_Reset(queue);
+}
+
+/**
+ * Discards all data and clears the counters of a transmit queue. Must not be called while lwIP still holds
+ * references to the blocks of a connection which is expected to deliver them.
+ *
+ * @param queue TxQueue_t* Pointer to the queue to reset.
+ * @retval none
+ */
+void TxQueue_Reset(TxQueue_t* queue) {
+	queue->head = 0U;
+	queue->send = 0U;
+	queue->fill = 0U;
+	queue->sendOffset = 0U;
+	queue->acked = 0U;
+	queue->drops = 0U;
+	queue->highWater = 0U;
+	queue->blocks[0].length = 0U;
+}
+
+/**
+ * Retrieves contiguous space to write into the transmit queue. If the block being written has less than the minimum
+ * space left, it is closed and the next free block is used instead. Nothing is added to the queue until
+ * TxQueue_Commit() is called.
+ *
+ * @param queue TxQueue_t* Pointer to the queue to write to.
+ * @param minimum uint32_t The smallest usable space, at most TX_QUEUE_BLOCK_SIZE.
+ * @param space uint32_t* Set to the number of bytes which may be written.
+ * @retval uint8_t* Pointer to the space, or NULL if every block is in use.
+ */
+uint8_t* TxQueue_Reserve(TxQueue_t* queue, uint32_t minimum, uint32_t* space) {
+	assert_param(minimum <= TX_QUEUE_BLOCK_SIZE);
+	TxQueue_Block_t* block = &queue->blocks[queue->fill & queue->mask];
+	if ((TX_QUEUE_BLOCK_SIZE - block->length) < minimum) {
+		uint32_t used = queue->fill - queue->head + 1U;
+		if (used > queue->mask) {
+			*space = 0U;
+			return NULL;
+		}
+		++queue->fill;
+		if (used + 1U > queue->highWater) {
+			queue->highWater = used + 1U;
+		}
+		block = &queue->blocks[queue->fill & queue->mask];
+		block->length = 0U;
+	}
+	*space = TX_QUEUE_BLOCK_SIZE - block->length;
+	return &block->data[block->length];
+}
+
+/**
+ * Adds bytes written into space from TxQueue_Reserve() to the transmit queue.
+ *
+ * @param queue TxQueue_t* Pointer to the queue written to.
+ * @param length uint32_t The number of bytes written, at most the reserved space.
+ * @retval none
+ */
+void TxQueue_Commit(TxQueue_t* queue, uint32_t length) {
+	queue->blocks[queue->fill & queue->mask].length += length;
+}
+
+/**
+ * Copies data into the transmit queue, filling blocks in turn. Whatever does not fit because every block is in use
+ * is discarded and counted as dropped.
+ *
+ * @param queue TxQueue_t* Pointer to the queue to write to.
+ * @param data const uint8_t* Pointer to the data to copy in.
+ * @param length uint32_t The number of bytes to copy.
+ * @retval uint32_t The number of bytes copied.
+ */
+uint32_t TxQueue_Write(TxQueue_t* queue, const uint8_t* data, uint32_t length) {
+	uint32_t written = 0U;
+	while (written < length) {
+		uint32_t space;
+		uint8_t* dest = TxQueue_Reserve(queue, 1U, &space);
+		if (dest == NULL) {
+			queue->drops += length - written;
+			break;
+		}
+		if (space > (length - written)) {
+			space = length - written;
+		}
+		memcpy(dest, &data[written], space);
+		TxQueue_Commit(queue, space);
+		written += space;
+	}
+	return written;
+}
+
+/**
+ * Hands queued data to lwIP by reference, as far as the send buffer of the connection allows. Closed blocks are
+ * always handed over. The block being written is only handed over if partial is set; it may still be written to
+ * afterwards, since only the bytes beyond those handed over change. The caller is responsible for calling
+ * tcp_output().
+ *
+ * @param queue TxQueue_t* Pointer to the queue to transmit from.
+ * @param pcb tcp_pcb* The connection to transmit on.
+ * @param partial bool If the block being written should be handed over as well.
+ * @retval uint32_t The number of bytes handed to lwIP.
+ */
+uint32_t TxQueue_Flush(TxQueue_t* queue, struct tcp_pcb* pcb, bool partial) {
+	uint32_t total = 0U;
+	for (;;) {
+		TxQueue_Block_t* block = &queue->blocks[queue->send & queue->mask];
+		uint32_t unsent = block->length - queue->sendOffset;
+		if (queue->send != queue->fill) {
+			if (unsent == 0U) {
+				++queue->send;
+				queue->sendOffset = 0U;
+				continue;
+			}
+		} else if ((partial == FALSE) || (unsent == 0U)) {
+			break;
+		}
+		uint32_t available = tcp_sndbuf(pcb);
+		if (unsent > available) {
+			unsent = available;
+		}
+		if ((unsent == 0U) || (tcp_write(pcb, &block->data[queue->sendOffset], (u16_t) unsent, 0) != ERR_OK)) {
+			break;
+		}
+		queue->sendOffset += unsent;
+		total += unsent;
+	}
+	return total;
+}
+
+/**
+ * Accounts for data acknowledged by the remote host, releasing every block which has been acknowledged in full.
+ * Called from the sent callback of the connection.
+ *
+ * @param queue TxQueue_t* Pointer to the queue which was transmitted from.
+ * @param length uint32_t The number of bytes acknowledged.
+ * @retval none
+ */
+void TxQueue_Acknowledge(TxQueue_t* queue, uint32_t length) {
+	queue->acked += length;
+	for (;;) {
+		TxQueue_Block_t* block = &queue->blocks[queue->head & queue->mask];
+		if (queue->acked < block->length) {
+			break;
+		}
+		if (queue->head == queue->fill) {
+			/* Everything written has been acknowledged, so the block is written from the start again */
+			block->length = 0U;
+			queue->sendOffset = 0U;
+			queue->acked = 0U;
+			break;
+		}
+		queue->acked -= block->length;
+		++queue->head;
+	}
+}
+
+/**
+ * Retrieves the number of blocks which hold data that has not been acknowledged.
+ *
+ * @param queue const TxQueue_t* Pointer to the queue.
+ * @retval uint32_t The number of blocks in use.
+ */
+uint32_t TxQueue_Count(const TxQueue_t* queue) {
+	return (queue->fill - queue->head) + ((queue->blocks[queue->fill & queue->mask].length != 0U) ? 1U : 0U);
+}
+
+/**
+ * Retrieves the number of bytes which can be written without waiting for an acknowledgement. This is the space left
+ * in the block being written plus every free block.
+ *
+ * @param queue const TxQueue_t* Pointer to the queue.
+ * @retval uint32_t The number of bytes which can be written.
+ */
+uint32_t TxQueue_Available(const TxQueue_t* queue) {
+	uint32_t free = queue->mask - (queue->fill - queue->head);
+	return (free * TX_QUEUE_BLOCK_SIZE) + (TX_QUEUE_BLOCK_SIZE - queue->blocks[queue->fill & queue->mask].length);
+}
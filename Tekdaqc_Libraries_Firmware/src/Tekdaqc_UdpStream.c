@@ -0,0 +1,224 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Tekdaqc_UdpStream.c
+ * @brief Streams binary frames over UDP.
+ *
+ * Frames are copied into a single datagram buffer, which is sent once the next frame would not fit or its oldest
+ * frame has waited UDP_STREAM_FLUSH_INTERVAL. The buffer is handed to lwIP by reference. The Ethernet driver copies
+ * it before udp_sendto() returns, and lwIP copies it if the packet has to wait for address resolution, so the buffer
+ * can be written again straight away.
+ *
+ * Sending to a multicast group needs no IGMP support, only receiving does. There is no flow control: a datagram
+ * lwIP can not send is counted and lost, and receivers see the gap in the sequence numbers.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* INCLUDES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+#include "Tekdaqc_Debug.h"
+#include "Tekdaqc_UdpStream.h"
+#include "Tekdaqc_BSP.h"
+#include "Tekdaqc_Timers.h"
+#include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include <string.h>
+
+#ifdef PRINTF_OUTPUT
+#include <stdio.h>
+#include <inttypes.h>
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* PRIVATE VARIABLES */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/* The UDP port the stream is sent from */
+static struct udp_pcb* stream_pcb = NULL;
+
+/* The stream configuration */
+static UdpStream_Config_t config;
+
+/* The stream counters */
+static UdpStream_Statistics_t statistics;
+
+/* The datagram being built. Handed to lwIP by reference, so it is kept out of CCM like the TCP transmit blocks */
+static uint8_t datagram[UDP_STREAM_DATAGRAM_SIZE];
+
+/* The number of bytes in the datagram being built, including the header */
+static uint32_t length = UDP_STREAM_HEADER_SIZE;
+
+/* The number of frames in the datagram being built */
+static uint16_t frames = 0U;
+
+/* The time the first frame was added to the datagram being built */
+static uint64_t firstFrameTime = 0U;
+
+/*--------------------------------------------------------------------------------------------------------*/
+/* EXPORTED FUNCTIONS */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * Creates the UDP port the stream is sent from. The stream starts disabled, sending to DATA_PORT once an address is
+ * configured.
+ *
+ * @param none
+ * @retval none
+ */
+void UdpStream_Init(void) {
+	stream_pcb = udp_new();
+	config.enabled = FALSE;
+	ip_addr_set_any(&config.address);
+	config.port = DATA_PORT;
+	memset(&statistics, 0, sizeof(statistics));
+#ifdef UDP_STREAM_DEBUG
+	if (stream_pcb == NULL) {
+		printf("[UDP Stream] Can not create new UDP port.\n\r");
+	}
+#endif
+}
+
+/**
+ * Sets the UDP stream configuration. Any frames waiting for the previous destination are sent first. Enabling the
+ * stream restarts the sequence numbers and clears the counters.
+ *
+ * @param cfg const UdpStream_Config_t* The new configuration.
+ * @retval bool TRUE if the configuration was applied, FALSE if the stream is enabled without an address or port, or
+ * there is no UDP port to send from.
+ */
+bool UdpStream_Configure(const UdpStream_Config_t* cfg) {
+	if ((cfg->enabled == TRUE)
+			&& ((stream_pcb == NULL) || ip_addr_isany(&cfg->address) || (cfg->port == 0U))) {
+#ifdef UDP_STREAM_DEBUG
+		printf("[UDP Stream] Invalid configuration.\n\r");
+#endif
+		return FALSE;
+	}
+	UdpStream_Flush();
+	if ((cfg->enabled == TRUE) && (config.enabled == FALSE)) {
+		memset(&statistics, 0, sizeof(statistics));
+	}
+	config = *cfg;
+	return TRUE;
+}
+
+/**
+ * Retrieves the UDP stream configuration.
+ *
+ * @param cfg UdpStream_Config_t* The structure to fill.
+ * @retval none
+ */
+void UdpStream_GetConfig(UdpStream_Config_t* cfg) {
+	*cfg = config;
+}
+
+/**
+ * Retrieves the UDP stream counters.
+ *
+ * @param stats UdpStream_Statistics_t* The structure to fill.
+ * @retval none
+ */
+void UdpStream_GetStatistics(UdpStream_Statistics_t* stats) {
+	*stats = statistics;
+}
+
+/**
+ * Indicates if sampled data is streamed over UDP.
+ *
+ * @param none
+ * @retval bool TRUE if the stream is enabled.
+ */
+bool UdpStream_IsEnabled(void) {
+	return config.enabled;
+}
+
+/**
+ * Adds a frame to the datagram being built, sending the datagram first if the frame would not fit. A frame too
+ * large for any datagram is discarded.
+ *
+ * @param frame const uint8_t* Pointer to the frame.
+ * @param size uint32_t The number of bytes in the frame.
+ * @retval none
+ */
+void UdpStream_Write(const uint8_t* frame, uint32_t size) {
+	if ((config.enabled == FALSE) || (size > (UDP_STREAM_DATAGRAM_SIZE - UDP_STREAM_HEADER_SIZE))) {
+		return;
+	}
+	if ((length + size) > UDP_STREAM_DATAGRAM_SIZE) {
+		UdpStream_Flush();
+	}
+	if (frames == 0U) {
+		firstFrameTime = GetLocalTime();
+	}
+	memcpy(&datagram[length], frame, size);
+	length += size;
+	++frames;
+}
+
+/**
+ * Sends the datagram being built, if it holds any frames. The datagram takes the next sequence number whether or
+ * not lwIP manages to send it.
+ *
+ * @param none
+ * @retval none
+ */
+void UdpStream_Flush(void) {
+	struct pbuf* p;
+	if (frames == 0U) {
+		return;
+	}
+	datagram[0] = (uint8_t) statistics.sequence;
+	datagram[1] = (uint8_t) (statistics.sequence >> 8);
+	datagram[2] = (uint8_t) (statistics.sequence >> 16);
+	datagram[3] = (uint8_t) (statistics.sequence >> 24);
+	datagram[4] = (uint8_t) frames;
+	datagram[5] = (uint8_t) (frames >> 8);
+	p = pbuf_alloc(PBUF_TRANSPORT, (u16_t) length, PBUF_REF);
+	if (p != NULL) {
+		p->payload = datagram;
+		if (udp_sendto(stream_pcb, p, &config.address, config.port) == ERR_OK) {
+			statistics.frames += frames;
+		} else {
+			++statistics.drops;
+		}
+		pbuf_free(p);
+	} else {
+		++statistics.drops;
+	}
+#ifdef UDP_STREAM_DEBUG
+	if (p == NULL) {
+		printf("[UDP Stream] Could not allocate a pbuf for datagram %" PRIu32 ".\n\r", statistics.sequence);
+	}
+#endif
+	++statistics.sequence;
+	length = UDP_STREAM_HEADER_SIZE;
+	frames = 0U;
+}
+
+/**
+ * Called from the main loop to send the datagram being built once its oldest frame has waited
+ * UDP_STREAM_FLUSH_INTERVAL, so a slow stream does not sit in a part filled datagram.
+ *
+ * @param none
+ * @retval none
+ */
+void UdpStream_Service(void) {
+	if ((frames != 0U) && ((GetLocalTime() - firstFrameTime) >= UDP_STREAM_FLUSH_INTERVAL)) {
+		UdpStream_Flush();
+	}
+}
@@ -34,18 +34,31 @@
 #include "TelnetServer.h"
 #include "Tekdaqc_Config.h"
 #include "Tekdaqc_Timers.h"
+#include "Tekdaqc_Memory.h"
 #include "stm32f4xx.h"
 #include "lwip/debug.h"
 #include "lwip/stats.h"
 #include "lwip/tcp.h"
 #include "netconf.h"
+#include "stm32f4x7_eth.h"
 #include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
 #include <inttypes.h>
 
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE DEFINES */
 /*--------------------------------------------------------------------------------------------------------*/
 
+/**
+ * @internal
+ * @def TELNET_WRITE_TIMEOUT
+ * @brief The longest time a write waits for the client to acknowledge enough data to make room, in microseconds.
+ * A write which does not fit in time is dropped whole, and later writes are dropped without waiting until the client
+ * catches up.
+ */
+#define TELNET_WRITE_TIMEOUT	100000U
+
 /*--------------------------------------------------------------------------------------------------------*/
 /* PRIVATE VARIABLES */
 /*--------------------------------------------------------------------------------------------------------*/
@@ -60,7 +73,14 @@ static struct tcp_pcb *telnet_pcb;
  * @internal
  * @brief Pointer to the current Telnet server.
  */
-static TelnetServer_t telnet_server;
+static TelnetServer_t telnet_server CCM_BSS;
+
+/**
+ * @internal
+ * @brief The blocks of the transmit queue. lwIP holds references to them until they are acknowledged, so they are
+ * kept out of CCM where the Ethernet DMA could not reach them should the driver ever stop copying frames.
+ */
+static TxQueue_Block_t transmitBlocks[TELNET_TX_NUM_BLOCKS];
 
 /**
  * @internal
@@ -70,9 +90,10 @@ static bool IsConnected = false;
 
 /**
  * @internal
- * @brief Buffer for printing the TOSTRING_BUFFER with additional formatting.
+ * @brief Set while a closed connection is still delivering the replies queued before it was closed. lwIP holds
+ * references to the transmit blocks until then, so no new client is accepted.
  */
-static char MESSAGE_BUFFER[SIZE_TOSTRING_BUFFER];
+static bool IsClosing = false;
 
 /**
  * @internal
@@ -123,9 +144,35 @@ static err_t TelnetSent(void *arg, struct tcp_pcb *pcb, u16_t len);
 static void TelnetError(void *arg, err_t err);
 
 /**
- * @brief Clears the internal message string buffer.
+ * @brief Called when the client acknowledges data sent before the connection was closed.
+ */
+static err_t TelnetClosingSent(void *arg, struct tcp_pcb *pcb, u16_t len);
+
+/**
+ * @brief Called when lwIP gives up on a connection which was being closed.
  */
-static void ClearToMessageBuffer(void);
+static void TelnetClosingError(void *arg, err_t err);
+
+/**
+ * @brief Hands the queued data to lwIP.
+ */
+static void TelnetFlush(bool partial);
+
+/**
+ * @brief Retrieves space in the transmit queue, waiting for blocks to be acknowledged if necessary.
+ */
+static uint8_t* ReserveTransmit(uint32_t minimum, uint32_t* space);
+
+/**
+ * @internal
+ * @brief Makes room to write to the transmit queue, waiting only while the connection is not congested.
+ */
+static bool WaitTransmit(uint32_t length);
+
+/**
+ * @brief Writes a telnet option response into the transmit queue.
+ */
+static void TelnetWriteOption(char command, char option);
 
 /**
  * @brief Creates an initalizes a Telnet server.
@@ -155,8 +202,8 @@ static err_t TelnetAccept(void *arg, struct tcp_pcb *pcb, err_t err) {
 	LWIP_UNUSED_ARG(arg);
 	LWIP_UNUSED_ARG(err);
 
-	/* Check if already connected. */
-	if (TelnetIsConnected() == true) {
+	/* Check if already connected, or still delivering the last replies to the previous client. */
+	if ((TelnetIsConnected() == true) || (IsClosing == true)) {
 		/* There is already a connected client, so refuse this connection with
 		 a message indicating this fact. */
 #ifdef TELNET_DEBUG
@@ -207,18 +254,16 @@ static err_t TelnetAccept(void *arg, struct tcp_pcb *pcb, err_t err) {
 
 	/* Setup the TCP sent callback function. */
 	tcp_sent(pcb, TelnetSent);
-	/* Initialize the count of outstanding bytes.  The initial byte acked as
-	 part of the SYN -> SYN/ACK sequence is included so that the byte count
-	 works out correctly at the end. */
-	telnet_server.outstanding = sizeof(TelnetInit) + 1;
+	/* Initialize the count of outstanding bytes. lwIP does not report the SYN in the sent callback. */
+	telnet_server.outstanding = 0;
 	/* Do not close the telnet connection until requested. */
 	telnet_server.close = 0;
 #ifdef TELNET_DEBUG
 	printf("[Telnet Server] Writing the init messages\n\r");
 #endif
 	/* Send the telnet initialization string. */
-	tcp_write(pcb, TelnetInit, sizeof(TelnetInit), 1);
-	tcp_output(pcb);
+	TxQueue_Write(&telnet_server.transmit, (const uint8_t*) TelnetInit, sizeof(TelnetInit));
+	TelnetFlush(TRUE);
 
 	TelnetWriteDebugMessage("[TELNET] Telnet Server Connected. Welcome.");
 
@@ -243,10 +288,7 @@ static err_t TelnetReceive(void *arg, struct tcp_pcb *pcb, struct pbuf *p,
 	struct pbuf *q;
 	unsigned long ulIdx;
 	unsigned char *pucData;
-	TelnetServer_t* server;
 	if (arg != NULL) {
-		server = (TelnetServer_t*) arg;
-
 		/* Process the incoming packet. */
 		if ((err == ERR_OK) && (p != NULL)) {
 #ifdef TELNET_DEBUG
@@ -267,8 +309,7 @@ static err_t TelnetReceive(void *arg, struct tcp_pcb *pcb, struct pbuf *p,
 			pbuf_free(p);
 		} else if ((err == ERR_OK) && (p == NULL)) {
 			/* If a null packet is passed in, close the connection. */
-			server->length = 0;
-			TelnetClose();
+			return TelnetClose();
 		}
 	} else {
 #ifdef TELNET_DEBUG
@@ -299,6 +340,13 @@ static err_t TelnetSent(void *arg, struct tcp_pcb *pcb, u16_t len) {
 #endif
 		/* Decrement the count of outstanding bytes. */
 		server->outstanding -= len;
+		/* Release the acknowledged blocks and send whatever was waiting for room in the send buffer. */
+		TxQueue_Acknowledge(&server->transmit, len);
+		TelnetFlush(TRUE);
+		if (TxQueue_Count(&server->transmit) <= 1U) {
+			/* The client has caught up, so writes may wait for it again */
+			server->congested = FALSE;
+		}
 	} else {
 		/* See if this is the ACK for the error message. */
 		if (len == sizeof(ErrorMessage)) {
@@ -329,12 +377,55 @@ static void TelnetError(void *arg, err_t err) {
 	TelnetServer_t* server;
 	server = (TelnetServer_t*) arg;
 	if (server != NULL) {
-		/* free es structure */
-		mem_free(server);
+		/* lwIP has already freed the pcb, along with every reference to the transmit blocks. */
+		server->pcb = NULL;
+		TxQueue_Reset(&server->transmit);
 	}
 	IsConnected = false;
 }
 
+/**
+ * @internal
+ * This function is called when the client acknowledges data sent before the connection was closed. Once everything
+ * handed to lwIP has been acknowledged, lwIP no longer references the transmit blocks and a new client may use them.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param pcb tcp_pcb* struct The PCB structure this callback is for.
+ * @param len u16_t The number of bytes which were acknowledged, including the FIN.
+ * @retval err lwIP err_t with the result of the this function.
+ */
+static err_t TelnetClosingSent(void *arg, struct tcp_pcb *pcb, u16_t len) {
+	LWIP_UNUSED_ARG(arg);
+	if (len >= telnet_server.outstanding) {
+		telnet_server.outstanding = 0;
+		TxQueue_Reset(&telnet_server.transmit);
+		IsClosing = false;
+		tcp_sent(pcb, NULL);
+		tcp_err(pcb, NULL);
+	} else {
+		telnet_server.outstanding -= len;
+	}
+	return (ERR_OK);
+}
+
+/**
+ * @internal
+ * This function is called when lwIP gives up on a connection which was being closed, either because the client
+ * stopped responding or because the close was aborted. lwIP has already freed the pcb, along with every reference to
+ * the transmit blocks.
+ *
+ * @param arg void* Argument pointer passed to the handler by the lwIP stack.
+ * @param err lwIP err_t with the error.
+ * @retval none
+ */
+static void TelnetClosingError(void *arg, err_t err) {
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(err);
+	telnet_server.outstanding = 0;
+	TxQueue_Reset(&telnet_server.transmit);
+	IsClosing = false;
+}
+
 /**
  * @internal
  * Creates and initializes a Telnet server.
@@ -352,7 +443,9 @@ static TelnetServer_t* CreateTelnetServer(void) {
 	telnet_server.recvWrite = 0;
 	telnet_server.recvRead = 0;
 	telnet_server.previous = 0;
-	telnet_server.length = 0;
+	TxQueue_Reset(&telnet_server.transmit);
+	telnet_server.format = TELNET_FORMAT_ASCII;
+	telnet_server.congested = FALSE;
 	for (int i = 0; i < TELNET_BUFFER_LENGTH; ++i) {
 		telnet_server.recvBuffer[i] = 0;
 	}
@@ -361,15 +454,72 @@ static TelnetServer_t* CreateTelnetServer(void) {
 
 /**
  * @internal
- * Clears the internal message string buffer.
+ * Hands the queued data to lwIP and starts its transmission.
  *
- * @param none
+ * @param partial bool If the block being written should be sent as well as the full ones.
  * @retval none
  */
-static void ClearToMessageBuffer(void) {
-	for (uint_fast8_t i = 0; i < SIZE_TOSTRING_BUFFER; ++i) {
-		MESSAGE_BUFFER[i] = '\0';
+static void TelnetFlush(bool partial) {
+	if (telnet_server.pcb != NULL) {
+		uint32_t length = TxQueue_Flush(&telnet_server.transmit, telnet_server.pcb, partial);
+		if (length != 0U) {
+			/* Increment the count of outstanding bytes. */
+			telnet_server.outstanding += length;
+			tcp_output(telnet_server.pcb);
+		}
+	}
+}
+
+/**
+ * @internal
+ * Makes room to write the specified number of bytes to the transmit queue. While the connection is not congested this
+ * waits up to TELNET_WRITE_TIMEOUT for the client, and a timeout marks the connection congested. While it is congested
+ * only the room available now is used, so a stalled client can not hold up the main loop on every write.
+ *
+ * @param length uint32_t The number of bytes to make room for.
+ * @retval bool TRUE if there is room, FALSE if the write should be dropped.
+ */
+static bool WaitTransmit(uint32_t length) {
+	if (telnet_server.congested == TRUE) {
+		return (TxQueue_Available(&telnet_server.transmit) >= length) ? TRUE : FALSE;
+	}
+	if (TelnetWaitWriteSpace(length, TELNET_WRITE_TIMEOUT) == FALSE) {
+		telnet_server.congested = TRUE;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/**
+ * @internal
+ * Retrieves space in the transmit queue. If the block being written has too little room left and no other block is
+ * free, waits for a block to be acknowledged as WaitTransmit() does.
+ *
+ * @param minimum uint32_t The smallest usable space.
+ * @param space uint32_t* Set to the number of bytes which may be written.
+ * @retval uint8_t* Pointer to the space, or NULL if none became free in time.
+ */
+static uint8_t* ReserveTransmit(uint32_t minimum, uint32_t* space) {
+	uint8_t* dest = TxQueue_Reserve(&telnet_server.transmit, minimum, space);
+	/* Every block is in use, so one byte more than is available now means a whole block has been freed */
+	if ((dest == NULL) && (WaitTransmit(TxQueue_Available(&telnet_server.transmit) + 1U) == TRUE)) {
+		dest = TxQueue_Reserve(&telnet_server.transmit, minimum, space);
 	}
+	return dest;
+}
+
+/**
+ * @internal
+ * Writes a telnet option response into the transmit queue. Called while a received packet is processed, so it does
+ * not wait for space.
+ *
+ * @param command char The response command.
+ * @param option char The option the response is for.
+ * @retval none
+ */
+static void TelnetWriteOption(char command, char option) {
+	const char response[3] = { TELNET_IAC, command, option };
+	TxQueue_Write(&telnet_server.transmit, (const uint8_t*) response, sizeof(response));
 }
 
 /**
@@ -379,11 +529,8 @@ static void ClearToMessageBuffer(void) {
  * @retval none
  */
 TelnetStatus_t InitializeTelnetServer(void) {
-	telnet_server.length = 0;
 	telnet_server.outstanding = 0;
-	for (uint_fast16_t i = 0; i < sizeof(telnet_server.buffer); ++i) {
-		telnet_server.buffer[i] = 0;
-	}
+	TxQueue_Init(&telnet_server.transmit, transmitBlocks, TELNET_TX_NUM_BLOCKS);
 	/* Create a new tcp pcb */
 #ifdef TELNET_DEBUG
 	printf("[Telnet Server] Creating TCP port for Telnet server.\n\r");
@@ -424,31 +571,54 @@ TelnetStatus_t InitializeTelnetServer(void) {
 }
 
 /**
- * This function is called when the the TCP connection should be closed.
+ * This function is called when the the TCP connection should be closed. Everything queued is handed to lwIP first and
+ * the connection is closed gracefully, so the client receives every reply written before the close. lwIP keeps
+ * references to the transmit blocks until the client acknowledges them, so until then no new client is accepted and
+ * the transmit queue is left alone. Only if lwIP has no memory to close the connection is it aborted.
+ *
+ * The listening pcb is never closed, so there is no need to initialize the server again.
  *
  * @param none
- * @retval none
+ * @retval err_t ERR_ABRT if the connection had to be aborted, which an lwIP callback of the connection must return,
+ * ERR_OK otherwise.
  */
-void TelnetClose(void) {
+err_t TelnetClose(void) {
 	printf("Closing telnet connection.\n\r");
 	struct tcp_pcb *pcb = telnet_server.pcb;
+	err_t ret_err = ERR_OK;
 
-	/* Remove all callbacks */
-	tcp_arg(pcb, NULL);
-	tcp_sent(pcb, NULL);
-	tcp_recv(pcb, NULL);
-	tcp_err(pcb, NULL);
-	tcp_poll(pcb, NULL, 0);
+	if (pcb != NULL) {
+		/* Hand over whatever is still queued. */
+		TelnetFlush(TRUE);
 
-	/* Clear the telnet data structure pointer, to indicate that there is no longer a connection. */
-	telnet_server.pcb = 0;
+		/* Remove the callbacks of the open connection */
+		tcp_arg(pcb, NULL);
+		tcp_recv(pcb, NULL);
+		tcp_poll(pcb, NULL, 0);
 
-	/* Close tcp connection */
-	tcp_close(pcb);
-	IsConnected = FALSE;
+		/* Clear the telnet data structure pointer, to indicate that there is no longer a connection. */
+		telnet_server.pcb = 0;
+
+		if (telnet_server.outstanding != 0) {
+			/* Keep the transmit blocks until the client has acknowledged them */
+			IsClosing = true;
+			tcp_sent(pcb, TelnetClosingSent);
+			tcp_err(pcb, TelnetClosingError);
+		} else {
+			tcp_sent(pcb, NULL);
+			tcp_err(pcb, NULL);
+			TxQueue_Reset(&telnet_server.transmit);
+		}
 
-	/* Re-initialize the Telnet Server */
-	InitializeTelnetServer();
+		/* Close the tcp connection, or abort it if there is no memory for the FIN; the abort frees the pcb along
+		 with every reference to the transmit blocks and reports it to TelnetClosingError() */
+		if (tcp_close(pcb) != ERR_OK) {
+			tcp_abort(pcb);
+			ret_err = ERR_ABRT;
+		}
+	}
+	IsConnected = FALSE;
+	return ret_err;
 }
 
 /**
@@ -477,20 +647,8 @@ err_t TelnetPoll(void *arg, struct tcp_pcb *tpcb) {
 	server = (TelnetServer_t*) arg;
 
 	if (server != NULL) {
-		unsigned long length = server->length;
-		if ((server->pcb != NULL) && (length != 0)) {
-			/* Write the data from the transmit buffer. */
-			tcp_write(server->pcb, server->buffer, length, 1);
-
-			/* Increment the count of outstanding bytes. */
-			server->outstanding += length;
-
-			/* Output the telnet data. */
-			tcp_output(server->pcb);
-
-			/* Reset the size of the data in the transmit buffer. */
-			server->length = 0;
-		}
+		/* Send everything queued, including the block still being written. */
+		TelnetFlush(TRUE);
 		/* See if the telnet connection should be closed; this will only occur once
 		 all transmitted data has been ACKed by the client (so that some or all
 		 of the final message is not lost). */
@@ -498,7 +656,7 @@ err_t TelnetPoll(void *arg, struct tcp_pcb *tpcb) {
 #ifdef TELNET_DEBUG
 			printf("[Telnet Server] Telnet server should be closed.\n\r");
 #endif
-			TelnetClose();
+			return TelnetClose();
 		}
 		ret_err = ERR_OK;
 	} else {
@@ -579,48 +737,169 @@ char TelnetRead(void) {
 }
 
 /**
- * Writes a character to the telnet interface.
+ * Writes a character to the telnet interface. This is used to echo received characters while a packet is processed,
+ * so it does not wait for space; the character is dropped if every transmit block is waiting to be acknowledged.
  *
  * @param character const char The character to write to the interface.
  * @retval none
  */
 void TelnetWrite(const char character) {
-	/* Delay until there is some space in the output buffer.  The buffer is not
-	 completly filled here to leave some room for the processing of received
-	 telnet commands. */
-	while (telnet_server.length > (sizeof(telnet_server.buffer) - 32)) {
-#ifdef TELNET_DEBUG
-		printf("[Telnet Server] Telnet buffer is full!\n\r");
-#endif
-		/* Handle periodic timers for LwIP */
-		LwIP_Periodic_Handle(GetLocalTime());
-	}
-
-	/* Write this character into the output buffer. */
-	telnet_server.buffer[telnet_server.length++] = character;
+	TxQueue_Write(&telnet_server.transmit, (const uint8_t*) &character, 1U);
 }
 
 /**
- * Writes a string to the specified Telnet server. Disables Ethernet
- * interrupts during this process in order to prevent an intervening
- * interrupt from corrupting the output buffer.
+ * Writes a string to the telnet interface. The string is copied into the transmit queue and any block it fills is
+ * handed to lwIP straight away. If the client does not make room for the whole string within TELNET_WRITE_TIMEOUT, or
+ * the connection is congested and there is no room now, none of it is written.
  *
  * @param string char* Pointer to a C-String to write to the interface.
  * @retval none
  */
 void TelnetWriteString(char* string) {
 	if (TelnetIsConnected() == TRUE) {
-#if 0
-		Eth_EXTI_Disable();
-#endif
-		while (*string) {
-			TelnetWrite(*string);
-			++string;
+		uint32_t length = strlen(string);
+		if (WaitTransmit(length) == TRUE) {
+			TxQueue_Write(&telnet_server.transmit, (const uint8_t*) string, length);
+			TelnetFlush(FALSE);
+		} else {
+			telnet_server.transmit.drops += length;
+		}
+	}
+}
+
+/**
+ * Writes a block of binary data to the telnet interface. Any byte equal to TELNET_IAC is doubled as required by
+ * RFC854, so the client must undo this before parsing the data.
+ *
+ * @param data const uint8_t* Pointer to the data to write.
+ * @param length uint32_t The number of bytes to write.
+ * @retval none
+ */
+void TelnetWriteBuffer(const uint8_t* data, uint32_t length) {
+	if (TelnetIsConnected() == TRUE) {
+		/* Make room for the data with every IAC doubled, so a frame is never cut short */
+		uint32_t escaped = length;
+		for (uint32_t i = 0U; i < length; ++i) {
+			escaped += (data[i] == (uint8_t) TELNET_IAC) ? 1U : 0U;
+		}
+		if (WaitTransmit(escaped) == FALSE) {
+			telnet_server.transmit.drops += escaped;
+			return;
+		}
+		while (length > 0U) {
+			/* Copy up to and including the next IAC, then copy the IAC again */
+			const uint8_t* iac = memchr(data, (uint8_t) TELNET_IAC, length);
+			uint32_t run = (iac == NULL) ? length : (uint32_t) (iac - data) + 1U;
+			TxQueue_Write(&telnet_server.transmit, data, run);
+			if (iac != NULL) {
+				TxQueue_Write(&telnet_server.transmit, iac, 1U);
+			}
+			data += run;
+			length -= run;
+		}
+		TelnetFlush(FALSE);
+	}
+}
+
+/**
+ * Formats a string directly into the telnet transmit queue, without an intermediate buffer. If the result does not
+ * fit in the block being written it is formatted again at the start of a new block. Results longer than a block are
+ * truncated. If no block is free within TELNET_WRITE_TIMEOUT, or the connection is congested and no block is free now,
+ * nothing is written.
+ *
+ * @param format const char* The printf style format string.
+ * @param ... The arguments for the format string.
+ * @retval none
+ */
+void TelnetWriteFormatted(const char* format, ...) {
+	if (TelnetIsConnected() == TRUE) {
+		uint32_t minimum = 1U;
+		for (;;) {
+			uint32_t space;
+			char* dest = (char*) ReserveTransmit(minimum, &space);
+			if (dest == NULL) {
+				++telnet_server.transmit.drops;
+				return;
+			}
+			va_list args;
+			va_start(args, format);
+			int n = vsnprintf(dest, space, format, args);
+			va_end(args);
+			if (n < 0) {
+				return;
+			}
+			if ((uint32_t) n < space) {
+				TxQueue_Commit(&telnet_server.transmit, (uint32_t) n);
+				break;
+			}
+			if (minimum == TX_QUEUE_BLOCK_SIZE) {
+				/* Keep what fits, without the terminator */
+				TxQueue_Commit(&telnet_server.transmit, space - 1U);
+				break;
+			}
+			/* Leave the rest of this block empty and format again with room for the terminator */
+			minimum = ((uint32_t) n < TX_QUEUE_BLOCK_SIZE) ? ((uint32_t) n + 1U) : TX_QUEUE_BLOCK_SIZE;
 		}
-#if 0
-		Eth_EXTI_Enable();
+		TelnetFlush(FALSE);
+	}
+}
+
+/**
+ * Retrieves the number of bytes which can be written to the telnet interface without waiting for the client.
+ *
+ * @param none
+ * @retval uint32_t The number of bytes.
+ */
+uint32_t TelnetGetWriteSpace(void) {
+	return (TelnetIsConnected() == TRUE) ? TxQueue_Available(&telnet_server.transmit) : 0U;
+}
+
+/**
+ * Waits for the client to acknowledge enough data that the specified number of bytes can be written. Received
+ * packets and the lwIP timers are serviced while waiting, so this must not be called from an lwIP callback.
+ *
+ * @param length uint32_t The number of bytes to make room for.
+ * @param timeout uint32_t The longest time to wait, in microseconds.
+ * @retval bool TRUE if there is room, FALSE if the time ran out or the connection was lost.
+ */
+bool TelnetWaitWriteSpace(uint32_t length, uint32_t timeout) {
+	uint64_t start = GetLocalTime();
+	while (TxQueue_Available(&telnet_server.transmit) < length) {
+		if ((TelnetIsConnected() == FALSE) || ((GetLocalTime() - start) >= timeout)) {
+#ifdef TELNET_DEBUG
+			printf("[Telnet Server] Telnet transmit queue is full!\n\r");
 #endif
+			return FALSE;
+		}
+		TelnetFlush(TRUE);
+		if (ETH_CheckFrameReceived()) {
+			LwIP_Pkt_Handle();
+		}
+		/* Handle periodic timers for LwIP */
+		LwIP_Periodic_Handle(GetLocalTime());
 	}
+	return TRUE;
+}
+
+/**
+ * Sets the format sampled data is written in for the current connection. Each new connection starts with
+ * TELNET_FORMAT_ASCII.
+ *
+ * @param format TelnetDataFormat_t The format to use.
+ * @retval none
+ */
+void TelnetSetDataFormat(TelnetDataFormat_t format) {
+	telnet_server.format = format;
+}
+
+/**
+ * Retrieves the format sampled data is written in for the current connection.
+ *
+ * @param none
+ * @retval TelnetDataFormat_t The format in use.
+ */
+TelnetDataFormat_t TelnetGetDataFormat(void) {
+	return telnet_server.format;
 }
 
 /**
@@ -650,9 +929,7 @@ void TelnetProcessWill(char option) {
 				TelnetOptions[ulIdx].flags = (TelnetOptions[ulIdx].flags & 0xFD)
 						| (0x01 << OPT_FLAG_WILL);
 				/* Send a DO response to this option. */
-				telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-				telnet_server.buffer[telnet_server.length++] = TELNET_DO;
-				telnet_server.buffer[telnet_server.length++] = option;
+				TelnetWriteOption(TELNET_DO, option);
 			}
 			/* Return without any further processing. */
 			return;
@@ -660,9 +937,7 @@ void TelnetProcessWill(char option) {
 	}
 
 	/* This option is not recognized, so send a DONT response. */
-	telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-	telnet_server.buffer[telnet_server.length++] = TELNET_DONT;
-	telnet_server.buffer[telnet_server.length++] = option;
+	TelnetWriteOption(TELNET_DONT, option);
 }
 
 /**
@@ -693,9 +968,7 @@ void TelnetProcessWont(char option) {
 				TelnetOptions[ulIdx].flags = (TelnetOptions[ulIdx].flags & 0xFD)
 						| 0x00;
 				/* Send a DONT response to this option. */
-				telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-				telnet_server.buffer[telnet_server.length++] = TELNET_DONT;
-				telnet_server.buffer[telnet_server.length++] = option;
+				TelnetWriteOption(TELNET_DONT, option);
 			}
 			/* Return without any further processing. */
 			return;
@@ -703,9 +976,7 @@ void TelnetProcessWont(char option) {
 	}
 
 	/* This option is not recognized, so send a DONT response. */
-	telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-	telnet_server.buffer[telnet_server.length++] = TELNET_DONT;
-	telnet_server.buffer[telnet_server.length++] = option;
+	TelnetWriteOption(TELNET_DONT, option);
 }
 
 /**
@@ -735,9 +1006,7 @@ void TelnetProcessDo(char option) {
 				TelnetOptions[ulIdx].flags = (TelnetOptions[ulIdx].flags & 0xFB)
 						| (0x01 << OPT_FLAG_DO);
 				/* Send a WILL response to this option. */
-				telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-				telnet_server.buffer[telnet_server.length++] = TELNET_WILL;
-				telnet_server.buffer[telnet_server.length++] = option;
+				TelnetWriteOption(TELNET_WILL, option);
 			}
 			/* Return without any further processing. */
 			return;
@@ -745,9 +1014,7 @@ void TelnetProcessDo(char option) {
 	}
 
 	// This option is not recognized, so send a WONT response.
-	telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-	telnet_server.buffer[telnet_server.length++] = TELNET_WONT;
-	telnet_server.buffer[telnet_server.length++] = option;
+	TelnetWriteOption(TELNET_WONT, option);
 }
 
 /**
@@ -777,9 +1044,7 @@ void TelnetProcessDont(char option) {
 				TelnetOptions[ulIdx].flags = (TelnetOptions[ulIdx].flags & 0xFB)
 						| 0x00;
 				/* Send a WONT response to this option. */
-				telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-				telnet_server.buffer[telnet_server.length++] = TELNET_WONT;
-				telnet_server.buffer[telnet_server.length++] = option;
+				TelnetWriteOption(TELNET_WONT, option);
 			}
 			/* Return without any further processing. */
 			return;
@@ -787,9 +1052,7 @@ void TelnetProcessDont(char option) {
 	}
 
 	/* This option is not recognized, so send a WONT response. */
-	telnet_server.buffer[telnet_server.length++] = TELNET_IAC;
-	telnet_server.buffer[telnet_server.length++] = TELNET_WONT;
-	telnet_server.buffer[telnet_server.length++] = option;
+	TelnetWriteOption(TELNET_WONT, option);
 }
 
 /*
@@ -870,15 +1133,7 @@ void TelnetProcessCharacter(char character) {
 		case TELNET_AYT: {
 			/* Send a short string back to the client so that it knows
 			 that the server is still alive. */
-			telnet_server.buffer[telnet_server.length++] = '\r';
-			telnet_server.buffer[telnet_server.length++] = '\n';
-			telnet_server.buffer[telnet_server.length++] = '[';
-			telnet_server.buffer[telnet_server.length++] = 'Y';
-			telnet_server.buffer[telnet_server.length++] = 'e';
-			telnet_server.buffer[telnet_server.length++] = 's';
-			telnet_server.buffer[telnet_server.length++] = ']';
-			telnet_server.buffer[telnet_server.length++] = '\r';
-			telnet_server.buffer[telnet_server.length++] = '\n';
+			TxQueue_Write(&telnet_server.transmit, (const uint8_t*) "\r\n[Yes]\r\n", 9U);
 			/* Switch back to normal mode. */
 			telnet_server.state = STATE_NORMAL;
 			/* This character has been handled. */
@@ -952,18 +1207,7 @@ void TelnetProcessCharacter(char character) {
  * @retval none
  */
 void TelnetWriteErrorMessage(char* message) {
-	if (TelnetIsConnected() == true) {
-		ClearToMessageBuffer();
-		char* character = message;
-		while (*character) {
-			character++;
-		}
-		uint16_t n = snprintf(MESSAGE_BUFFER, sizeof(MESSAGE_BUFFER),
-		ERROR_MESSAGE_HEADER, message);
-		if (n > 0) {
-			TelnetWriteString(MESSAGE_BUFFER);
-		}
-	}
+	TelnetWriteFormatted(ERROR_MESSAGE_HEADER, message);
 }
 
 /**
@@ -973,20 +1217,7 @@ void TelnetWriteErrorMessage(char* message) {
  * @retval none
  */
 void TelnetWriteStatusMessage(char* message) {
-	if (TelnetIsConnected() == true) {
-		ClearToMessageBuffer();
-		uint8_t count = 0;
-		char* character = message;
-		while (*character) {
-			++character;
-			++count;
-		}
-		uint16_t n = snprintf(MESSAGE_BUFFER, sizeof(MESSAGE_BUFFER),
-		STATUS_MESSAGE_HEADER, message);
-		if (n > 0) {
-			TelnetWriteString(MESSAGE_BUFFER);
-		}
-	}
+	TelnetWriteFormatted(STATUS_MESSAGE_HEADER, message);
 }
 
 /**
@@ -996,20 +1227,7 @@ void TelnetWriteStatusMessage(char* message) {
  * @retval none
  */
 void TelnetWriteDebugMessage(char* message) {
-	if (TelnetIsConnected() == true) {
-		ClearToMessageBuffer();
-		uint8_t count = 0;
-		char* character = message;
-		while (*character) {
-			++character;
-			++count;
-		}
-		uint16_t n = snprintf(MESSAGE_BUFFER, sizeof(MESSAGE_BUFFER),
-		DEBUG_MESSAGE_HEADER, message);
-		if (n > 0) {
-			TelnetWriteString(MESSAGE_BUFFER);
-		}
-	}
+	TelnetWriteFormatted(DEBUG_MESSAGE_HEADER, message);
 }
 
 /**
@@ -1019,18 +1237,5 @@ void TelnetWriteDebugMessage(char* message) {
  * @retval none
  */
 void TelnetWriteCommandDataMessage(char* message) {
-	if (TelnetIsConnected() == true) {
-		ClearToMessageBuffer();
-		uint8_t count = 0;
-		char* character = message;
-		while (*character) {
-			++character;
-			++count;
-		}
-		uint16_t n = snprintf(MESSAGE_BUFFER, sizeof(MESSAGE_BUFFER),
-		COMMAND_DATA_MESSAGE_HEADER, message);
-		if (n > 0) {
-			TelnetWriteString(MESSAGE_BUFFER);
-		}
-	}
+	TelnetWriteFormatted(COMMAND_DATA_MESSAGE_HEADER, message);
 }
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Bench_SampleCorrection.c
+ * @brief Host benchmark of the fixed point sample correction pipeline against the float path it replaced.
+ *
+ * Both paths correct every 24 bit code a block at a time, and the time per reading is reported along with the number
+ * of codes on which the two differ. The timings are taken on the host, so they only indicate the relative cost.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Tekdaqc_SampleCorrection.h"
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+/**
+ * @internal
+ * @brief The number of codes a 24 bit reading can take.
+ */
+#define NUM_CODES	0x01000000U
+
+/**
+ * @internal
+ * @brief The number of readings corrected per call.
+ */
+#define BLOCK_SIZE	4096U
+
+/**
+ * @internal
+ * @brief The number of passes over every code.
+ */
+#define NUM_PASSES	4U
+
+/**
+ * @internal
+ * The float path: sign extend the reading, multiply by the gain correction factor and round.
+ */
+static void FloatPath(float factor, const uint32_t* raw, int32_t* corrected, uint32_t count) {
+	for (uint32_t i = 0U; i < count; ++i) {
+		corrected[i] = (int32_t) roundf(factor * (float) SampleCorrection_SignExtend(raw[i]));
+	}
+}
+
+static double Now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1.0e-9);
+}
+
+int main(void) {
+	const float factor = 1.00417f;
+	SampleCorrection_t correction;
+	uint32_t raw[BLOCK_SIZE];
+	int32_t fixed[BLOCK_SIZE];
+	int32_t floating[BLOCK_SIZE];
+	uint32_t differ = 0U;
+	int64_t checksum = 0;
+	double fixedTime = 0.0;
+	double floatTime = 0.0;
+
+	SampleCorrection_Init(&correction);
+	correction.gain = SampleCorrection_GainFromFactor(factor);
+	for (uint32_t pass = 0U; pass < NUM_PASSES; ++pass) {
+		for (uint32_t code = 0U; code < NUM_CODES; code += BLOCK_SIZE) {
+			for (uint32_t i = 0U; i < BLOCK_SIZE; ++i) {
+				raw[i] = code + i;
+			}
+			double start = Now();
+			SampleCorrection_ApplyRawBlock(&correction, raw, fixed, BLOCK_SIZE);
+			double middle = Now();
+			FloatPath(factor, raw, floating, BLOCK_SIZE);
+			floatTime += Now() - middle;
+			fixedTime += middle - start;
+			for (uint32_t i = 0U; i < BLOCK_SIZE; ++i) {
+				differ += ((pass == 0U) && (fixed[i] != floating[i])) ? 1U : 0U;
+				checksum += fixed[i] - floating[i];
+			}
+		}
+	}
+	printf("fixed point %.2f ns/reading, float %.2f ns/reading, %u of %u codes differ (checksum %lld)\n",
+			fixedTime * 1.0e9 / ((double) NUM_CODES * NUM_PASSES), floatTime * 1.0e9 / ((double) NUM_CODES * NUM_PASSES),
+			differ, NUM_CODES, (long long) checksum);
+	return 0;
+}
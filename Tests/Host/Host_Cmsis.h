@@ -0,0 +1,40 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Host_Cmsis.h
+ * @brief Host stand-ins for the Cortex-M4 intrinsics.
+ *
+ * Included ahead of every source in the host test build. It claims the include guards of the CMSIS intrinsic headers,
+ * whose inline assembly only builds for the target, and defines the intrinsics the firmware uses in their place. The
+ * peripheral registers remain declared at their target addresses, so a test must not touch them.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#ifndef HOST_CMSIS_H_
+#define HOST_CMSIS_H_
+
+#define __CORE_CMINSTR_H
+#define __CORE_CMFUNC_H
+#define __CORE_CM4_SIMD_H
+
+#define __NOP()				((void) 0)
+#define __DMB()				__sync_synchronize()
+#define __DSB()				__sync_synchronize()
+#define __ISB()				__sync_synchronize()
+#define __enable_irq()		((void) 0)
+#define __disable_irq()		((void) 0)
+
+#endif /* HOST_CMSIS_H_ */
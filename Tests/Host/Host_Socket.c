@@ -0,0 +1,87 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Host_Socket.c
+ * @brief Host loopback UDP sockets.
+ *
+ * The receiving socket is bound to an ephemeral loopback port with a large receive buffer, so a test can send a long
+ * burst before draining it.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Host_Socket.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* The receive buffer requested for the receiving socket, in bytes */
+#define RECEIVE_BUFFER_SIZE		(1 << 22)
+
+/* The socket datagrams are sent from */
+static int transmitSocket = -1;
+
+/* The socket datagrams are received on */
+static int receiveSocket = -1;
+
+/**
+ * Opens the sending socket and binds the receiving socket to an ephemeral loopback port.
+ *
+ * @param address uint32_t* Filled with the loopback address, in network byte order.
+ * @retval uint16_t The port datagrams are received on, 0 if the sockets could not be opened.
+ */
+uint16_t HostSocket_Open(uint32_t* address) {
+	struct sockaddr_in local = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+	socklen_t size = sizeof(local);
+	int buffer = RECEIVE_BUFFER_SIZE;
+	receiveSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	transmitSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	if ((receiveSocket < 0) || (transmitSocket < 0)) {
+		return 0U;
+	}
+	setsockopt(receiveSocket, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+	if ((bind(receiveSocket, (struct sockaddr*) &local, sizeof(local)) != 0)
+			|| (getsockname(receiveSocket, (struct sockaddr*) &local, &size) != 0)) {
+		return 0U;
+	}
+	*address = local.sin_addr.s_addr;
+	return ntohs(local.sin_port);
+}
+
+/**
+ * Sends a datagram.
+ *
+ * @param data const void* The datagram payload.
+ * @param length uint32_t The number of bytes in the payload.
+ * @param address uint32_t The destination address, in network byte order.
+ * @param port uint16_t The destination port.
+ * @retval int32_t 0 if the datagram was sent whole, -1 otherwise.
+ */
+int32_t HostSocket_Send(const void* data, uint32_t length, uint32_t address, uint16_t port) {
+	struct sockaddr_in to = { .sin_family = AF_INET, .sin_port = htons(port), .sin_addr.s_addr = address };
+	return (sendto(transmitSocket, data, length, 0, (struct sockaddr*) &to, sizeof(to)) == (ssize_t) length) ? 0 : -1;
+}
+
+/**
+ * Receives a datagram waiting on the receiving socket, without blocking.
+ *
+ * @param buffer void* The buffer to receive into.
+ * @param size uint32_t The size of the buffer.
+ * @retval int32_t The length of the datagram, 0 if none is waiting.
+ */
+int32_t HostSocket_Receive(void* buffer, uint32_t size) {
+	ssize_t length = recv(receiveSocket, buffer, size, MSG_DONTWAIT);
+	return (length > 0) ? (int32_t) length : 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Host_Socket.h
+ * @brief Host loopback UDP sockets.
+ *
+ * Lets a test send datagrams over a real 127.0.0.1 socket and receive them again. Kept apart from the firmware
+ * headers, whose lwIP byte order macros clash with the host's.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#ifndef HOST_SOCKET_H_
+#define HOST_SOCKET_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Opens the loopback sockets, returning the receiving port or 0 on failure.
+ */
+uint16_t HostSocket_Open(uint32_t* address);
+
+/**
+ * @brief Sends a datagram, returning 0 if it was sent whole.
+ */
+int32_t HostSocket_Send(const void* data, uint32_t length, uint32_t address, uint16_t port);
+
+/**
+ * @brief Receives a waiting datagram without blocking, returning its length or 0 if there is none.
+ */
+int32_t HostSocket_Receive(void* buffer, uint32_t size);
+
+#endif /* HOST_SOCKET_H_ */
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Host_Stubs.c
+ * @brief Host stand-ins for the peripheral drivers and board functions the tested sources call.
+ *
+ * Every stand-in does nothing, or returns a value which lets the caller carry on, and is weak so that a test can
+ * replace it with a mock of its own.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Tekdaqc_Config.h"
+#include "Tekdaqc_Timers.h"
+#include "ADS1256_SPI_Controller.h"
+#include "Tekdaqc_CalibrationTable.h"
+#include "TelnetServer.h"
+#include "ADC_StateMachine.h"
+
+#define HOST_STUB	__attribute__((weak))
+
+char TOSTRING_BUFFER[SIZE_TOSTRING_BUFFER];
+
+/* Board */
+HOST_STUB void DisableBoardInterrupts(void) {}
+HOST_STUB void EnableBoardInterrupts(void) {}
+HOST_STUB void InitAnalogSamplesBuffer(void) {}
+HOST_STUB uint64_t GetLocalTime(void) { return 0U; }
+HOST_STUB void Delay_ms(float ms) { (void) ms; }
+HOST_STUB void Delay_us(uint64_t us) { (void) us; }
+HOST_STUB void ADC_External_Muxing(void) {}
+HOST_STUB void TelnetWriteErrorMessage(char* message) { (void) message; }
+
+/* Calibration table, which reads as uncalibrated */
+HOST_STUB uint32_t Tekdaqc_GetGainCalibration(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1256_BUFFER_t buffer) {
+	(void) rate;
+	(void) gain;
+	(void) buffer;
+	return 0U;
+}
+HOST_STUB uint32_t Tekdaqc_GetOffsetCalibration(ADS1256_SPS_t rate, ADS1256_PGA_t gain, ADS1256_BUFFER_t buffer) {
+	(void) rate;
+	(void) gain;
+	(void) buffer;
+	return 0U;
+}
+HOST_STUB uint32_t Tekdaqc_GetColdJunctionOffsetCalibration(void) { return 0U; }
+HOST_STUB uint32_t Tekdaqc_GetColdJunctionGainCalibration(void) { return 0U; }
+
+/* ADS1256 SPI */
+HOST_STUB void ADS1256_SPI_Init(void) {}
+HOST_STUB void ADS1256_CLK_To_GPIO(void) {}
+HOST_STUB void ADS1256_GPIO_To_CLK(void) {}
+HOST_STUB uint8_t ADS1256_SendByte(uint8_t data) { (void) data; return 0U; }
+HOST_STUB void ADS1256_SendBytes(uint8_t* data, uint8_t n) { (void) data; (void) n; }
+HOST_STUB void ADS1256_ReceiveBytes(uint8_t* data, uint8_t n) { while (n-- > 0U) { *data++ = 0U; } }
+
+/* Standard peripheral library */
+HOST_STUB void NVIC_Init(NVIC_InitTypeDef* init) { (void) init; }
+HOST_STUB void EXTI_Init(EXTI_InitTypeDef* init) { (void) init; }
+HOST_STUB void EXTI_ClearITPendingBit(uint32_t line) { (void) line; }
+HOST_STUB void SYSCFG_EXTILineConfig(uint8_t port, uint8_t pin) { (void) port; (void) pin; }
+HOST_STUB void RCC_AHB1PeriphClockCmd(uint32_t periph, FunctionalState state) { (void) periph; (void) state; }
+HOST_STUB void RCC_APB1PeriphClockCmd(uint32_t periph, FunctionalState state) { (void) periph; (void) state; }
+HOST_STUB void RCC_APB2PeriphClockCmd(uint32_t periph, FunctionalState state) { (void) periph; (void) state; }
+HOST_STUB void GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init) { (void) port; (void) init; }
+HOST_STUB void GPIO_PinAFConfig(GPIO_TypeDef* port, uint16_t source, uint8_t af) { (void) port; (void) source; (void) af; }
+HOST_STUB uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* port, uint16_t pin) { (void) port; (void) pin; return 0U; }
+HOST_STUB void GPIO_SetBits(GPIO_TypeDef* port, uint16_t pin) { (void) port; (void) pin; }
+HOST_STUB void GPIO_ResetBits(GPIO_TypeDef* port, uint16_t pin) { (void) port; (void) pin; }
+HOST_STUB void GPIO_WriteBit(GPIO_TypeDef* port, uint16_t pin, BitAction value) { (void) port; (void) pin; (void) value; }
+HOST_STUB void GPIO_Write(GPIO_TypeDef* port, uint16_t value) { (void) port; (void) value; }
+HOST_STUB uint16_t GPIO_ReadOutputData(GPIO_TypeDef* port) { (void) port; return 0U; }
+HOST_STUB void TIM_TimeBaseInit(TIM_TypeDef* tim, TIM_TimeBaseInitTypeDef* init) { (void) tim; (void) init; }
+HOST_STUB void TIM_SetCounter(TIM_TypeDef* tim, uint32_t counter) { (void) tim; (void) counter; }
+HOST_STUB void TIM_SetAutoreload(TIM_TypeDef* tim, uint32_t autoreload) { (void) tim; (void) autoreload; }
+/* Reads as expired, so short delays return at once */
+HOST_STUB uint32_t TIM_GetCounter(TIM_TypeDef* tim) { (void) tim; return UINT32_MAX; }
+HOST_STUB void TIM_SelectOnePulseMode(TIM_TypeDef* tim, uint16_t mode) { (void) tim; (void) mode; }
+HOST_STUB void TIM_Cmd(TIM_TypeDef* tim, FunctionalState state) { (void) tim; (void) state; }
+HOST_STUB void TIM_ITConfig(TIM_TypeDef* tim, uint16_t it, FunctionalState state) { (void) tim; (void) it; (void) state; }
+HOST_STUB void TIM_GenerateEvent(TIM_TypeDef* tim, uint16_t source) { (void) tim; (void) source; }
+HOST_STUB void TIM_ClearITPendingBit(TIM_TypeDef* tim, uint16_t it) { (void) tim; (void) it; }
@@ -0,0 +1,5 @@
+/*
+ * The sources include this header as Tekdaqc_Config.h, which only resolves to Tekdaqc_config.h on a case insensitive
+ * file system.
+ */
+#include "Tekdaqc_config.h"
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Test.h
+ * @brief Checks shared by the host tests.
+ *
+ * Each test is a single program. A failed check is reported with its location and counted, and the program exits
+ * with TEST_RESULT(), which is non-zero if any check failed.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+/**
+ * @internal
+ * @brief The number of checks which have failed.
+ */
+static unsigned int test_failures = 0U;
+
+/**
+ * @def TEST_CHECK
+ * @brief Checks that a condition holds, reporting it if not.
+ */
+#define TEST_CHECK(condition)																			\
+	do {																								\
+		if (!(condition)) {																				\
+			printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);									\
+			++test_failures;																			\
+		}																								\
+	} while (0)
+
+/**
+ * @def TEST_RESULT
+ * @brief Reports the outcome of the test, evaluating to its exit status.
+ */
+#define TEST_RESULT()	((test_failures == 0U) ? (printf("PASS\n"), 0) : (printf("FAILED %u\n", test_failures), 1))
+
+#endif /* TEST_H_ */
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Test_ADS1256_Driver.c
+ * @brief Host test of the ADS1256 register shadow and its commit bursts.
+ *
+ * The driver runs against a mock device behind the SPI functions. The mock collects the bytes sent while chip select
+ * is low, decodes WREG and RREG commands against its own register file and records each burst, so the test can check
+ * which registers are written, in how many bursts and how many bytes that takes.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Test.h"
+#include "ADS1256_Driver.h"
+#include "ADS1256_SPI_Controller.h"
+#include <string.h>
+
+/**
+ * @internal
+ * @brief The first byte of a WREG command, with the register in the low nibble.
+ */
+#define MOCK_WREG	0x50U
+
+/**
+ * @internal
+ * @brief The first byte of an RREG command, with the register in the low nibble.
+ */
+#define MOCK_RREG	0x10U
+
+/* The register file of the mock device */
+static uint8_t chip[ADS1256_REGISTER_IMAGE_SIZE];
+
+/* The bytes sent since chip select went low */
+static uint8_t sent[64];
+static uint32_t numSent = 0U;
+static bool selected = FALSE;
+
+/* What the mock has seen since the last MockReset() */
+static uint32_t transactions = 0U;
+static uint32_t bursts = 0U;
+static int32_t burstStart = -1;
+static uint32_t burstLength = 0U;
+
+static void MockReset(void) {
+	transactions = 0U;
+	bursts = 0U;
+	burstStart = -1;
+	burstLength = 0U;
+}
+
+/* Applies a WREG transaction to the register file */
+static void MockEndTransaction(void) {
+	if ((numSent >= 2U) && ((sent[0] & 0xF0U) == MOCK_WREG)) {
+		uint32_t reg = sent[0] & 0x0FU;
+		uint32_t count = (sent[1] & 0x0FU) + 1U;
+		TEST_CHECK(numSent == (2U + count));
+		TEST_CHECK((reg + count) <= ADS1256_REGISTER_IMAGE_SIZE);
+		memcpy(&chip[reg], &sent[2], count);
+		++bursts;
+		burstStart = (int32_t) reg;
+		burstLength = count;
+	}
+	++transactions;
+}
+
+void GPIO_ResetBits(GPIO_TypeDef* port, uint16_t pin) {
+	(void) port;
+	(void) pin;
+	selected = TRUE;
+	numSent = 0U;
+}
+
+void GPIO_SetBits(GPIO_TypeDef* port, uint16_t pin) {
+	(void) port;
+	(void) pin;
+	if (selected == TRUE) {
+		MockEndTransaction();
+	}
+	selected = FALSE;
+}
+
+uint8_t ADS1256_SendByte(uint8_t data) {
+	TEST_CHECK(numSent < sizeof(sent));
+	sent[numSent++] = data;
+	return 0U;
+}
+
+void ADS1256_SendBytes(uint8_t* data, uint8_t n) {
+	for (uint8_t i = 0U; i < n; ++i) {
+		ADS1256_SendByte(data[i]);
+	}
+}
+
+void ADS1256_ReceiveBytes(uint8_t* data, uint8_t n) {
+	if ((sent[0] & 0xF0U) == MOCK_RREG) {
+		memcpy(data, &chip[sent[0] & 0x0FU], n);
+	} else {
+		memset(data, 0, n);
+	}
+}
+
+/* Setters produce no traffic until a command, which is preceded by a single burst */
+static void TestCoalescing(void) {
+	MockReset();
+	ADS1256_SetDataRate(ADS1256_SPS_100);
+	ADS1256_SetPGASetting(ADS1256_PGAx8);
+	ADS1256_SetInputBufferSetting(ADS1256_BUFFER_ENABLED);
+	ADS1256_SetInputChannels(ADS1256_AIN2, ADS1256_AIN3);
+	TEST_CHECK(transactions == 0U);
+	ADS1256_Sync(TRUE);
+	TEST_CHECK(bursts == 1U);
+	TEST_CHECK(burstStart == ADS1256_STATUS);
+	TEST_CHECK(burstLength == 4U);
+	TEST_CHECK(transactions == 2U);
+	TEST_CHECK(chip[ADS1256_DRATE] == ADS1256_SPS_100);
+	TEST_CHECK((chip[ADS1256_ADCON] & 0x07U) == ADS1256_PGAx8);
+	TEST_CHECK(((chip[ADS1256_STATUS] >> 1U) & 0x01U) == ADS1256_BUFFER_ENABLED);
+	TEST_CHECK(chip[ADS1256_MUX] == 0x23U);
+}
+
+/* Setting a register to the value it holds marks nothing dirty */
+static void TestUnchanged(void) {
+	MockReset();
+	ADS1256_SetDataRate(ADS1256_SPS_100);
+	ADS1256_SetPGASetting(ADS1256_PGAx8);
+	ADS1256_Sync(TRUE);
+	TEST_CHECK(bursts == 0U);
+	TEST_CHECK(transactions == 1U);
+}
+
+/* A burst spans the lowest to the highest dirty register only */
+static void TestSpan(void) {
+	uint8_t calibration[3] = { 0x11U, 0x22U, 0x33U };
+	MockReset();
+	ADS1256_SetPGASetting(ADS1256_PGAx2);
+	ADS1256_Sync(TRUE);
+	TEST_CHECK((bursts == 1U) && (burstStart == ADS1256_ADCON) && (burstLength == 1U));
+	MockReset();
+	ADS1256_SetDataRate(ADS1256_SPS_1000);
+	ADS1256_SetGainCalSetting(calibration);
+	ADS1256_Sync(TRUE);
+	TEST_CHECK((bursts == 1U) && (burstStart == ADS1256_DRATE) && (burstLength == 8U));
+	TEST_CHECK((chip[ADS1256_FSC0] == 0x11U) && (chip[ADS1256_FSC2] == 0x33U));
+	TEST_CHECK(chip[ADS1256_DRATE] == ADS1256_SPS_1000);
+}
+
+/* A register read flushes the pending writes first */
+static void TestReadFlushes(void) {
+	MockReset();
+	ADS1256_SetDataRate(ADS1256_SPS_50);
+	TEST_CHECK(ADS1256_GetDataRate() == ADS1256_SPS_50);
+	TEST_CHECK((bursts == 1U) && (chip[ADS1256_DRATE] == ADS1256_SPS_50));
+}
+
+/* A forced image load writes every register, an unchanged one writes nothing */
+static void TestRegisterImage(void) {
+	uint8_t image[ADS1256_REGISTER_IMAGE_SIZE];
+	ADS1256_BuildRegisterImage(image, ADS1256_AIN0, ADS1256_AIN1, ADS1256_BUFFER_DISABLED, ADS1256_PGAx64,
+			ADS1256_SPS_10, 0x0A0B0CU, 0x445566U);
+	MockReset();
+	TEST_CHECK(ADS1256_LoadRegisterImage(image, TRUE) == TRUE);
+	TEST_CHECK((bursts == 1U) && (burstStart == 0) && (burstLength == ADS1256_REGISTER_IMAGE_SIZE));
+	TEST_CHECK((chip[ADS1256_OFC0] == 0x0CU) && (chip[ADS1256_OFC2] == 0x0AU) && (chip[ADS1256_FSC1] == 0x55U));
+	TEST_CHECK(ADS1256_GetPGASetting() == ADS1256_PGAx64);
+	MockReset();
+	TEST_CHECK(ADS1256_LoadRegisterImage(image, FALSE) == FALSE);
+	TEST_CHECK(transactions == 0U);
+}
+
+/* The statistics count what the set calls would have sent against what was sent */
+static void TestStatistics(void) {
+	ADS1256_WriteStats_t stats;
+	ADS1256_ResetWriteStats();
+	ADS1256_SetDataRate(ADS1256_SPS_30);
+	ADS1256_SetPGASetting(ADS1256_PGAx1);
+	ADS1256_SetDataRate(ADS1256_SPS_30);
+	TEST_CHECK(ADS1256_Commit() == TRUE);
+	TEST_CHECK(ADS1256_Commit() == FALSE);
+	ADS1256_GetWriteStats(&stats);
+	/* Three single register writes of 3 bytes against one ADCON to DRATE burst of 4 bytes */
+	TEST_CHECK(stats.commits == 1U);
+	TEST_CHECK(stats.bytesRequested == 9U);
+	TEST_CHECK(stats.bytesWritten == 4U);
+	TEST_CHECK(stats.bytesSaved == 5);
+}
+
+/* The settling time of the current configuration comes from the same t18 table as that of any rate */
+static void TestSettlingTime(void) {
+	TEST_CHECK(ADS1256_GetSettlingTimeForRate(ADS1256_SPS_30000) == 210U);
+	TEST_CHECK(ADS1256_GetSettlingTimeForRate(ADS1256_SPS_2_5) == 400180U);
+	ADS1256_SetDataRate(ADS1256_SPS_1000);
+	TEST_CHECK(ADS1256_GetSettlingTime() == 1.18f);
+	ADS1256_SetDataRate(ADS1256_SPS_15);
+	TEST_CHECK(ADS1256_GetSettlingTime() == 66.84f);
+}
+
+int main(void) {
+	TestCoalescing();
+	TestUnchanged();
+	TestSpan();
+	TestReadFlushes();
+	TestRegisterImage();
+	TestStatistics();
+	TestSettlingTime();
+	return TEST_RESULT();
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Test_AnalogScan.c
+ * @brief Host test of the analog scan compiler.
+ *
+ * Scans are compiled from a table of inputs standing in for the analog input list, with the ADC settling times taken
+ * from the driver, and the resulting table order, relay links, relay hops and predicted pass time are checked. The
+ * relay switching and the frame pacing of multi-rate schedules are checked against a mocked clock and multiplexer
+ * port.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Test.h"
+#include "Analog_ScanList.h"
+#include "AnalogInput_Multiplexer.h"
+
+/* The inputs the scans are compiled from, indexed by physical input */
+static Analog_Input_t inputs[NUM_ANALOG_INPUTS];
+
+/* The mocked clock, in microseconds */
+static uint64_t now = 0U;
+
+/* The number of writes to the external multiplexer port */
+static uint32_t relayWrites = 0U;
+
+Analog_Input_t* GetAnalogInputByNumber(uint8_t number) {
+	return &inputs[number];
+}
+
+uint64_t GetLocalTime(void) {
+	return now;
+}
+
+void GPIO_Write(GPIO_TypeDef* port, uint16_t value) {
+	(void) port;
+	(void) value;
+	++relayWrites;
+}
+
+/* Sets up an input for the next scan */
+static Analog_Input_t* Input(PhysicalAnalogInput_t physical, ADS1256_SPS_t rate) {
+	Analog_Input_t* input = &inputs[physical];
+	input->added = CHANNEL_ADDED;
+	input->physicalInput = physical;
+	input->rate = rate;
+	input->gain = ADS1256_PGAx1;
+	input->buffer = ADS1256_BUFFER_ENABLED;
+	input->period = 0U;
+	if (isExternalInput(physical)) {
+		input->externalInput = GetExternalMuxedInputByNumber((uint8_t) physical);
+	} else {
+		input->internalInput = (InternalAnalogInput_t) (physical - IN_SUPPLY_9V);
+	}
+	return input;
+}
+
+/* Checks that the compiled table holds each input exactly once */
+static void CheckPermutation(Analog_Input_t* list[], uint8_t count) {
+	TEST_CHECK(AnalogScan_GetCount() == count);
+	for (uint8_t i = 0U; i < count; ++i) {
+		uint8_t found = 0U;
+		for (uint8_t j = 0U; j < AnalogScan_GetCount(); ++j) {
+			found += (AnalogScan_GetEntry(j)->input == list[i]) ? 1U : 0U;
+		}
+		TEST_CHECK(found == 1U);
+	}
+}
+
+/* Internal inputs are placed in front of the externals, which keep their order, and switch the relays ahead */
+static void TestInterleave(void) {
+	Analog_Input_t* list[] = { Input(IN_SUPPLY_9V, ADS1256_SPS_2000), Input(EXTERNAL_0, ADS1256_SPS_2000),
+			Input(EXTERNAL_1, ADS1256_SPS_2000), Input(IN_SUPPLY_5V, ADS1256_SPS_2000), Input(EXTERNAL_2, ADS1256_SPS_2000),
+			Input(IN_SUPPLY_3_3V, ADS1256_SPS_2000) };
+	const uint32_t convert = ADS1256_GetSettlingTimeForRate(ADS1256_SPS_2000);
+	TEST_CHECK(AnalogScan_Compile(list, 6U) == ERR_FUNCTION_OK);
+	CheckPermutation(list, 6U);
+	TEST_CHECK(AnalogScan_GetEntry(1U)->physicalInput == EXTERNAL_0);
+	TEST_CHECK(AnalogScan_GetEntry(3U)->physicalInput == EXTERNAL_1);
+	TEST_CHECK(AnalogScan_GetEntry(5U)->physicalInput == EXTERNAL_2);
+	for (uint8_t i = 0U; i < 6U; i += 2U) {
+		TEST_CHECK(AnalogScan_GetEntry(i)->external == FALSE);
+		TEST_CHECK(AnalogScan_GetEntry(i)->relay == AnalogScan_GetEntry(i + 1U));
+		TEST_CHECK(AnalogScan_GetEntry(i + 1U)->relay == AnalogScan_GetEntry(i + 1U));
+	}
+	/* Each internal conversion hides part of the settling of the external after it */
+	TEST_CHECK(AnalogScan_GetRelayHops() == 3U);
+	TEST_CHECK(AnalogScan_GetPredictedPeriod() == ((6U * convert) + (3U * (ANALOG_SCAN_MUX_SETTLE_TIME - convert))));
+	TEST_CHECK(AnalogScan_GetFramePeriod() == 0U);
+}
+
+/* Internal inputs are dealt out longest conversion first to the window with the most time left to hide */
+static void TestLongestFirst(void) {
+	Analog_Input_t* list[] = { Input(EXTERNAL_0, ADS1256_SPS_1000), Input(IN_SUPPLY_3_3V, ADS1256_SPS_2000),
+			Input(EXTERNAL_1, ADS1256_SPS_1000), Input(IN_SUPPLY_5V, ADS1256_SPS_1000), Input(IN_SUPPLY_9V, ADS1256_SPS_100) };
+	TEST_CHECK(AnalogScan_Compile(list, 5U) == ERR_FUNCTION_OK);
+	CheckPermutation(list, 5U);
+	TEST_CHECK(AnalogScan_GetEntry(0U)->physicalInput == IN_SUPPLY_9V);
+	TEST_CHECK(AnalogScan_GetEntry(1U)->physicalInput == EXTERNAL_0);
+	TEST_CHECK(AnalogScan_GetEntry(2U)->physicalInput == IN_SUPPLY_5V);
+	TEST_CHECK(AnalogScan_GetEntry(3U)->physicalInput == IN_SUPPLY_3_3V);
+	TEST_CHECK(AnalogScan_GetEntry(4U)->physicalInput == EXTERNAL_1);
+	TEST_CHECK(AnalogScan_GetRelayHops() == 2U);
+}
+
+/* A scan of only internal or only external inputs keeps the requested order */
+static void TestUnplanned(void) {
+	Analog_Input_t* internals[] = { Input(IN_SUPPLY_5V, ADS1256_SPS_1000), Input(IN_SUPPLY_9V, ADS1256_SPS_100) };
+	Analog_Input_t* externals[] = { Input(EXTERNAL_3, ADS1256_SPS_2000), Input(EXTERNAL_1, ADS1256_SPS_2000) };
+	TEST_CHECK(AnalogScan_Compile(internals, 2U) == ERR_FUNCTION_OK);
+	TEST_CHECK(AnalogScan_GetEntry(0U)->input == internals[0]);
+	TEST_CHECK(AnalogScan_GetEntry(1U)->input == internals[1]);
+	TEST_CHECK(AnalogScan_GetRelayHops() == 0U);
+	TEST_CHECK(AnalogScan_GetPredictedPeriod()
+			== (ADS1256_GetSettlingTimeForRate(ADS1256_SPS_1000) + ADS1256_GetSettlingTimeForRate(ADS1256_SPS_100)));
+	TEST_CHECK(AnalogScan_Compile(externals, 2U) == ERR_FUNCTION_OK);
+	TEST_CHECK(AnalogScan_GetEntry(0U)->input == externals[0]);
+	TEST_CHECK(AnalogScan_GetRelayHops() == 2U);
+	TEST_CHECK(AnalogScan_GetPredictedPeriod()
+			== (2U * (ANALOG_SCAN_MUX_SETTLE_TIME + ADS1256_GetSettlingTimeForRate(ADS1256_SPS_2000))));
+}
+
+/* The settle wait counts from when the relays last moved, and the relays are only written when they change */
+static void TestSelect(void) {
+	Analog_Input_t* list[] = { Input(IN_SUPPLY_9V, ADS1256_SPS_2000), Input(EXTERNAL_0, ADS1256_SPS_2000) };
+	const AnalogScan_Entry_t* internal;
+	const AnalogScan_Entry_t* external;
+	TEST_CHECK(AnalogScan_Compile(list, 2U) == ERR_FUNCTION_OK);
+	internal = AnalogScan_GetEntry(0U);
+	external = AnalogScan_GetEntry(1U);
+	relayWrites = 0U;
+	now = 1000000U;
+	TEST_CHECK(AnalogScan_Select(internal, external) == 0U);
+	TEST_CHECK(relayWrites == 1U);
+	now += 680U;
+	TEST_CHECK(AnalogScan_Select(external, internal) == (ANALOG_SCAN_MUX_SETTLE_TIME - 680U));
+	now += ANALOG_SCAN_MUX_SETTLE_TIME;
+	TEST_CHECK(AnalogScan_Select(external, internal) == 0U);
+	/* A cold junction read between two reads of the same external does not move the relays */
+	TEST_CHECK(AnalogScan_Select(AnalogScan_GetColdJunction(), external) == 0U);
+	TEST_CHECK(AnalogScan_Select(external, AnalogScan_GetColdJunction()) == 0U);
+	TEST_CHECK(relayWrites == 1U);
+}
+
+/* Inputs with periods are spread over the frames of a multi-rate schedule, each at its own rate */
+static void TestMultiRate(void) {
+	Analog_Input_t* list[] = { Input(IN_SUPPLY_9V, ADS1256_SPS_30000), Input(EXTERNAL_0, ADS1256_SPS_30000),
+			Input(EXTERNAL_1, ADS1256_SPS_30000), Input(EXTERNAL_2, ADS1256_SPS_30000) };
+	uint32_t seen[8][4] = { { 0U } };
+	uint8_t index;
+	uint8_t phase = 0U;
+	list[0]->period = 2000U;
+	list[1]->period = 10000000U;
+	list[2]->period = 10000000U;
+	list[3]->period = 8000U;
+	TEST_CHECK(AnalogScan_Compile(list, 4U) == ERR_FUNCTION_OK);
+	CheckPermutation(list, 4U);
+	TEST_CHECK(AnalogScan_GetFramePeriod() == 2000U);
+	index = AnalogScan_Rewind(0U);
+	while (AnalogScan_GetFrame() < 8U) {
+		uint8_t next = AnalogScan_Peek(index);
+		for (uint8_t i = 0U; i < 4U; ++i) {
+			seen[AnalogScan_GetFrame()][i] += (AnalogScan_GetEntry(index)->input == list[i]) ? 1U : 0U;
+		}
+		index = AnalogScan_Advance(index);
+		TEST_CHECK(index == next);
+	}
+	while ((phase < 4U) && (seen[phase][3] == 0U)) {
+		++phase;
+	}
+	TEST_CHECK(phase < 4U);
+	for (uint8_t frame = 0U; frame < 8U; ++frame) {
+		/* The fastest input is in every frame, the 8 ms input in every fourth and at most one external per frame */
+		TEST_CHECK(seen[frame][0] == 1U);
+		TEST_CHECK(seen[frame][3] == (((frame % 4U) == phase) ? 1U : 0U));
+		TEST_CHECK((seen[frame][1] + seen[frame][2] + seen[frame][3]) <= 1U);
+	}
+	/* The slow inputs are each sampled once in the first frames with room for them */
+	TEST_CHECK((seen[0][1] + seen[1][1] + seen[2][1] + seen[3][1]) == 1U);
+	TEST_CHECK((seen[0][2] + seen[1][2] + seen[2][2] + seen[3][2]) == 1U);
+	TEST_CHECK((seen[4][1] + seen[5][1] + seen[6][1] + seen[7][1] + seen[4][2] + seen[5][2] + seen[6][2] + seen[7][2])
+			== 0U);
+}
+
+/* Each frame waits for its start time, and a frame started more than a frame late sets the following timing */
+static void TestPace(void) {
+	Analog_Input_t* list[] = { Input(IN_SUPPLY_9V, ADS1256_SPS_30000), Input(EXTERNAL_0, ADS1256_SPS_30000) };
+	uint8_t index;
+	list[0]->period = 2000U;
+	list[1]->period = 4000U;
+	TEST_CHECK(AnalogScan_Compile(list, 2U) == ERR_FUNCTION_OK);
+	TEST_CHECK(AnalogScan_GetFramePeriod() == 2000U);
+	index = AnalogScan_Rewind(5000U);
+	TEST_CHECK(AnalogScan_Pace(4000U) == 1000U);
+	TEST_CHECK(AnalogScan_Pace(5000U) == 0U);
+	/* Entries inside a started frame never wait */
+	TEST_CHECK(AnalogScan_Pace(5100U) == 0U);
+	do {
+		index = AnalogScan_Advance(index);
+	} while (AnalogScan_GetFrame() == 0U);
+	TEST_CHECK(AnalogScan_Pace(6500U) == 500U);
+	TEST_CHECK(AnalogScan_Pace(7000U) == 0U);
+	do {
+		index = AnalogScan_Advance(index);
+	} while (AnalogScan_GetFrame() == 1U);
+	TEST_CHECK(AnalogScan_Pace(20000U) == 0U);
+	do {
+		index = AnalogScan_Advance(index);
+	} while (AnalogScan_GetFrame() == 2U);
+	TEST_CHECK(AnalogScan_Pace(20000U) == 2000U);
+}
+
+/* A schedule which can not fit its inputs in the frames is refused */
+static void TestInfeasible(void) {
+	Analog_Input_t* list[] = { Input(EXTERNAL_0, ADS1256_SPS_30000), Input(EXTERNAL_1, ADS1256_SPS_30000),
+			Input(EXTERNAL_2, ADS1256_SPS_30000) };
+	for (uint8_t i = 0U; i < 3U; ++i) {
+		list[i]->period = 1000U;
+	}
+	TEST_CHECK(AnalogScan_Compile(list, 3U) == ERR_AIN_SCAN_INFEASIBLE);
+	TEST_CHECK(AnalogScan_GetCount() == 0U);
+	for (uint8_t i = 0U; i < 3U; ++i) {
+		list[i]->period = 0U;
+	}
+	TEST_CHECK(AnalogScan_Compile(list, 3U) == ERR_FUNCTION_OK);
+	TEST_CHECK(AnalogScan_GetFramePeriod() == 0U);
+	TEST_CHECK(AnalogScan_Pace(0U) == 0U);
+}
+
+int main(void) {
+	Input(IN_COLD_JUNCTION, ADS1256_SPS_30);
+	TestInterleave();
+	TestLongestFirst();
+	TestUnplanned();
+	TestSelect();
+	TestMultiRate();
+	TestPace();
+	TestInfeasible();
+	return TEST_RESULT();
+}
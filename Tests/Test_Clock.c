@@ -0,0 +1,120 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Test_Clock.c
+ * @brief Host test of the clock time base arithmetic.
+ *
+ * A simulated 32 bit cycle counter is run through several wraps and the times the time base reports are compared with
+ * the exact elapsed cycles over CLOCK_CYCLES_PER_US. The discipline loop is run against a reference with a known rate
+ * error and noise.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Test.h"
+#include "Tekdaqc_Clock.h"
+#include <stdlib.h>
+
+/* The time the simulated clocks start from, in microseconds */
+#define START_TIME		1000000000000ULL
+
+/* The cycle counter readings either side of a wrap are extended to consecutive counts */
+static void TestWrapEdges(void) {
+	Clock_Timebase_t base;
+	Clock_TimebaseInit(&base, 0xFFFFFFF0U, START_TIME);
+	TEST_CHECK(Clock_TimebaseExtend(&base, 0xFFFFFFFFU) == 0xFFFFFFFFULL);
+	TEST_CHECK(Clock_TimebaseExtend(&base, 0U) == 0x100000000ULL);
+	TEST_CHECK(Clock_TimebaseExtend(&base, 0xFFFFFFEFU) == 0x1FFFFFFEFULL);
+	/* A reading equal to the last one is not a wrap */
+	TEST_CHECK(Clock_TimebaseExtend(&base, 0xFFFFFFF0U) == 0xFFFFFFF0ULL);
+	TEST_CHECK(Clock_TimebaseAdvance(&base, 0xFFFFFFFFU) == 0xFFFFFFFFULL);
+	TEST_CHECK(base.cycleHigh == 0U);
+	TEST_CHECK(Clock_TimebaseAdvance(&base, 0U) == 0x100000000ULL);
+	TEST_CHECK(base.cycleHigh == 1U);
+	TEST_CHECK(Clock_TimebaseAdvance(&base, 0U) == 0x100000000ULL);
+	TEST_CHECK(base.cycleHigh == 1U);
+	/* Times are truncated, and the nominal scale rounds down, so a whole microsecond shows one cycle later */
+	TEST_CHECK(Clock_TimebaseToTime(&base, 0x100000000ULL) == START_TIME);
+	TEST_CHECK(Clock_TimebaseToTime(&base, 0xFFFFFFF0ULL + CLOCK_CYCLES_PER_US + 1U) == (START_TIME + 1U));
+}
+
+/* Over several wraps every reading, at an update or between two, is exact to a microsecond and never goes back */
+static void TestExtension(void) {
+	Clock_Timebase_t base;
+	uint64_t truth = 0xFFFFF000U;
+	uint64_t origin = truth;
+	uint64_t last = START_TIME;
+	Clock_TimebaseInit(&base, (uint32_t) truth, START_TIME);
+	for (uint32_t i = 0U; i < 900000U; ++i) {
+		uint64_t extended;
+		uint64_t time;
+		int64_t error;
+		truth += 16800U + (i % 7U);
+		extended = Clock_TimebaseAdvance(&base, (uint32_t) truth);
+		TEST_CHECK(extended == truth);
+		TEST_CHECK((extended - base.anchorCycles) < CLOCK_ANCHOR_STEP);
+		/* A read between two updates, across the next wrap if there is one */
+		time = Clock_TimebaseToTime(&base, Clock_TimebaseExtend(&base, (uint32_t) (truth + 12345U)));
+		error = (int64_t) time - (int64_t) (START_TIME + ((truth + 12345U - origin) / CLOCK_CYCLES_PER_US));
+		TEST_CHECK((error >= -1) && (error <= 1));
+		TEST_CHECK(time >= last);
+		last = time;
+		if (test_failures > 0U) {
+			return;
+		}
+	}
+	TEST_CHECK(base.cycleHigh >= 3U);
+}
+
+/* A counter 30 ppm slow against a noisy reference is slewed into step with it, learning the rate error */
+static void TestDiscipline(void) {
+	Clock_Timebase_t base;
+	const double reference = (1.0 + 30e-6) / CLOCK_CYCLES_PER_US;
+	uint64_t cycles = 0U;
+	uint64_t last = START_TIME;
+	int64_t error = 0;
+	Clock_TimebaseInit(&base, 0U, START_TIME);
+	srand(1U);
+	for (uint32_t interval = 0U; interval < 200U; ++interval) {
+		uint64_t time;
+		for (uint32_t i = 0U; i < 100000U; ++i) {
+			cycles += 16800U;
+			Clock_TimebaseAdvance(&base, (uint32_t) cycles);
+			time = Clock_TimebaseToTime(&base, cycles);
+			TEST_CHECK(time >= last);
+			last = time;
+		}
+		time = START_TIME + (uint64_t) ((double) cycles * reference) + (uint64_t) (rand() % 41) - 20U;
+		error = (int64_t) time - (int64_t) Clock_TimebaseToTime(&base, cycles);
+		Clock_TimebaseDiscipline(&base, cycles, time);
+		if (test_failures > 0U) {
+			return;
+		}
+	}
+	TEST_CHECK((error > -100) && (error < 100));
+	TEST_CHECK((base.frequency > 25000) && (base.frequency < 35000));
+	printf("Discipline: residual %lld us, learned %d ppb\n", (long long) error, (int) base.frequency);
+	/* An error past CLOCK_STEP_THRESHOLD steps the time and keeps the learned rate */
+	Clock_TimebaseDiscipline(&base, cycles, 1700000000000000ULL);
+	TEST_CHECK(Clock_TimebaseToTime(&base, cycles) == 1700000000000000ULL);
+	TEST_CHECK((base.frequency > 25000) && (base.frequency < 35000));
+}
+
+int main(void) {
+	TestWrapEdges();
+	TestExtension();
+	TestDiscipline();
+	return TEST_RESULT();
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Test_SampleCorrection.c
+ * @brief Host test of the fixed point sample correction pipeline.
+ *
+ * Every 24 bit code is corrected with a range of gain factors and compared against an exact integer reference, and
+ * against the single precision float path the pipeline replaced, which may differ from it by at most one count.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Test.h"
+#include "Tekdaqc_SampleCorrection.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @internal
+ * @brief The number of codes a 24 bit reading can take.
+ */
+#define NUM_CODES	0x01000000U
+
+/**
+ * @internal
+ * Computes code * (1 + gain / 2^31), rounded half away from zero, with a division rather than the shift the pipeline
+ * uses.
+ */
+static int32_t Reference(int32_t code, int32_t gain) {
+	int64_t product = (int64_t) code * (INT64_C(0x80000000) + gain);
+	int64_t quotient = product / INT64_C(0x80000000);
+	int64_t remainder = product % INT64_C(0x80000000);
+	if (llabs(remainder) >= INT64_C(0x40000000)) {
+		quotient += (product < 0) ? -1 : 1;
+	}
+	return (int32_t) quotient;
+}
+
+static void TestSignExtend(void) {
+	TEST_CHECK(SampleCorrection_SignExtend(0x000000U) == 0);
+	TEST_CHECK(SampleCorrection_SignExtend(0x7FFFFFU) == 8388607);
+	TEST_CHECK(SampleCorrection_SignExtend(0x800000U) == -8388608);
+	TEST_CHECK(SampleCorrection_SignExtend(0xFFFFFFU) == -1);
+	TEST_CHECK(SampleCorrection_SignExtend(0xFF000001U) == 1);
+}
+
+static void TestConversions(void) {
+	TEST_CHECK(SampleCorrection_GainFromFactor(1.0f) == SAMPLE_CORRECTION_UNITY_GAIN);
+	TEST_CHECK(SampleCorrection_GainFromFactor(0.5f) == -0x40000000);
+	TEST_CHECK(SampleCorrection_GainFromFactor(1.5f) == 0x40000000);
+	TEST_CHECK(SampleCorrection_GainFromFactor(0.0f) == INT32_MIN);
+	TEST_CHECK(SampleCorrection_GainFromFactor(2.0f) == INT32_MAX);
+	TEST_CHECK(SampleCorrection_ScaleFromFloat(1.0f) == SAMPLE_CORRECTION_UNITY_SCALE);
+	TEST_CHECK(SampleCorrection_ScaleFromFloat(-0.5f) == -0x8000);
+	TEST_CHECK(SampleCorrection_ScaleFromFloat(1.0e6f) == INT32_MAX);
+	TEST_CHECK(SampleCorrection_ScaleFromFloat(-1.0e6f) == INT32_MIN);
+}
+
+static void TestFullRange(void) {
+	static const float factors[] = { 1.0f, 0.99731f, 1.00417f, 0.5f, 1.9999f, 1.000001f };
+	static uint32_t raw[4096];
+	static int32_t block[4096];
+	for (uint32_t f = 0U; f < (sizeof(factors) / sizeof(factors[0])); ++f) {
+		SampleCorrection_t correction;
+		SampleCorrection_Init(&correction);
+		correction.gain = SampleCorrection_GainFromFactor(factors[f]);
+		uint32_t mismatches = 0U;
+		uint32_t floatDiffers = 0U;
+		int32_t floatError = 0;
+		for (uint32_t code = 0U; code < NUM_CODES; ++code) {
+			int32_t value = SampleCorrection_SignExtend(code);
+			int32_t corrected = SampleCorrection_Apply(&correction, value);
+			mismatches += (corrected != Reference(value, correction.gain)) ? 1U : 0U;
+			int32_t error = abs((int32_t) roundf(factors[f] * (float) value) - corrected);
+			floatDiffers += (error != 0) ? 1U : 0U;
+			floatError = (error > floatError) ? error : floatError;
+			/* The block path must agree with the single reading path */
+			raw[code % 4096U] = code;
+			if ((code % 4096U) == 4095U) {
+				SampleCorrection_ApplyRawBlock(&correction, raw, block, 4096U);
+				for (uint32_t i = 0U; i < 4096U; ++i) {
+					mismatches += (block[i] != Reference(SampleCorrection_SignExtend(raw[i]), correction.gain)) ? 1U : 0U;
+				}
+			}
+		}
+		printf("factor %.6f: %u mismatches, float path differs on %u codes by up to %" PRIi32 "\n", factors[f],
+				mismatches, floatDiffers, floatError);
+		TEST_CHECK(mismatches == 0U);
+		TEST_CHECK(floatError <= 1);
+	}
+}
+
+static void TestOffsetAndScale(void) {
+	SampleCorrection_t correction;
+	SampleCorrection_Init(&correction);
+	correction.offset = -100;
+	TEST_CHECK(SampleCorrection_Apply(&correction, 8388607) == 8388507);
+	/* Each step saturates rather than wrapping */
+	correction.offset = INT32_MAX;
+	TEST_CHECK(SampleCorrection_Apply(&correction, 100) == INT32_MAX);
+	correction.scale = SampleCorrection_ScaleFromFloat(3.0f);
+	TEST_CHECK(SampleCorrection_Apply(&correction, 100) == INT32_MAX);
+	correction.offset = INT32_MIN;
+	TEST_CHECK(SampleCorrection_Apply(&correction, -100) == INT32_MIN);
+	/* Ties round away from zero, like roundf() */
+	correction.offset = 0;
+	correction.scale = SampleCorrection_ScaleFromFloat(0.5f);
+	TEST_CHECK(SampleCorrection_Apply(&correction, 3) == 2);
+	TEST_CHECK(SampleCorrection_Apply(&correction, -3) == -2);
+	TEST_CHECK(SampleCorrection_Apply(&correction, 2) == 1);
+}
+
+int main(void) {
+	TestSignExtend();
+	TestConversions();
+	TestOffsetAndScale();
+	TestFullRange();
+	return TEST_RESULT();
+}
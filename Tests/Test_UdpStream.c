@@ -0,0 +1,208 @@
+/*
+ * Copyright 2013 Tenkiv, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * @file Test_UdpStream.c
+ * @brief Loopback test of the UDP sample stream.
+ *
+ * The lwIP calls the stream makes are stood in for by a socket sending to 127.0.0.1, and a receiver on the other end
+ * parses every datagram as a client would: the sequence numbers must count up with a gap only where a datagram was
+ * lost, every frame must pass its CRC and no frame may be lost, reordered or split across datagrams.
+ *
+ * @author Jared Woolston (jwoolston@tenkiv.com)
+ * @since v1.1.0.0
+ */
+
+#include "Test.h"
+#include "Host_Socket.h"
+#include "Tekdaqc_UdpStream.h"
+#include "Tekdaqc_DataFrame.h"
+#include "Tekdaqc_BSP.h"
+#include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+/* The number of frames streamed */
+#define STREAM_FRAMES		20000U
+
+/* The frame after which lwIP fails to send a datagram */
+#define STREAM_LOST_FRAME	5000U
+
+/* The mocked clock, in microseconds */
+static uint64_t now = 1000000U;
+
+/* If the next datagram lwIP is handed should fail to send */
+static bool failNext = FALSE;
+
+/* The UDP port handed out by udp_new() */
+static struct udp_pcb pcb;
+
+/* What the receiver has seen */
+static struct {
+	uint32_t sequence; /* The sequence number expected next */
+	uint32_t gaps; /* The number of datagrams missing from the sequence */
+	uint32_t datagrams; /* The number of datagrams received */
+	uint32_t frames; /* The number of frames received */
+	uint32_t largest; /* The largest datagram received, in bytes */
+	int64_t value; /* The last analog value received */
+} received = { 0U, 0U, 0U, 0U, 0U, -1 };
+
+uint64_t GetLocalTime(void) {
+	return now;
+}
+
+struct udp_pcb* udp_new(void) {
+	return &pcb;
+}
+
+struct pbuf* pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type) {
+	struct pbuf* p = calloc(1U, sizeof(*p));
+	(void) layer;
+	if (p != NULL) {
+		p->len = length;
+		p->tot_len = length;
+		p->type = type;
+	}
+	return p;
+}
+
+u8_t pbuf_free(struct pbuf* p) {
+	free(p);
+	return 1U;
+}
+
+err_t udp_sendto(struct udp_pcb* udp, struct pbuf* p, ip_addr_t* address, u16_t port) {
+	(void) udp;
+	if (failNext == TRUE) {
+		failNext = FALSE;
+		return ERR_MEM;
+	}
+	return (HostSocket_Send(p->payload, p->len, address->addr, port) == 0) ? ERR_OK : ERR_BUF;
+}
+
+/* Reads a little endian field */
+static uint32_t Field(const uint8_t* data, uint8_t size) {
+	uint32_t value = 0U;
+	while (size-- > 0U) {
+		value = (value << 8U) | data[size];
+	}
+	return value;
+}
+
+/* Parses every datagram waiting at the receiver */
+static void Drain(void) {
+	uint8_t datagram[2048];
+	int32_t length;
+	while ((length = HostSocket_Receive(datagram, sizeof(datagram))) > 0) {
+		uint32_t sequence = Field(&datagram[0], 4U);
+		uint32_t count = Field(&datagram[4], 2U);
+		uint32_t offset = UDP_STREAM_HEADER_SIZE;
+		TEST_CHECK((uint32_t) length <= UDP_STREAM_DATAGRAM_SIZE);
+		TEST_CHECK(sequence >= received.sequence);
+		received.gaps += sequence - received.sequence;
+		received.sequence = sequence + 1U;
+		received.largest = ((uint32_t) length > received.largest) ? (uint32_t) length : received.largest;
+		++received.datagrams;
+		for (uint32_t i = 0U; (i < count) && (offset < (uint32_t) length); ++i) {
+			uint32_t size = DATA_FRAME_HEADER_SIZE + Field(&datagram[offset + 2U], 2U) + DATA_FRAME_CRC_SIZE;
+			TEST_CHECK(datagram[offset] == DATA_FRAME_SYNC);
+			TEST_CHECK((offset + size) <= (uint32_t) length);
+			TEST_CHECK(DataFrame_CRC16(&datagram[offset], size - DATA_FRAME_CRC_SIZE, DATA_FRAME_CRC_INIT)
+					== Field(&datagram[offset + size - DATA_FRAME_CRC_SIZE], 2U));
+			if (datagram[offset + 1U] == DATA_FRAME_ANALOG_32) {
+				int32_t value = (int32_t) Field(&datagram[offset + DATA_FRAME_HEADER_SIZE + 1U + DATA_FRAME_TIMESTAMP_SIZE],
+						4U);
+				TEST_CHECK(value > received.value);
+				received.value = value;
+			}
+			offset += size;
+			++received.frames;
+		}
+		TEST_CHECK(offset == (uint32_t) length);
+		if (test_failures > 0U) {
+			return;
+		}
+	}
+}
+
+/* The frame CRC is CRC-16/CCITT-FALSE */
+static void TestCrc(void) {
+	TEST_CHECK(DataFrame_CRC16((const uint8_t*) "123456789", 9U, DATA_FRAME_CRC_INIT) == 0x29B1U);
+	TEST_CHECK(DataFrame_CRC16((const uint8_t*) "56789", 5U, DataFrame_CRC16((const uint8_t*) "1234", 4U,
+			DATA_FRAME_CRC_INIT)) == 0x29B1U);
+}
+
+/* A long stream arrives whole apart from one datagram lwIP fails to send, which shows as a single sequence gap */
+static void TestStream(void) {
+	UdpStream_Config_t config;
+	UdpStream_Statistics_t statistics;
+	uint8_t frame[DATA_FRAME_MAX_SAMPLE_SIZE];
+	uint32_t sequence;
+	uint32_t loopback;
+	uint16_t port = HostSocket_Open(&loopback);
+	TEST_CHECK(port != 0U);
+	UdpStream_Init();
+	UdpStream_GetConfig(&config);
+	TEST_CHECK((config.enabled == FALSE) && (config.port == DATA_PORT));
+	/* Enabling without an address is refused */
+	config.enabled = TRUE;
+	ip_addr_set_any(&config.address);
+	TEST_CHECK(UdpStream_Configure(&config) == FALSE);
+	config.address.addr = loopback;
+	config.port = port;
+	TEST_CHECK(UdpStream_Configure(&config) == TRUE);
+	TEST_CHECK(UdpStream_IsEnabled() == TRUE);
+	for (uint32_t i = 0U; i < STREAM_FRAMES; ++i) {
+		UdpStream_Write(frame, DataFrame_EncodeAnalog(frame, (uint8_t) (i % 32U), now, (int32_t) (0x01000000U + i)));
+		failNext = (i == STREAM_LOST_FRAME) ? TRUE : failNext;
+		now += 3U;
+		UdpStream_Service();
+		Drain();
+	}
+	/* A part filled datagram is only sent once its first frame has waited the flush interval */
+	UdpStream_Flush();
+	UdpStream_GetStatistics(&statistics);
+	sequence = statistics.sequence;
+	UdpStream_Write(frame, DataFrame_EncodeDigital(frame, 1U, now, 1U));
+	now += UDP_STREAM_FLUSH_INTERVAL - 1U;
+	UdpStream_Service();
+	UdpStream_GetStatistics(&statistics);
+	TEST_CHECK(statistics.sequence == sequence);
+	now += 1U;
+	UdpStream_Service();
+	UdpStream_GetStatistics(&statistics);
+	TEST_CHECK(statistics.sequence == (sequence + 1U));
+	usleep(20000U);
+	Drain();
+	printf("Sent %u datagrams, received %u with %u gaps, %u frames counted and %u received, largest %u bytes\n",
+			(unsigned int) statistics.sequence, (unsigned int) received.datagrams, (unsigned int) received.gaps,
+			(unsigned int) statistics.frames, (unsigned int) received.frames, (unsigned int) received.largest);
+	TEST_CHECK((statistics.drops == 1U) && (received.gaps == 1U));
+	TEST_CHECK((received.datagrams + received.gaps) == statistics.sequence);
+	TEST_CHECK(received.frames == statistics.frames);
+	TEST_CHECK(received.largest > (UDP_STREAM_DATAGRAM_SIZE - DATA_FRAME_MAX_SAMPLE_SIZE));
+	/* Enabling the stream again restarts the sequence */
+	config.enabled = FALSE;
+	TEST_CHECK(UdpStream_Configure(&config) == TRUE);
+	config.enabled = TRUE;
+	TEST_CHECK(UdpStream_Configure(&config) == TRUE);
+	UdpStream_GetStatistics(&statistics);
+	TEST_CHECK((statistics.sequence == 0U) && (statistics.frames == 0U) && (statistics.drops == 0U));
+}
+
+int main(void) {
+	TestCrc();
+	TestStream();
+	return TEST_RESULT();
+}